@@ -0,0 +1,285 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_utils.h"
+#include "analysis_pipeline/core/data/json_encoder_registry.h"
+
+// --------------------- add / update / remove ---------------------
+
+static void BM_AddOrUpdate_New(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto names = bench::productNames(count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        PipelineDataProductManager manager;
+        std::vector<std::unique_ptr<PipelineDataProduct>> products;
+        products.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) products.push_back(bench::makeParameterProduct(names[i], 1.0));
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < count; ++i) {
+            manager.addOrUpdate(names[i], std::move(products[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_AddOrUpdate_New)->Arg(10)->Arg(1000);
+
+static void BM_AddOrUpdate_Existing(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    const std::string name = bench::productName(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto product = bench::makeParameterProduct(name, 2.0);
+        state.ResumeTiming();
+        manager.addOrUpdate(name, std::move(product));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddOrUpdate_Existing)->Arg(10)->Arg(1000);
+
+static void BM_AddOrUpdateMultiple(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto names = bench::productNames(count);
+    PipelineDataProductManager manager;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::pair<std::string, std::unique_ptr<PipelineDataProduct>>> products;
+        products.reserve(count);
+        for (const auto& name : names) products.emplace_back(name, bench::makeParameterProduct(name, 1.0));
+        state.ResumeTiming();
+        manager.addOrUpdateMultiple(std::move(products));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_AddOrUpdateMultiple)->Arg(10)->Arg(1000);
+
+static void BM_Remove(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto names = bench::productNames(count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        PipelineDataProductManager manager;
+        bench::populateParameters(manager, count);
+        state.ResumeTiming();
+        for (const auto& name : names) manager.remove(name);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_Remove)->Arg(10)->Arg(1000);
+
+static void BM_HasProduct(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    const std::string name = bench::productName(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.hasProduct(name));
+    }
+}
+BENCHMARK(BM_HasProduct)->Arg(10)->Arg(10000);
+
+// --------------------- checkout ---------------------
+
+static void BM_CheckoutRead(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    const std::string name = bench::productName(0);
+    for (auto _ : state) {
+        auto handle = manager.checkoutRead(name);
+        benchmark::DoNotOptimize(handle.get());
+    }
+}
+BENCHMARK(BM_CheckoutRead)->Arg(10)->Arg(10000);
+
+static void BM_CheckoutWrite(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    const std::string name = bench::productName(0);
+    for (auto _ : state) {
+        auto handle = manager.checkoutWrite(name);
+        benchmark::DoNotOptimize(handle.get());
+    }
+}
+BENCHMARK(BM_CheckoutWrite)->Arg(10)->Arg(10000);
+
+static void BM_CheckoutReadMultiple(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, 1000);
+    auto names = bench::productNames(count);
+    for (auto _ : state) {
+        auto handles = manager.checkoutReadMultiple(names);
+        benchmark::DoNotOptimize(handles.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_CheckoutReadMultiple)->Arg(2)->Arg(8)->Arg(64);
+
+// One read and one write, the typical "read A, write B" stage
+static void BM_CheckoutMixed_ReadWrite(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, 1000);
+    const std::string input = bench::productName(1);
+    const std::string output = bench::productName(2);
+    for (auto _ : state) {
+        auto locks = manager.checkoutMixed(CheckoutRequest::read(input), CheckoutRequest::write(output));
+        benchmark::DoNotOptimize(&locks.product(0));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_CheckoutMixed_ReadWrite);
+
+static void BM_CheckoutMixed_Handles(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, 1000);
+    auto input = manager.getHandle(bench::productName(1));
+    auto output = manager.getHandle(bench::productName(2));
+    for (auto _ : state) {
+        auto locks = manager.checkoutMixed(CheckoutRequest::read(input), CheckoutRequest::write(output));
+        benchmark::DoNotOptimize(&locks.product(0));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_CheckoutMixed_Handles);
+
+static void BM_CheckoutWriteMultiple(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, 1000);
+    auto names = bench::productNames(count);
+    for (auto _ : state) {
+        auto handles = manager.checkoutWriteMultiple(names);
+        benchmark::DoNotOptimize(handles.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_CheckoutWriteMultiple)->Arg(2)->Arg(8)->Arg(64);
+
+// --------------------- tag queries ---------------------
+
+static void BM_GetAllTags(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto tags = manager.getAllTags();
+        benchmark::DoNotOptimize(tags.size());
+    }
+}
+BENCHMARK(BM_GetAllTags)->Arg(100)->Arg(10000);
+
+static void BM_GetNamesWithTag(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto names = manager.getNamesWithTag("group_1");
+        benchmark::DoNotOptimize(names.data());
+    }
+}
+BENCHMARK(BM_GetNamesWithTag)->Arg(100)->Arg(10000);
+
+static void BM_GetNamesWithAnyTags(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    const std::unordered_set<std::string> tags{"group_1", "group_2"};
+    for (auto _ : state) {
+        auto names = manager.getNamesWithAnyTags(tags);
+        benchmark::DoNotOptimize(names.data());
+    }
+}
+BENCHMARK(BM_GetNamesWithAnyTags)->Arg(100)->Arg(10000);
+
+static void BM_GetNamesWithAllTags(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    const std::unordered_set<std::string> tags{"group_0", "even"};
+    for (auto _ : state) {
+        auto names = manager.getNamesWithAllTags(tags);
+        benchmark::DoNotOptimize(names.data());
+    }
+}
+BENCHMARK(BM_GetNamesWithAllTags)->Arg(100)->Arg(10000);
+
+static void BM_GetNamesWithExactTags(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    const std::unordered_set<std::string> tags{"all", "group_1"};
+    for (auto _ : state) {
+        auto names = manager.getNamesWithExactTags(tags);
+        benchmark::DoNotOptimize(names.data());
+    }
+}
+BENCHMARK(BM_GetNamesWithExactTags)->Arg(100)->Arg(10000);
+
+static void BM_GetNamesWithNoTags(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto names = manager.getNamesWithNoTags();
+        benchmark::DoNotOptimize(names.data());
+    }
+}
+BENCHMARK(BM_GetNamesWithNoTags)->Arg(100)->Arg(10000);
+
+static void BM_RemoveByTag(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        PipelineDataProductManager manager;
+        bench::populateParameters(manager, count);
+        state.ResumeTiming();
+        manager.removeByTag("even");
+    }
+}
+BENCHMARK(BM_RemoveByTag)->Arg(100)->Arg(10000);
+
+static void BM_RemoveExcludingTags(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const std::unordered_set<std::string> tags{"group_0", "group_1"};
+    for (auto _ : state) {
+        state.PauseTiming();
+        PipelineDataProductManager manager;
+        bench::populateParameters(manager, count);
+        state.ResumeTiming();
+        manager.removeExcludingTags(tags);
+    }
+}
+BENCHMARK(BM_RemoveExcludingTags)->Arg(100)->Arg(10000);
+
+// --------------------- serialization ---------------------
+
+static void BM_SerializeAll_Parameters(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateParameters(manager, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto json = manager.serializeAll();
+        benchmark::DoNotOptimize(json.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SerializeAll_Parameters)->Arg(10)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SerializeAll_Histograms(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateHistograms(manager, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto json = manager.serializeAll();
+        benchmark::DoNotOptimize(json.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SerializeAll_Histograms)->Arg(10)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Same histograms through TBufferJSON, for comparison with the compact encoders
+static void BM_SerializeAll_Histograms_Generic(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    bench::populateHistograms(manager, static_cast<std::size_t>(state.range(0)));
+    auto& encoders = JsonEncoderRegistry::instance();
+    encoders.setFastPathEnabled(false);
+    for (auto _ : state) {
+        auto json = manager.serializeAll();
+        benchmark::DoNotOptimize(json.size());
+    }
+    encoders.setFastPathEnabled(true);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SerializeAll_Histograms_Generic)->Arg(10)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "analysis_pipeline/core/context/input_bundle.h"
+
+static void BM_InputBundle_SetInt(benchmark::State& state) {
+    InputBundle bundle;
+    int value = 0;
+    for (auto _ : state) {
+        bundle.set("value", value++);
+    }
+}
+BENCHMARK(BM_InputBundle_SetInt);
+
+static void BM_InputBundle_GetInt(benchmark::State& state) {
+    InputBundle bundle;
+    bundle.set("value", 42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bundle.get<int>("value"));
+    }
+}
+BENCHMARK(BM_InputBundle_GetInt);
+
+static void BM_InputBundle_SetSharedPtr(benchmark::State& state) {
+    InputBundle bundle;
+    auto payload = std::make_shared<std::vector<char>>(4096);
+    for (auto _ : state) {
+        bundle.set("payload", payload);
+    }
+}
+BENCHMARK(BM_InputBundle_SetSharedPtr);
+
+static void BM_InputBundle_GetSharedPtr(benchmark::State& state) {
+    InputBundle bundle;
+    bundle.set("payload", std::make_shared<std::vector<char>>(4096));
+    for (auto _ : state) {
+        auto payload = bundle.get<std::shared_ptr<std::vector<char>>>("payload");
+        benchmark::DoNotOptimize(payload.get());
+    }
+}
+BENCHMARK(BM_InputBundle_GetSharedPtr);
+
+static void BM_InputBundle_Has(benchmark::State& state) {
+    InputBundle bundle;
+    bundle.set("value", 42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bundle.has<int>("value"));
+    }
+}
+BENCHMARK(BM_InputBundle_Has);
+
+// Builds a fresh bundle with `range(0)` entries, as an input stage would per event
+static void BM_InputBundle_FillPerEvent(benchmark::State& state) {
+    const auto entries = static_cast<int>(state.range(0));
+    std::vector<std::string> keys;
+    for (int i = 0; i < entries; ++i) keys.push_back("key_" + std::to_string(i));
+
+    for (auto _ : state) {
+        InputBundle bundle;
+        for (int i = 0; i < entries; ++i) bundle.set(keys[i], i);
+        benchmark::DoNotOptimize(bundle.size());
+    }
+}
+BENCHMARK(BM_InputBundle_FillPerEvent)->Arg(1)->Arg(8)->Arg(32);
@@ -0,0 +1,16 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+// Custom main so every JSON report records which library version produced it.
+// Export with: --benchmark_out=<file>.json --benchmark_out_format=json
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::warn);
+
+    benchmark::AddCustomContext("analysis_pipeline_core_version", ANALYSIS_PIPELINE_CORE_VERSION);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
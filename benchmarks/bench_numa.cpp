@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <TH1.h>
+#include <TH1D.h>
+#include <TROOT.h>
+
+#include "analysis_pipeline/core/execution/worker_pool.h"
+
+// Cross-socket cost: data first touched on the first CPU of node 0 is read
+// (or filled) by a worker on node 0 (arg 0 = local) or on the last node
+// (arg 1 = remote). Skipped on single-node machines.
+namespace {
+
+constexpr std::size_t kStreamDoubles = std::size_t{64} << 20 >> 3;  // 64 MiB
+constexpr int kHistogramBins = 4 << 20;                               // 32 MiB of bin contents
+constexpr int kFillsPerIteration = 1 << 20;
+
+struct NumaPair {
+    NumaTopology topology = NumaTopology::detect();
+    std::unique_ptr<WorkerPool> pool;  // worker 0 on node 0, worker 1 on the last node
+
+    NumaPair() {
+        if (topology.nodeCount() < 2) return;
+        WorkerPoolConfig config;
+        config.placement = PlacementPolicy::Explicit;
+        config.cpus = {topology.nodes().front().cpus.front(), topology.nodes().back().cpus.front()};
+        pool = std::make_unique<WorkerPool>(config, topology);
+    }
+};
+
+NumaPair& numaPair() {
+    static NumaPair pair;
+    return pair;
+}
+
+}  // namespace
+
+static void BM_Numa_StreamRead(benchmark::State& state) {
+    auto& numa = numaPair();
+    if (!numa.pool) {
+        state.SkipWithError("needs at least two NUMA nodes");
+        return;
+    }
+
+    auto data = numa.pool->construct<std::vector<double>>(0, kStreamDoubles, 1.0);
+    const std::size_t reader = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        double sum = 0.0;
+        numa.pool->submit(reader, [&] { sum = std::accumulate(data->begin(), data->end(), 0.0); }).get();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kStreamDoubles * sizeof(double)));
+    state.SetLabel(reader == 0 ? "local" : "remote");
+}
+BENCHMARK(BM_Numa_StreamRead)->Arg(0)->Arg(1)->UseRealTime();
+
+static void BM_Numa_HistogramFill(benchmark::State& state) {
+    auto& numa = numaPair();
+    if (!numa.pool) {
+        state.SkipWithError("needs at least two NUMA nodes");
+        return;
+    }
+
+    ROOT::EnableThreadSafety();
+    TH1::AddDirectory(false);
+    auto hist = numa.pool->construct<TH1D>(0, "numa_hist", "numa_hist", kHistogramBins, 0.0, 1.0);
+    const std::size_t filler = static_cast<std::size_t>(state.range(0));
+
+    // Random bins defeat the prefetcher, so each fill pays the memory latency
+    std::vector<double> values(kFillsPerIteration);
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (auto& v : values) v = uniform(rng);
+
+    for (auto _ : state) {
+        numa.pool->submit(filler, [&] {
+            for (double v : values) hist->Fill(v);
+        }).get();
+    }
+    state.SetItemsProcessed(state.iterations() * kFillsPerIteration);
+    state.SetLabel(filler == 0 ? "local" : "remote");
+}
+BENCHMARK(BM_Numa_HistogramFill)->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_utils.h"
+#include "analysis_pipeline/core/stages/histograms/th1_builder_stage.h"
+#include "analysis_pipeline/core/stages/testing/random_data_generator_stage.h"
+#include "analysis_pipeline/core/stages/testing/synthetic_load_generator_stage.h"
+
+static void BM_RandomDataGeneratorStage_Process(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    RandomDataGeneratorStage stage;
+    stage.Init({{"product_name", "random_value"}, {"seed", 42}}, &manager);
+
+    for (auto _ : state) {
+        stage.Process();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RandomDataGeneratorStage_Process);
+
+static void BM_SyntheticLoadGeneratorStage_Process(benchmark::State& state) {
+    PipelineDataProductManager manager;
+    SyntheticLoadGeneratorStage stage;
+    stage.Init({{"batch_size", state.range(0)},
+                {"distribution", {{"type", "gaussian"}, {"mean", 0.0}, {"sigma", 1.0}}}},
+               &manager);
+
+    for (auto _ : state) {
+        stage.Process();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SyntheticLoadGeneratorStage_Process)->Arg(1)->Arg(1000)->Arg(100000);
+
+static void BM_TH1BuilderStage_Process(benchmark::State& state) {
+    TH1::AddDirectory(false);
+    PipelineDataProductManager manager;
+    manager.addOrUpdate("random_value", bench::makeParameterProduct("random_value", 0.5));
+
+    TH1BuilderStage stage;
+    stage.Init({{"input_product", "random_value"},
+                {"product_name", "hist"},
+                {"value_key", "fVal"},
+                {"bins", 100},
+                {"min", 0.0},
+                {"max", 1.0}},
+               &manager);
+    stage.Process();  // create the histogram outside the timed loop
+
+    for (auto _ : state) {
+        stage.Process();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TH1BuilderStage_Process);
+
+// Generator feeding the builder, i.e. the per-event cost of the minimal test pipeline
+static void BM_GeneratorAndBuilder_Process(benchmark::State& state) {
+    TH1::AddDirectory(false);
+    PipelineDataProductManager manager;
+
+    RandomDataGeneratorStage generator;
+    generator.Init({{"product_name", "random_value"}, {"seed", 42}}, &manager);
+
+    TH1BuilderStage builder;
+    builder.Init({{"input_product", "random_value"}, {"product_name", "hist"}, {"value_key", "fVal"}}, &manager);
+
+    for (auto _ : state) {
+        generator.Process();
+        builder.Process();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GeneratorAndBuilder_Process);
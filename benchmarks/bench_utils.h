@@ -0,0 +1,73 @@
+#ifndef ANALYSIS_PIPELINE_BENCHMARKS_BENCH_UTILS_H
+#define ANALYSIS_PIPELINE_BENCHMARKS_BENCH_UTILS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TH1.h>
+#include <TH1D.h>
+#include <TParameter.h>
+
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+
+namespace bench {
+
+inline std::string productName(std::size_t i) {
+    return "product_" + std::to_string(i);
+}
+
+inline std::unique_ptr<PipelineDataProduct> makeParameterProduct(const std::string& name, double value) {
+    auto product = std::make_unique<PipelineDataProduct>();
+    product->setName(name);
+    product->setObject(std::make_unique<TParameter<double>>(name.c_str(), value));
+    return product;
+}
+
+inline std::unique_ptr<PipelineDataProduct> makeHistogramProduct(const std::string& name, int bins = 100) {
+    TH1::AddDirectory(false);
+    auto hist = std::make_unique<TH1D>(name.c_str(), name.c_str(), bins, 0.0, 1.0);
+    for (int i = 0; i < 1000; ++i) {
+        hist->Fill((i % bins + 0.5) / bins);
+    }
+    auto product = std::make_unique<PipelineDataProduct>();
+    product->setName(name);
+    product->setObject(std::move(hist));
+    product->addTag("histogram");
+    return product;
+}
+
+// Tags used by the tag-query benchmarks: every product has "all", one of
+// "group_0".."group_3", and even-numbered products also have "even".
+inline void addBenchmarkTags(PipelineDataProduct& product, std::size_t i) {
+    product.addTag("all");
+    product.addTag("group_" + std::to_string(i % 4));
+    if (i % 2 == 0) product.addTag("even");
+}
+
+inline void populateParameters(PipelineDataProductManager& manager, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto product = makeParameterProduct(productName(i), static_cast<double>(i));
+        addBenchmarkTags(*product, i);
+        manager.addOrUpdate(productName(i), std::move(product));
+    }
+}
+
+inline void populateHistograms(PipelineDataProductManager& manager, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto product = makeHistogramProduct(productName(i));
+        addBenchmarkTags(*product, i);
+        manager.addOrUpdate(productName(i), std::move(product));
+    }
+}
+
+inline std::vector<std::string> productNames(std::size_t count) {
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) names.push_back(productName(i));
+    return names;
+}
+
+}  // namespace bench
+
+#endif // ANALYSIS_PIPELINE_BENCHMARKS_BENCH_UTILS_H
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdio>
+#include <exception>
+
+// Minimal checks for the example programs: print each failure, return the count from main()
+namespace example {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void fail(const char* file, int line, const char* what) {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+    ++failures();
+}
+
+inline int result(const char* name) {
+    if (failures() == 0) {
+        std::printf("%s: all checks passed\n", name);
+        return 0;
+    }
+    std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures());
+    return 1;
+}
+
+}  // namespace example
+
+#define EXAMPLE_CHECK(condition)                                     \
+    do {                                                             \
+        if (!(condition)) example::fail(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+// Passes if `statement` throws `Exception`
+#define EXAMPLE_CHECK_THROWS(statement, Exception)                   \
+    do {                                                             \
+        bool thrown_ = false;                                        \
+        try {                                                        \
+            statement;                                               \
+        } catch (const Exception&) {                                 \
+            thrown_ = true;                                          \
+        } catch (const std::exception&) {                            \
+        }                                                            \
+        if (!thrown_) example::fail(__FILE__, __LINE__, #statement " throws " #Exception); \
+    } while (0)
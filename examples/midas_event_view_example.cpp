@@ -0,0 +1,200 @@
+// Writes synthetic MIDAS events to files, reads them back through
+// RawEventBuffer::fromFile and checks what MidasEventView makes of them:
+// the BANK16, BANK32 and BANK32A layouts, 8-byte padding of bank payloads,
+// and the errors raised for truncated or inconsistent events.
+//
+//   ./midas_event_view_example [scratch_dir]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "example_checks.h"
+#include "analysis_pipeline/core/data/midas_event_view.h"
+#include "analysis_pipeline/core/data/raw_event_buffer.h"
+
+namespace {
+
+constexpr std::uint32_t TID_UINT16 = 4;
+constexpr std::uint32_t TID_INT32 = 7;
+constexpr std::uint32_t TID_DOUBLE = 10;
+
+enum class Format { Bank16, Bank32, Bank32A };
+
+// Builds one event the way MIDAS lays it out on a little-endian host
+class EventWriter {
+public:
+    explicit EventWriter(Format format) : format_(format) {}
+
+    template <typename T>
+    void addBank(const char* name, std::uint32_t type, const std::vector<T>& values) {
+        const std::size_t size = values.size() * sizeof(T);
+        banks_.insert(banks_.end(), name, name + 4);
+        if (format_ == Format::Bank16) {
+            put<std::uint16_t>(banks_, static_cast<std::uint16_t>(type));
+            put<std::uint16_t>(banks_, static_cast<std::uint16_t>(size));
+        } else {
+            put<std::uint32_t>(banks_, type);
+            put<std::uint32_t>(banks_, static_cast<std::uint32_t>(size));
+            if (format_ == Format::Bank32A) put<std::uint32_t>(banks_, 0);  // reserved
+        }
+        for (const T& value : values) put<T>(banks_, value);
+        banks_.resize(banks_.size() + (((size + 7) & ~static_cast<std::size_t>(7)) - size));  // payloads are 8-byte padded
+    }
+
+    // `banksSizeDelta` and `eventSizeDelta` corrupt the declared sizes
+    std::vector<std::uint8_t> build(std::int64_t banksSizeDelta = 0, std::int64_t eventSizeDelta = 0) const {
+        std::uint32_t flags = 1;  // BANK_FORMAT_VERSION
+        if (format_ != Format::Bank16) flags |= MidasEventView::kBankFormat32Bit;
+        if (format_ == Format::Bank32A) flags |= MidasEventView::kBankFormat64BitAligned;
+
+        std::vector<std::uint8_t> body;
+        put<std::uint32_t>(body, static_cast<std::uint32_t>(static_cast<std::int64_t>(banks_.size()) + banksSizeDelta));
+        put<std::uint32_t>(body, flags);
+        body.insert(body.end(), banks_.begin(), banks_.end());
+
+        std::vector<std::uint8_t> event;
+        put<std::uint16_t>(event, 7);           // event id
+        put<std::uint16_t>(event, 0x0003);      // trigger mask
+        put<std::uint32_t>(event, 1234);        // serial number
+        put<std::uint32_t>(event, 1700000000);  // time stamp
+        put<std::uint32_t>(event, static_cast<std::uint32_t>(static_cast<std::int64_t>(body.size()) + eventSizeDelta));
+        event.insert(event.end(), body.begin(), body.end());
+        return event;
+    }
+
+private:
+    template <typename T>
+    static void put(std::vector<std::uint8_t>& out, T value) {
+        std::uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    Format format_;
+    std::vector<std::uint8_t> banks_;
+};
+
+class ScratchFiles {
+public:
+    explicit ScratchFiles(std::filesystem::path dir) : dir_(std::move(dir)) {
+        std::filesystem::create_directories(dir_);
+    }
+
+    // Writes the event to a file and reads it back, as a file-based input would
+    std::shared_ptr<const RawEventBuffer> roundTrip(const std::string& name, const std::vector<std::uint8_t>& event) {
+        const auto path = (dir_ / (name + ".mid")).string();
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(event.data()), static_cast<std::streamsize>(event.size()));
+        }
+        paths_.push_back(path);
+        return RawEventBuffer::fromFile(path);
+    }
+
+    ~ScratchFiles() {
+        std::error_code ec;
+        for (const auto& path : paths_) std::filesystem::remove(path, ec);
+    }
+
+private:
+    std::filesystem::path dir_;
+    std::vector<std::string> paths_;
+};
+
+void checkLayout(ScratchFiles& files, Format format, const char* label, std::size_t bankHeaderSize) {
+    EventWriter writer(format);
+    writer.addBank<std::uint16_t>("ADC0", TID_UINT16, {10, 20, 30});  // 6 bytes, padded to 8
+    writer.addBank<std::int32_t>("TDC0", TID_INT32, {-5, 5});
+    writer.addBank<double>("CAL0", TID_DOUBLE, {0.5});
+
+    auto buffer = files.roundTrip(label, writer.build());
+    MidasEventView view(buffer->view());
+
+    EXAMPLE_CHECK(view.eventId() == 7);
+    EXAMPLE_CHECK(view.triggerMask() == 0x0003);
+    EXAMPLE_CHECK(view.serialNumber() == 1234);
+    EXAMPLE_CHECK(view.timeStamp() == 1700000000);
+    EXAMPLE_CHECK(view.banks().size() == 3);
+    if (view.banks().size() != 3) return;
+
+    const MidasBank& adc = view.getBank("ADC0");
+    EXAMPLE_CHECK(adc.type == TID_UINT16);
+    EXAMPLE_CHECK(adc.data.size() == 6);
+    auto adcValues = adc.as<std::uint16_t>();
+    EXAMPLE_CHECK(adcValues.size() == 3);
+    EXAMPLE_CHECK(adcValues.at(0) == 10 && adcValues.at(2) == 30);
+
+    // The next bank starts after the padded payload, i.e. 8 bytes after ADC0's data
+    const MidasBank& tdc = view.getBank("TDC0");
+    EXAMPLE_CHECK(tdc.data.data() == adc.data.data() + 8 + bankHeaderSize);
+    auto tdcValues = tdc.as<std::int32_t>();
+    EXAMPLE_CHECK(tdcValues.size() == 2 && tdcValues.at(0) == -5 && tdcValues.at(1) == 5);
+
+    const MidasBank& cal = view.getBank("CAL0");
+    EXAMPLE_CHECK(cal.as<double>().at(0) == 0.5);
+    if (format != Format::Bank32) {
+        // BANK16 and BANK32A headers keep payloads 8-byte aligned within the event; BANK32's do not
+        EXAMPLE_CHECK((cal.data.data() - buffer->view().data()) % 8 == 0);
+    }
+
+    // Bounds and type checks on the bank views
+    EXAMPLE_CHECK_THROWS(adcValues.at(3), std::out_of_range);
+    EXAMPLE_CHECK_THROWS(adc.as<std::uint32_t>(), std::runtime_error);
+    EXAMPLE_CHECK_THROWS(view.getBank("NONE"), std::runtime_error);
+    EXAMPLE_CHECK(view.findBank("NONE") == nullptr);
+}
+
+void checkErrors(ScratchFiles& files) {
+    EventWriter writer(Format::Bank32);
+    writer.addBank<std::int32_t>("TDC0", TID_INT32, {1, 2, 3, 4});
+    const auto good = writer.build();
+
+    // Too short for the event and bank headers
+    std::vector<std::uint8_t> tiny(good.begin(), good.begin() + 12);
+    auto tinyBuffer = files.roundTrip("tiny", tiny);
+    EXAMPLE_CHECK_THROWS(MidasEventView(tinyBuffer->view()), std::runtime_error);
+
+    // The file ends in the middle of the bank payload: the event size no longer fits
+    std::vector<std::uint8_t> cut(good.begin(), good.end() - 8);
+    auto cutBuffer = files.roundTrip("cut", cut);
+    EXAMPLE_CHECK_THROWS(MidasEventView(cutBuffer->view()), std::runtime_error);
+
+    // The bank area claims more than the event holds
+    auto oversizedArea = files.roundTrip("oversized_area", writer.build(64));
+    EXAMPLE_CHECK_THROWS(MidasEventView(oversizedArea->view()), std::runtime_error);
+
+    // Sizes are consistent, but the last bank claims more payload than is left
+    auto truncatedBank = files.roundTrip("truncated_bank", writer.build(-8, -8));
+    EXAMPLE_CHECK_THROWS(MidasEventView(truncatedBank->view()), std::out_of_range);
+
+    // Bytes after the declared event size are ignored
+    std::vector<std::uint8_t> trailing = good;
+    trailing.resize(good.size() + 16, 0xff);
+    auto trailingBuffer = files.roundTrip("trailing", trailing);
+    MidasEventView view(trailingBuffer->view());
+    EXAMPLE_CHECK(view.banks().size() == 1);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::filesystem::path dir = argc > 1 ? argv[1] : std::filesystem::temp_directory_path() / "midas_event_view_example";
+
+    try {
+        ScratchFiles files(dir);
+        checkLayout(files, Format::Bank16, "bank16", 8);
+        checkLayout(files, Format::Bank32, "bank32", 12);
+        checkLayout(files, Format::Bank32A, "bank32a", 16);
+        checkErrors(files);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "midas_event_view_example: unexpected exception: %s\n", e.what());
+        return 1;
+    }
+    return example::result("midas_event_view_example");
+}
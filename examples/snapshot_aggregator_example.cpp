@@ -0,0 +1,154 @@
+// Runs several pipeline processes on this machine, each sending its
+// histogram through a SnapshotSenderStage, and checks what a
+// SnapshotAggregator in the parent process makes of them: every process's
+// fills are counted exactly once although each sends several snapshots,
+// the merged product carries the "aggregated" tag, and removing a source
+// re-merges the rest without it.
+//
+//   ./snapshot_aggregator_example [socket_path]
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <TH1.h>
+#include <TH1D.h>
+
+#include "example_checks.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+#include "analysis_pipeline/core/data/snapshot_aggregator.h"
+#include "analysis_pipeline/core/stages/output/snapshot_sender_stage.h"
+
+namespace {
+
+constexpr int kProcesses = 3;
+constexpr int kEventsPerProcess = 200;
+constexpr int kSendEvery = 50;  // several snapshots per process, each holding its running total
+
+// One pipeline process: fills bin `index` once per event and sends snapshots of it
+int runSource(int index, const std::string& socketPath, int startFd) {
+    // Wait until the parent's aggregator is listening
+    char go = 0;
+    if (read(startFd, &go, 1) != 1) return 2;
+    close(startFd);
+
+    TH1::AddDirectory(false);
+    PipelineDataProductManager manager;
+    auto product = std::make_unique<PipelineDataProduct>();
+    product->setName("hits");
+    product->setObject(std::make_unique<TH1D>("hits", "hits", kProcesses, 0.0, kProcesses));
+    product->addTag("histogram");
+    manager.addOrUpdate("hits", std::move(product));
+
+    SnapshotSenderStage sender;
+    sender.Init({{"socket", socketPath}, {"tags", {"histogram"}}, {"every_n_events", kSendEvery}}, &manager);
+
+    for (int event = 0; event < kEventsPerProcess; ++event) {
+        {
+            auto handle = manager.checkoutWrite("hits");
+            static_cast<TH1D*>(handle->getObject())->Fill(index + 0.5);
+        }
+        sender.Process();
+    }
+    sender.Finish();
+    return 0;
+}
+
+double mergedEntries(PipelineDataProductManager& manager) {
+    auto handle = manager.tryCheckoutRead("hits");
+    if (!handle) return 0.0;
+    auto* hist = dynamic_cast<const TH1*>(handle->getObject());
+    return hist ? hist->GetEntries() : 0.0;
+}
+
+// Snapshots arrive asynchronously; wait until the merged total settles on `expected`
+bool waitForEntries(PipelineDataProductManager& manager, double expected) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (mergedEntries(manager) == expected) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::string socketPath = argc > 1 ? argv[1]
+        : (std::filesystem::temp_directory_path() /
+           ("snapshot_aggregator_example_" + std::to_string(getpid()) + ".sock")).string();
+
+    // Fork the sources before any thread exists; they start once the aggregator listens
+    int startPipe[2];
+    if (pipe(startPipe) != 0) {
+        std::perror("pipe");
+        return 1;
+    }
+    std::vector<pid_t> children;
+    for (int i = 0; i < kProcesses; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::perror("fork");
+            return 1;
+        }
+        if (pid == 0) {
+            close(startPipe[1]);
+            _exit(runSource(i, socketPath, startPipe[0]));
+        }
+        children.push_back(pid);
+    }
+    close(startPipe[0]);
+
+    TH1::AddDirectory(false);
+    PipelineDataProductManager manager;
+    SnapshotAggregator aggregator(socketPath, manager, std::chrono::milliseconds(0));
+    aggregator.start();
+
+    const char go[kProcesses] = {};
+    if (write(startPipe[1], go, sizeof(go)) != static_cast<ssize_t>(sizeof(go))) {
+        std::perror("write");
+    }
+    close(startPipe[1]);
+
+    for (pid_t pid : children) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        EXAMPLE_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    // Each process sent kEventsPerProcess / kSendEvery + 1 snapshots of its running total
+    EXAMPLE_CHECK(waitForEntries(manager, kProcesses * kEventsPerProcess));
+    auto stats = aggregator.stats();
+    EXAMPLE_CHECK(stats.sources == kProcesses);
+    EXAMPLE_CHECK(stats.snapshotsReceived >= kProcesses);
+    EXAMPLE_CHECK(stats.snapshotsRejected == 0);
+
+    {
+        auto handle = manager.checkoutRead("hits");
+        EXAMPLE_CHECK(handle->hasTag("aggregated"));
+        EXAMPLE_CHECK(handle->hasTag("histogram"));
+        auto* hist = dynamic_cast<const TH1*>(handle->getObject());
+        EXAMPLE_CHECK(hist != nullptr);
+        for (int bin = 1; hist && bin <= kProcesses; ++bin) {
+            EXAMPLE_CHECK(hist->GetBinContent(bin) == kEventsPerProcess);
+        }
+    }
+
+    // Dropping one process re-merges the others without its fills
+    auto sources = aggregator.sources();
+    EXAMPLE_CHECK(sources.size() == kProcesses);
+    if (!sources.empty()) {
+        aggregator.removeSource(sources.front());
+        EXAMPLE_CHECK(mergedEntries(manager) == (kProcesses - 1) * kEventsPerProcess);
+    }
+
+    aggregator.stop();
+    return example::result("snapshot_aggregator_example");
+}
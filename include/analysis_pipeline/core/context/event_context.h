@@ -0,0 +1,25 @@
+#ifndef ANALYSIS_PIPELINE_CONTEXT_EVENT_CONTEXT_H
+#define ANALYSIS_PIPELINE_CONTEXT_EVENT_CONTEXT_H
+
+#include <chrono>
+
+/**
+ * @struct EventContext
+ * @brief Selection state of the event a chain of stages is working on.
+ *
+ * Passed to BaseStage::Execute(). Each chain running on its own thread (e.g.
+ * one per WorkerPool worker) needs its own context, so chains sharing a data
+ * product manager do not see each other's rejections.
+ */
+struct EventContext {
+    bool rejected = false;
+    std::chrono::steady_clock::time_point start{};  // epoch until an event-starting stage ran
+
+    // Called by Execute() for event-starting stages
+    void begin() {
+        rejected = false;
+        start = std::chrono::steady_clock::now();
+    }
+};
+
+#endif // ANALYSIS_PIPELINE_CONTEXT_EVENT_CONTEXT_H
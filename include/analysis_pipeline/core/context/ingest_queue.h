@@ -0,0 +1,258 @@
+#ifndef ANALYSIS_PIPELINE_CONTEXT_INGEST_QUEUE_H
+#define ANALYSIS_PIPELINE_CONTEXT_INGEST_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+#include "analysis_pipeline/core/context/input_bundle.h"
+
+class PipelineDataProductManager;
+
+// What push() does when the queue is full
+enum class BackpressurePolicy {
+    Block,       // wait until a consumer frees a slot
+    DropOldest,  // discard the oldest queued item to make room
+    DropNewest   // discard the item being pushed
+};
+
+struct IngestQueueConfig {
+    std::size_t capacity = 1024;
+    BackpressurePolicy policy = BackpressurePolicy::Block;
+
+    // Reads {"capacity": N, "policy": "block" | "drop_oldest" | "drop_newest"}
+    static IngestQueueConfig fromJson(const nlohmann::json& config);
+};
+
+struct IngestQueueStats {
+    std::size_t capacity = 0;
+    std::size_t occupancy = 0;
+    std::size_t highWater = 0;
+    std::uint64_t pushed = 0;
+    std::uint64_t popped = 0;
+    std::uint64_t droppedOldest = 0;
+    std::uint64_t droppedNewest = 0;
+
+    nlohmann::json toJson() const;
+
+    // Publishes each counter as a TParameter<Long64_t> named "<prefix><counter>", tagged "ingest_queue"
+    void publish(PipelineDataProductManager& manager, const std::string& prefix = "ingest_queue/") const;
+};
+
+/**
+ * @class IngestQueue
+ * @brief Bounded lock-free ring buffer between a single producer and many pipeline workers.
+ *
+ * Based on the sequence-numbered bounded queue design: each slot carries a
+ * sequence counter so producers and consumers claim slots with a single CAS.
+ * Capacity is rounded up to a power of two.
+ *
+ * Typical use puts this in front of BaseInputStage::SetInput:
+ *
+ *     IngestQueue<InputBundle> queue(IngestQueueConfig::fromJson(cfg));
+ *     // DAQ thread
+ *     queue.push(std::move(bundle));
+ *     // each worker
+ *     InputBundle bundle;
+ *     while (queue.pop(bundle)) { inputStage->SetInput(bundle); ... }
+ *
+ * push() must only be called from one thread. The DropOldest policy makes the
+ * producer consume from the head itself, which the slot protocol allows.
+ */
+template <typename T>
+class IngestQueue {
+public:
+    explicit IngestQueue(const IngestQueueConfig& config)
+        : IngestQueue(config.capacity, config.policy) {}
+
+    explicit IngestQueue(std::size_t capacity, BackpressurePolicy policy = BackpressurePolicy::Block)
+        : policy_(policy) {
+        if (capacity == 0) {
+            throw std::invalid_argument("IngestQueue: capacity must be positive");
+        }
+        std::size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        mask_ = rounded - 1;
+        cells_ = std::make_unique<Cell[]>(rounded);
+        for (std::size_t i = 0; i < rounded; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    IngestQueue(const IngestQueue&) = delete;
+    IngestQueue& operator=(const IngestQueue&) = delete;
+
+    // Producer side. Returns false if the item was not queued (dropped or queue closed).
+    bool push(T&& item) {
+        if (closed_.load(std::memory_order_acquire)) return false;
+
+        switch (policy_) {
+            case BackpressurePolicy::DropNewest:
+                if (!tryEnqueue(item)) {
+                    droppedNewest_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                break;
+
+            case BackpressurePolicy::DropOldest:
+                while (!tryEnqueue(item)) {
+                    std::optional<T> victim;
+                    if (tryDequeue(victim)) {
+                        droppedOldest_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                break;
+
+            case BackpressurePolicy::Block: {
+                Backoff backoff;
+                while (!tryEnqueue(item)) {
+                    if (closed_.load(std::memory_order_acquire)) return false;
+                    backoff.pause();
+                }
+                break;
+            }
+        }
+
+        pushed_.fetch_add(1, std::memory_order_relaxed);
+        std::size_t occupancy = size();
+        if (occupancy > highWater_.load(std::memory_order_relaxed)) {
+            highWater_.store(occupancy, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // Consumer side, non-blocking
+    bool tryPop(T& out) {
+        std::optional<T> item;
+        if (!tryDequeue(item)) return false;
+        out = std::move(*item);
+        popped_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer side, waits for an item. Returns false once the queue is closed and drained.
+    bool pop(T& out) {
+        Backoff backoff;
+        while (!tryPop(out)) {
+            if (closed_.load(std::memory_order_acquire) && size() == 0) return false;
+            backoff.pause();
+        }
+        return true;
+    }
+
+    // Stops accepting new items and releases blocked producers/consumers once drained
+    void close() { closed_.store(true, std::memory_order_release); }
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+    BackpressurePolicy policy() const noexcept { return policy_; }
+
+    // Approximate while producers/consumers are active
+    std::size_t size() const {
+        std::size_t tail = enqueuePos_.load(std::memory_order_acquire);
+        std::size_t head = dequeuePos_.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : 0;
+    }
+
+    IngestQueueStats stats() const {
+        IngestQueueStats s;
+        s.capacity = capacity();
+        s.occupancy = size();
+        s.highWater = highWater_.load(std::memory_order_relaxed);
+        s.pushed = pushed_.load(std::memory_order_relaxed);
+        s.popped = popped_.load(std::memory_order_relaxed);
+        s.droppedOldest = droppedOldest_.load(std::memory_order_relaxed);
+        s.droppedNewest = droppedNewest_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    static constexpr std::size_t kCacheLine = 64;
+
+    struct alignas(kCacheLine) Cell {
+        std::atomic<std::size_t> sequence{0};
+        std::optional<T> value;
+    };
+
+    // Spin briefly, then yield, then sleep so idle workers do not burn a core
+    struct Backoff {
+        unsigned spins = 0;
+        void pause() {
+            if (spins < 64) {
+                ++spins;
+            } else if (spins < 128) {
+                ++spins;
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+    };
+
+    // Only moves from `item` on success
+    bool tryEnqueue(T& item) {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value.emplace(std::move(item));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryDequeue(std::optional<T>& out) {
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;  // empty
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        out.emplace(std::move(*cell->value));
+        cell->value.reset();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    BackpressurePolicy policy_;
+    std::size_t mask_ = 0;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(kCacheLine) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(kCacheLine) std::atomic<std::size_t> dequeuePos_{0};
+    alignas(kCacheLine) std::atomic<bool> closed_{false};
+
+    std::atomic<std::size_t> highWater_{0};
+    std::atomic<std::uint64_t> pushed_{0};
+    std::atomic<std::uint64_t> popped_{0};
+    std::atomic<std::uint64_t> droppedOldest_{0};
+    std::atomic<std::uint64_t> droppedNewest_{0};
+};
+
+using InputBundleQueue = IngestQueue<InputBundle>;
+
+#endif  // ANALYSIS_PIPELINE_CONTEXT_INGEST_QUEUE_H
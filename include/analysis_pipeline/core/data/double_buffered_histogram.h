@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include <TH1.h>
+
+class PipelineDataProduct;
+class PipelineDataProductManager;
+
+/**
+ * @class DoubleBufferedHistogram
+ * @brief Accumulator histogram whose fills never contend with readers of the published product.
+ *
+ * Fills go to a private live buffer. publish() swaps the live buffer with a
+ * spare (O(1) under the fill mutex), then replaces the product's object with
+ * a copy of it that has the swapped-out fills added. Several instances may
+ * publish the same product (e.g. one per worker chain); the product then
+ * holds the sum of all their fills. The product lock is held only for the
+ * copy and add, never while filling, so fills do not wait for exporters or
+ * serializeAll().
+ */
+class DoubleBufferedHistogram {
+public:
+    DoubleBufferedHistogram(std::unique_ptr<TH1> prototype,
+                            std::string productName,
+                            std::unordered_set<std::string> tags,
+                            std::chrono::milliseconds publishInterval,
+                            PipelineDataProductManager* manager);
+    ~DoubleBufferedHistogram();
+
+    DoubleBufferedHistogram(const DoubleBufferedHistogram&) = delete;
+    DoubleBufferedHistogram& operator=(const DoubleBufferedHistogram&) = delete;
+
+    void fill(double x, double weight = 1.0);
+
+    // Merges pending fills and publishes a new snapshot. No-op after detach().
+    void publish();
+
+    // Publishes one last time and stops further publishing
+    void detach();
+    // Stops further publishing without touching the manager; pending fills are dropped
+    void discard();
+
+    const std::string& productName() const noexcept { return productName_; }
+    std::chrono::milliseconds publishInterval() const noexcept { return publishInterval_; }
+
+private:
+    static std::unique_ptr<TH1> emptyCopy(const TH1& prototype);
+    void publishLocked();
+    std::unique_ptr<PipelineDataProduct> makeProduct(std::shared_ptr<TObject> object) const;
+
+    std::string productName_;
+    std::unordered_set<std::string> tags_;
+    std::chrono::milliseconds publishInterval_;
+    PipelineDataProductManager* manager_;
+
+    std::mutex fillMutex_;
+    std::unique_ptr<TH1> live_;
+
+    std::mutex publishMutex_;
+    std::unique_ptr<TH1> spare_;
+    bool detached_ = false;
+};
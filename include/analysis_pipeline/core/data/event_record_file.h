@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "analysis_pipeline/core/data/mapped_file.h"
+#include "analysis_pipeline/core/data/raw_event_buffer.h"
+
+/**
+ * Recorded event file layout (little-endian):
+ *
+ *   file header : char magic[8] = "APEVREC1", uint32 version, uint32 reserved
+ *   record      : uint64 timestamp_ns, uint32 size, uint32 reserved, payload[size],
+ *                 zero padding to the next 8-byte boundary
+ *
+ * Payloads are opaque; they are usually raw or MIDAS-formatted DAQ events.
+ */
+namespace event_record_format {
+constexpr char kMagic[8] = {'A', 'P', 'E', 'V', 'R', 'E', 'C', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kFileHeaderSize = 16;
+constexpr std::size_t kRecordHeaderSize = 16;
+}  // namespace event_record_format
+
+/**
+ * @class EventRecordWriter
+ * @brief Appends events to a recorded event file.
+ */
+class EventRecordWriter {
+public:
+    explicit EventRecordWriter(const std::string& path);
+
+    void write(const std::uint8_t* data, std::size_t size, std::uint64_t timestampNs);
+    void write(const RawEventBuffer& event, std::uint64_t timestampNs);
+
+    std::size_t eventsWritten() const noexcept { return eventsWritten_; }
+
+    // Flushes and closes the file. Throws std::runtime_error if buffered events
+    // could not be written; without close(), such errors go unnoticed.
+    void close();
+
+private:
+    std::ofstream out_;
+    std::string path_;
+    std::size_t eventsWritten_ = 0;
+};
+
+/**
+ * @class EventRecordReader
+ * @brief Memory-maps a recorded event file and hands out events as zero-copy buffers.
+ *
+ * The index is built once on open. Buffers returned by event() keep the
+ * mapping alive, so they stay valid after the reader is destroyed.
+ */
+class EventRecordReader {
+public:
+    struct Entry {
+        std::size_t offset;  // payload offset within the file
+        std::uint32_t size;
+        std::uint64_t timestampNs;
+    };
+
+    explicit EventRecordReader(const std::string& path);
+
+    std::size_t size() const noexcept { return entries_.size(); }
+    const Entry& entry(std::size_t index) const { return entries_.at(index); }
+    std::shared_ptr<const RawEventBuffer> event(std::size_t index) const;
+
+private:
+    std::shared_ptr<const MappedFile> file_;
+    std::vector<Entry> entries_;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "analysis_pipeline/core/data/double_buffered_histogram.h"
+
+/**
+ * @class HistogramPublisher
+ * @brief Background thread that publishes registered DoubleBufferedHistograms at their cadence.
+ *
+ * One thread serves every registered histogram. It sleeps until the next one
+ * is due. The thread starts on first registration and stops when the last
+ * histogram is removed.
+ *
+ * Histograms publish into their manager, so they must be removed, or
+ * shutdown() called, while that manager is alive. The singleton's own
+ * destructor runs during static destruction, possibly after the managers are
+ * gone: it only stops the thread and never publishes.
+ */
+class HistogramPublisher {
+public:
+    static HistogramPublisher& instance();
+
+    ~HistogramPublisher();
+
+    HistogramPublisher(const HistogramPublisher&) = delete;
+    HistogramPublisher& operator=(const HistogramPublisher&) = delete;
+
+    void add(std::shared_ptr<DoubleBufferedHistogram> histogram);
+
+    // Stops publishing `histogram` after a final publish of its pending fills.
+    // With `flush` false nothing is published, so the manager may already be gone.
+    void remove(const std::shared_ptr<DoubleBufferedHistogram>& histogram, bool flush = true);
+
+    // End of run: stops the thread and removes every histogram, publishing its
+    // pending fills. A later add() starts publishing again.
+    void shutdown();
+
+private:
+    HistogramPublisher() = default;
+
+    struct Entry {
+        std::shared_ptr<DoubleBufferedHistogram> histogram;
+        std::chrono::steady_clock::time_point nextPublish;
+    };
+
+    void run(std::uint64_t generation);
+    void stopThread();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Entry> entries_;
+    std::thread thread_;
+    std::uint64_t generation_ = 0;  // bumped to stop the running thread
+};
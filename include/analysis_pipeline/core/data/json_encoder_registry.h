@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+#include <TObject.h>
+
+class TClass;
+
+/**
+ * @class JsonEncoderRegistry
+ * @brief Per-class JSON encoders used by PipelineDataProduct::serializeToJson().
+ *
+ * Classes with a registered encoder are written directly into nlohmann::json
+ * in the compact schema below. Every other class goes through TBufferJSON.
+ * An encoder registered for a class also covers classes derived from it,
+ * unless it was registered as exact-only. When several registrations match,
+ * the most-derived one wins. Registering a null encoder for a class sends
+ * it (and its subclasses) back to TBufferJSON. TProfile uses this, because
+ * its bin contents are not plain sums of weights.
+ *
+ * Compact schema (every object carries "_typename" = ROOT class name):
+ *
+ *   Histograms (TH1, TH2, TH3 and subclasses):
+ *     "name", "title", "entries"
+ *     "x" [, "y" [, "z"]]: { "nbins", "min", "max", "title",
+ *                            "edges": [nbins+1] only for variable binning,
+ *                            "labels": [nbins] only for labelled axes }
+ *     "contents": all cells including under/overflow, in ROOT global-bin
+ *                 order (x fastest), i.e. (nx+2)(ny+2)(nz+2) values
+ *     "sumw2": per-cell squared errors, same layout; only when Sumw2 is set
+ *     "stats": { "sumw", "sumw2", "sumwx", "sumwx2"
+ *                [, "sumwy", "sumwy2", "sumwxy"
+ *                [, "sumwz", "sumwz2", "sumwxz", "sumwyz"]] }
+ *
+ *   TParameter<T> (double, float, int, Long64_t, bool):
+ *     "name", "value"
+ */
+class JsonEncoderRegistry {
+public:
+    using Encoder = std::function<nlohmann::json(const TObject&)>;
+
+    static JsonEncoderRegistry& instance();
+
+    // Replaces any earlier registration for `cls`. A null encoder forces the TBufferJSON path.
+    void registerEncoder(const TClass* cls, Encoder encoder, bool includeDerived = true);
+    void unregisterEncoder(const TClass* cls);
+
+    // True if objects of class `cls` take a registered encoder
+    bool hasEncoder(const TClass* cls) const;
+
+    // Encodes with the registered encoder, or with TBufferJSON if there is none
+    nlohmann::json encode(const TObject& object) const;
+    static nlohmann::json encodeGeneric(const TObject& object);
+
+    // With the fast path disabled every object goes through TBufferJSON, for
+    // consumers that still expect ROOT's full JSON layout.
+    void setFastPathEnabled(bool enabled) noexcept { fastPath_.store(enabled, std::memory_order_relaxed); }
+    bool fastPathEnabled() const noexcept { return fastPath_.load(std::memory_order_relaxed); }
+
+private:
+    JsonEncoderRegistry();
+
+    struct Registration {
+        std::shared_ptr<const Encoder> encoder;  // null: use TBufferJSON
+        bool includeDerived = true;
+    };
+
+    std::shared_ptr<const Encoder> resolve(const TClass* cls) const;
+    void registerBuiltins();
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<const TClass*, Registration> registrations_;
+    // Resolved encoder per concrete class; cleared whenever registrations change
+    mutable std::unordered_map<const TClass*, std::shared_ptr<const Encoder>> resolved_;
+    std::atomic<bool> fastPath_{true};
+};
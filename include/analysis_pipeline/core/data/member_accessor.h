@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+class TClass;
+class TObject;
+class PipelineDataProduct;
+class PipelineDataProductManager;
+
+/**
+ * @class MemberAccessor
+ * @brief Reads one numeric data member of a product as a double, with the lookup cached.
+ *
+ * The first read through ROOT reflection records the class, member offset and
+ * type. Later reads of the same class are a pointer add and a load. A product
+ * of a different class is resolved again.
+ */
+class MemberAccessor {
+public:
+    MemberAccessor() = default;
+    MemberAccessor(std::string productName, std::string memberName);
+
+    const std::string& productName() const noexcept { return productName_; }
+    const std::string& memberName() const noexcept { return memberName_; }
+
+    // Throws std::runtime_error if the member is missing or not numeric
+    double read(const PipelineDataProduct& product);
+
+    // Looks up and read-locks the product. Returns false if it does not exist or holds no object.
+    bool read(PipelineDataProductManager& manager, double& value);
+
+    // Type names accepted by read(), e.g. "double", "Int_t", "ULong64_t"
+    static bool isNumericType(const std::string& typeName);
+
+private:
+    enum class Kind {
+        Unresolved, Double, Float, Int, UInt, Short, UShort, Long, ULong, Long64, ULong64, Bool, Char, UChar
+    };
+
+    void resolve(const TObject& object);
+    static Kind kindOf(const std::string& typeName);
+
+    std::string productName_;
+    std::string memberName_;
+
+    TClass* cachedClass_ = nullptr;
+    std::ptrdiff_t offset_ = 0;
+    Kind kind_ = Kind::Unresolved;
+};
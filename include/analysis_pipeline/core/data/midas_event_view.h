@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "analysis_pipeline/core/data/raw_event_buffer.h"
+
+/**
+ * @struct MidasBank
+ * @brief Location and type of a single bank inside a MIDAS event. Points into the raw buffer.
+ */
+struct MidasBank {
+    std::string_view name;     // 4-character bank name
+    std::uint32_t type = 0;    // MIDAS TID_* code
+    ByteView data;
+
+    // Typed, bounds-checked view of the bank payload. Throws if T does not match the bank type.
+    template <typename T>
+    TypedByteView<T> as() const;
+};
+
+/**
+ * @class MidasEventView
+ * @brief Zero-copy parser for the MIDAS event layout (EVENT_HEADER + BANK_HEADER + BANK/BANK32/BANK32A).
+ *
+ * Only the bank index is built on construction; payloads stay in the original buffer.
+ * Assumes the event was written on a little-endian host, as MIDAS does.
+ */
+class MidasEventView {
+public:
+    static constexpr std::size_t kEventHeaderSize = 16;
+    static constexpr std::size_t kBankHeaderSize = 8;
+
+    static constexpr std::uint32_t kBankFormat32Bit = 1u << 4;
+    static constexpr std::uint32_t kBankFormat64BitAligned = 1u << 5;
+
+    // Throws std::runtime_error if the buffer is not a well-formed MIDAS event
+    explicit MidasEventView(ByteView event);
+
+    std::uint16_t eventId() const noexcept { return eventId_; }
+    std::uint16_t triggerMask() const noexcept { return triggerMask_; }
+    std::uint32_t serialNumber() const noexcept { return serialNumber_; }
+    std::uint32_t timeStamp() const noexcept { return timeStamp_; }
+    std::uint32_t bankFlags() const noexcept { return bankFlags_; }
+
+    const std::vector<MidasBank>& banks() const noexcept { return banks_; }
+    const MidasBank* findBank(std::string_view name) const noexcept;
+    const MidasBank& getBank(std::string_view name) const;
+
+    // Element size in bytes for a MIDAS TID_* code, or 0 if it has no fixed element size
+    static std::size_t typeSize(std::uint32_t type) noexcept;
+
+private:
+    std::uint16_t eventId_ = 0;
+    std::uint16_t triggerMask_ = 0;
+    std::uint32_t serialNumber_ = 0;
+    std::uint32_t timeStamp_ = 0;
+    std::uint32_t bankFlags_ = 0;
+    std::vector<MidasBank> banks_;
+};
+
+template <typename T>
+TypedByteView<T> MidasBank::as() const {
+    std::size_t expected = MidasEventView::typeSize(type);
+    if (expected != 0 && expected != sizeof(T)) {
+        throw std::runtime_error("MidasBank '" + std::string(name) + "': element size " +
+                                 std::to_string(sizeof(T)) + " does not match bank type " +
+                                 std::to_string(type));
+    }
+    return data.as<T>();
+}
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "analysis_pipeline/core/data/pipeline_data_product.h"
+#include "analysis_pipeline/core/data/product_change_notifier.h"
+
+class PipelineDataProductManager;
+
+enum class CheckoutMode : std::uint8_t { Read, Write };
+
+/**
+ * @class ProductHandle
+ * @brief Pre-resolved reference to a product slot in a PipelineDataProductManager.
+ *
+ * Skips the name lookup on checkout. A handle follows the product when its
+ * contents are replaced by addOrUpdate. It shares ownership of the product's
+ * slot, so using it after the product was removed is safe but reaches the
+ * removed product, not one added later under the same name.
+ */
+class ProductHandle {
+public:
+    ProductHandle() = default;
+
+    std::uint64_t id() const noexcept { return id_; }
+    explicit operator bool() const noexcept { return mutex_ != nullptr; }
+
+private:
+    friend class PipelineDataProductManager;
+    template <std::size_t N> friend class MultiCheckout;
+
+    // `Entry` is the manager's private slot type
+    template <typename Entry>
+    explicit ProductHandle(const std::shared_ptr<Entry>& entry)
+        : id_(entry->id), mutex_(&entry->mutex), product_(&entry->product), owner_(entry) {}
+
+    std::uint64_t id_ = 0;
+    std::shared_mutex* mutex_ = nullptr;
+    const std::unique_ptr<PipelineDataProduct>* product_ = nullptr;
+    std::shared_ptr<const void> owner_;  // keeps mutex_ and product_ alive
+};
+
+/**
+ * One entry of a mixed checkout: a product (by name or handle) and an access mode.
+ * A name is referenced, not copied, so it only has to outlive the checkoutMixed() call.
+ */
+struct CheckoutRequest {
+    const std::string* name = nullptr;
+    ProductHandle handle;
+    CheckoutMode mode = CheckoutMode::Read;
+
+    static CheckoutRequest read(const std::string& name) { return {&name, {}, CheckoutMode::Read}; }
+    static CheckoutRequest write(const std::string& name) { return {&name, {}, CheckoutMode::Write}; }
+    static CheckoutRequest read(ProductHandle handle) { return {nullptr, handle, CheckoutMode::Read}; }
+    static CheckoutRequest write(ProductHandle handle) { return {nullptr, handle, CheckoutMode::Write}; }
+};
+
+/**
+ * @class MultiCheckout
+ * @brief RAII guard over N products locked in one step by PipelineDataProductManager::checkoutMixed.
+ *
+ * Locks are taken in ascending product id order, the same global order used by
+ * checkoutReadMultiple/checkoutWriteMultiple, so two stages requesting
+ * overlapping sets in different orders cannot deadlock. A product requested
+ * twice is locked once, in write mode if either request writes. Accessors
+ * are indexed by request position. All storage is inline. Products locked
+ * for writing are reported as Updated to the manager's change subscribers
+ * once released, as with checkoutWrite().
+ *
+ *     auto locks = manager.checkoutMixed(CheckoutRequest::read("hits"),
+ *                                        CheckoutRequest::write("hit_count"));
+ *     const auto& hits = locks.read<ValueBatch>(0);
+ *     locks.write<TParameter<int>>(1).SetVal(hits.size());
+ */
+template <std::size_t N>
+class MultiCheckout {
+public:
+    MultiCheckout(const MultiCheckout&) = delete;
+    MultiCheckout& operator=(const MultiCheckout&) = delete;
+
+    MultiCheckout(MultiCheckout&& other) noexcept
+        : slots_(other.slots_), order_(other.order_), locked_(other.locked_),
+          notifier_(std::exchange(other.notifier_, nullptr)) {
+        other.locked_ = 0;
+    }
+
+    ~MultiCheckout() { release(); }
+
+    static constexpr std::size_t size() noexcept { return N; }
+    CheckoutMode mode(std::size_t i) const { return slots_.at(i).mode; }
+
+    const PipelineDataProduct& product(std::size_t i) const { return *checked(i); }
+
+    // Throws if request `i` was made in read mode
+    PipelineDataProduct& writable(std::size_t i) {
+        if (slots_.at(i).mode != CheckoutMode::Write) {
+            throw std::logic_error("MultiCheckout: product " + std::to_string(i) + " was checked out for reading");
+        }
+        return *checked(i);
+    }
+
+    // Object of request `i` as T; throws if it holds no object or a different type
+    template <typename T>
+    const T& read(std::size_t i) const {
+        return cast<T>(*checked(i));
+    }
+
+    template <typename T>
+    T& write(std::size_t i) {
+        return cast<T>(writable(i));
+    }
+
+    // Releases all locks early, in reverse acquisition order
+    void release() noexcept {
+        const ProductChangeNotifier* notifier = std::exchange(notifier_, nullptr);
+        std::vector<ProductChange> changes;
+        while (locked_ > 0) {
+            const Slot& slot = slots_[order_[--locked_]];
+            if (!slot.owner) continue;
+            if (slot.lockMode == CheckoutMode::Write) {
+                if (notifier) recordUpdate(slot, changes);
+                slot.handle.mutex_->unlock();
+            } else {
+                slot.handle.mutex_->unlock_shared();
+            }
+        }
+        // Subscribers run after every lock is released; the notifier logs their errors
+        if (notifier && !changes.empty()) {
+            try {
+                notifier->notify(changes);
+            } catch (...) {
+            }
+        }
+    }
+
+private:
+    friend class PipelineDataProductManager;
+
+    struct Slot {
+        ProductHandle handle;
+        CheckoutMode mode = CheckoutMode::Read;      // as requested
+        CheckoutMode lockMode = CheckoutMode::Read;  // as locked (strongest over duplicates)
+        bool owner = true;                           // false for duplicates of an earlier request
+    };
+
+    MultiCheckout() = default;
+
+    // Called by the manager with resolved handles
+    void acquire() {
+        for (std::size_t i = 0; i < N; ++i) {
+            order_[i] = i;
+            slots_[i].lockMode = slots_[i].mode;
+            slots_[i].owner = true;
+            for (std::size_t j = 0; j < i; ++j) {
+                if (slots_[j].owner && slots_[j].handle.id_ == slots_[i].handle.id_) {
+                    slots_[i].owner = false;
+                    if (slots_[i].mode == CheckoutMode::Write) slots_[j].lockMode = CheckoutMode::Write;
+                    break;
+                }
+            }
+        }
+
+        // Insertion sort: N is a handful of products
+        for (std::size_t i = 1; i < N; ++i) {
+            std::size_t index = order_[i];
+            std::size_t j = i;
+            for (; j > 0 && slots_[order_[j - 1]].handle.id_ > slots_[index].handle.id_; --j) {
+                order_[j] = order_[j - 1];
+            }
+            order_[j] = index;
+        }
+
+        for (std::size_t i = 0; i < N; ++i) {
+            const Slot& slot = slots_[order_[i]];
+            if (slot.owner) {
+                if (slot.lockMode == CheckoutMode::Write) {
+                    slot.handle.mutex_->lock();
+                } else {
+                    slot.handle.mutex_->lock_shared();
+                }
+            }
+            locked_ = i + 1;
+        }
+    }
+
+    // Name and tags are captured while the write lock is still held
+    static void recordUpdate(const Slot& slot, std::vector<ProductChange>& changes) noexcept {
+        const PipelineDataProduct* product = slot.handle.product_->get();
+        if (!product) return;
+        try {
+            ProductChange change{product->getName(), ProductChangeType::Updated, {}};
+            const auto& tags = product->getTags();
+            change.tags.assign(tags.begin(), tags.end());
+            changes.push_back(std::move(change));
+        } catch (...) {
+        }
+    }
+
+    PipelineDataProduct* checked(std::size_t i) const {
+        if (locked_ != N) {
+            throw std::logic_error("MultiCheckout: products have been released");
+        }
+        PipelineDataProduct* product = slots_.at(i).handle.product_->get();
+        if (!product) {
+            throw std::runtime_error("MultiCheckout: product " + std::to_string(i) + " is empty");
+        }
+        return product;
+    }
+
+    template <typename T>
+    static T& cast(const PipelineDataProduct& product) {
+        auto* object = dynamic_cast<T*>(product.getObject());
+        if (!object) {
+            throw std::runtime_error("MultiCheckout: product '" + product.getName() + "' does not hold the requested type");
+        }
+        return *object;
+    }
+
+    std::array<Slot, N> slots_{};
+    std::array<std::size_t, N> order_{};
+    std::size_t locked_ = 0;
+    const ProductChangeNotifier* notifier_ = nullptr;  // set by the manager while it has subscribers
+};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <map>
@@ -23,6 +26,14 @@ public:
     void setObject(std::unique_ptr<TObject> obj);
     void setSharedObject(std::shared_ptr<TObject> obj);
 
+    // Deferred object: `loader` runs once, on the first getObject()/getSharedObject(),
+    // so restored products cost nothing until used. `sizeHint` stands in for the
+    // object's size in memory accounting until then.
+    using ObjectLoader = std::function<std::unique_ptr<TObject>()>;
+    void setLazyObject(ObjectLoader loader, std::size_t sizeHint = 0);
+    bool isLoaded() const noexcept;
+    std::size_t lazySizeHint() const noexcept;
+
     const std::string& getName() const;
     void setName(const std::string& name);
 
@@ -32,7 +43,7 @@ public:
     std::pair<void*, std::string> getMemberPointerAndType(const std::string& memberName) const;
     std::map<std::string, std::pair<void*, std::string>> getAllMembers() const;
 
-    // JSON Serialization
+    // JSON Serialization (compact schema for registered classes, see JsonEncoderRegistry)
     nlohmann::json serializeToJson() const;
 
     // Tag Management
@@ -42,7 +53,17 @@ public:
     const std::unordered_set<std::string>& getTags() const;
 
 private:
+    struct LazyObject {
+        ObjectLoader loader;
+        std::size_t sizeHint = 0;
+        std::once_flag once;
+        std::atomic<bool> loaded{false};
+        std::shared_ptr<TObject> object;
+        const std::shared_ptr<TObject>& get();
+    };
+
     std::shared_ptr<TObject> object_;
+    std::shared_ptr<LazyObject> lazy_;  // shared by copies, so the object is loaded once
     std::string name_;
     std::unordered_set<std::string> tags_;
 };
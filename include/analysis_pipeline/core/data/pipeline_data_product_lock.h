@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 class PipelineDataProduct;
 
 class PipelineDataProductLock {
@@ -15,7 +17,11 @@ public:
     explicit operator bool() const noexcept;
 
 protected:
-    explicit PipelineDataProductLock(PipelineDataProduct* prod);
+    PipelineDataProductLock(PipelineDataProduct* prod, std::shared_ptr<const void> owner);
 
     PipelineDataProduct* product_ = nullptr;
+    // Keeps the manager's slot, and with it the locked mutex and the product,
+    // alive if the product is removed while checked out. Derived locks must
+    // unlock before this is released.
+    std::shared_ptr<const void> owner_;
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 #include <memory>
@@ -9,6 +11,11 @@
 #include <nlohmann/json.hpp>
 
 #include "analysis_pipeline/core/data/pipeline_data_product.h"
+#include "analysis_pipeline/core/data/products/atomic_accumulator.h"
+#include "analysis_pipeline/core/data/products/atomic_counter.h"
+#include "analysis_pipeline/core/data/multi_checkout.h"
+#include "analysis_pipeline/core/data/product_change_notifier.h"
+#include "analysis_pipeline/core/data/product_memory.h"
 #include "analysis_pipeline/core/data/pipeline_data_product_read_lock.h"
 #include "analysis_pipeline/core/data/pipeline_data_product_write_lock.h"
 
@@ -32,11 +39,34 @@ public:
     std::vector<std::string> getExistingProducts(const std::vector<std::string>& names) const;
 
     PipelineDataProductReadLock checkoutRead(const std::string& name);
+    // Like checkoutRead, but returns an invalid lock instead of throwing if the product does not exist
+    PipelineDataProductReadLock tryCheckoutRead(const std::string& name);
     PipelineDataProductWriteLock checkoutWrite(const std::string& name);
     std::vector<PipelineDataProductReadLock> checkoutReadMultiple(const std::vector<std::string>& names);
     std::vector<PipelineDataProductWriteLock> checkoutWriteMultiple(const std::vector<std::string>& names);
     std::unique_ptr<PipelineDataProduct> extractProduct(const std::string& name);
 
+    // Mixed read/write checkout of several products, deadlock-free (see MultiCheckout).
+    // Throws std::runtime_error if a named product does not exist.
+    template <typename... Requests>
+    MultiCheckout<sizeof...(Requests)> checkoutMixed(const Requests&... requests);
+    template <std::size_t N>
+    MultiCheckout<N> checkoutMixed(const std::array<CheckoutRequest, N>& requests);
+
+    // Resolves a name once for repeated checkouts. Throws if the product does not exist.
+    ProductHandle getHandle(const std::string& name);
+
+    // Lock-free statistics products. Returns the existing product's object or
+    // creates it with `tags`; keep the pointer and update it without checkouts.
+    // Replacing the product with addOrUpdate (or a checkpoint restore) moves
+    // the new value into this object, and eviction skips it while the pointer
+    // is held. Only remove/clear/extractProduct detach it from the manager.
+    // Throws std::runtime_error if `name` holds an object of another class.
+    std::shared_ptr<AtomicCounter> getOrCreateCounter(const std::string& name,
+                                                      const std::unordered_set<std::string>& tags = {});
+    std::shared_ptr<AtomicAccumulator> getOrCreateAccumulator(const std::string& name,
+                                                              const std::unordered_set<std::string>& tags = {});
+
     nlohmann::json serializeAll() const;
 
     // tags
@@ -55,12 +85,87 @@ public:
     std::vector<std::string> getNamesWithExactTags(const std::unordered_set<std::string>& tags) const;
     std::vector<std::string> getNamesWithNoTags() const;
 
+    // Memory accounting. Sizes are estimated (ProductMemoryEstimator) when a
+    // product is added and re-estimated by refreshMemoryUsage(), which picks up
+    // growth made through write handles.
+    void setMemoryLimits(const MemoryLimitConfig& limits);
+    MemoryLimitConfig getMemoryLimits() const;
+    MemoryUsageReport getMemoryUsage() const;
+    std::size_t getProductBytes(const std::string& name) const;
+    void refreshMemoryUsage();
+
+    // Change notifications. Adds, replacements and removals are reported, as
+    // are in-place edits through checkoutWrite(), checkoutWriteMultiple() and
+    // write-mode checkoutMixed() requests once their locks are released. Code
+    // that edits a product another way can announce it with notifyUpdated().
+    ProductSubscription subscribe(ProductSubscriptionFilter filter, ProductChangeNotifier::Callback callback);
+    ProductSubscription subscribe(ProductSubscriptionFilter filter, std::shared_ptr<ProductChangeQueue> queue);
+    void notifyUpdated(const std::string& name);
+    ProductChangeNotifier& changeNotifier() noexcept { return notifier_; }
+
 private:
     struct ProductEntry {
         std::unique_ptr<PipelineDataProduct> product;
         mutable std::shared_mutex mutex;
+        std::uint64_t id = 0;                           // lock order for multi-checkouts
+        std::size_t bytes = 0;                          // guarded by managerMutex_
+        std::vector<std::string> accountedTags;         // tags `bytes` was charged to
+        std::atomic<std::uint64_t> lastAccess{0};       // only maintained for LRU eviction
     };
 
+    // Entries are shared with the locks and handles that refer to them, so
+    // removing or evicting a product never frees a mutex someone is about to
+    // lock or holds; the entry goes away with its last lock or handle
+    using ProductMap = std::unordered_map<std::string, std::shared_ptr<ProductEntry>>;
+
+    void touch(ProductEntry& entry) const;
+    void resolveHandles(const CheckoutRequest* requests, ProductHandle* handles, std::size_t count);
+    bool admitLocked(const std::string& name, const PipelineDataProduct& product, std::size_t bytes);
+    bool exceedsLimitsLocked(std::size_t bytes, const std::unordered_set<std::string>& tags,
+                             const ProductEntry* replaced, std::unordered_set<std::string>* overTags = nullptr) const;
+    bool evictForLocked(std::size_t bytes, const std::unordered_set<std::string>& tags,
+                        const std::string& incomingName);
+    void storeLocked(const std::string& name, std::unique_ptr<PipelineDataProduct> product);
+    ProductMap::iterator eraseLocked(ProductMap::iterator it);
+    void accountAddLocked(ProductEntry& entry, bool captureTags);
+    void accountRemoveLocked(const ProductEntry& entry);
+    void recordChangeLocked(const std::string& name, ProductChangeType type, const ProductEntry& entry);
+    void flushChanges(std::unique_lock<std::shared_mutex>& managerLock);
+    template <typename T>
+    std::shared_ptr<T> getOrCreateShared(const std::string& name, const std::unordered_set<std::string>& tags);
+
     mutable std::shared_mutex managerMutex_;
-    std::unordered_map<std::string, ProductEntry> products_;
+    ProductMap products_;
+    std::uint64_t nextEntryId_ = 0;
+
+    // Accounting state, guarded by managerMutex_
+    MemoryLimitConfig memoryLimits_;
+    MemoryUsageReport::Usage totalUsage_;
+    std::unordered_map<std::string, MemoryUsageReport::Usage> tagUsage_;
+    std::uint64_t rejectedProducts_ = 0;
+    std::uint64_t evictedProducts_ = 0;
+    std::atomic<bool> trackAccess_{false};
+
+    ProductChangeNotifier notifier_;
+    std::vector<ProductChange> pendingChanges_;  // guarded by managerMutex_, flushed after unlocking
 };
+
+template <typename... Requests>
+MultiCheckout<sizeof...(Requests)> PipelineDataProductManager::checkoutMixed(const Requests&... requests) {
+    return checkoutMixed(std::array<CheckoutRequest, sizeof...(Requests)>{requests...});
+}
+
+template <std::size_t N>
+MultiCheckout<N> PipelineDataProductManager::checkoutMixed(const std::array<CheckoutRequest, N>& requests) {
+    std::array<ProductHandle, N> handles;
+    resolveHandles(requests.data(), handles.data(), N);
+
+    MultiCheckout<N> checkout;
+    for (std::size_t i = 0; i < N; ++i) {
+        checkout.slots_[i].handle = handles[i];
+        checkout.slots_[i].mode = requests[i].mode;
+    }
+    if (notifier_.active()) checkout.notifier_ = &notifier_;
+    checkout.acquire();
+    return checkout;
+}
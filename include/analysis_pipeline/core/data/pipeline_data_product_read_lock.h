@@ -10,13 +10,16 @@ class PipelineDataProductReadLock : public PipelineDataProductLock {
 
 public:
     PipelineDataProductReadLock() noexcept = default;
+    PipelineDataProductReadLock(PipelineDataProductReadLock&& other) noexcept = default;
+    PipelineDataProductReadLock& operator=(PipelineDataProductReadLock&& other) noexcept;
     const PipelineDataProduct* operator->() const noexcept;
     const PipelineDataProduct& operator*() const noexcept;
     const PipelineDataProduct* get() const noexcept;
 
 private:
     friend class PipelineDataProductManager;
-    PipelineDataProductReadLock(PipelineDataProduct* prod, std::shared_lock<std::shared_mutex>&& lock);
+    PipelineDataProductReadLock(PipelineDataProduct* prod, std::shared_lock<std::shared_mutex>&& lock,
+                                std::shared_ptr<const void> owner);
 
     std::shared_lock<std::shared_mutex> lock_;
 };
@@ -2,21 +2,34 @@
 
 #include <shared_mutex>
 #include <mutex>
+#include <string>
 #include "analysis_pipeline/core/data/pipeline_data_product_lock.h"
 
 class PipelineDataProduct;
+class ProductChangeNotifier;
 
 class PipelineDataProductWriteLock : public PipelineDataProductLock {
 
 public:
     PipelineDataProductWriteLock() noexcept = default;
+    PipelineDataProductWriteLock(PipelineDataProductWriteLock&& other) noexcept;
+    PipelineDataProductWriteLock& operator=(PipelineDataProductWriteLock&& other) noexcept;
+    ~PipelineDataProductWriteLock() override;
+
     PipelineDataProduct* operator->() noexcept;
     PipelineDataProduct& operator*() noexcept;
     PipelineDataProduct* get() noexcept;
 
 private:
     friend class PipelineDataProductManager;
-    PipelineDataProductWriteLock(PipelineDataProduct* prod, std::unique_lock<std::shared_mutex>&& lock);
+    PipelineDataProductWriteLock(PipelineDataProduct* prod, std::unique_lock<std::shared_mutex>&& lock,
+                                 std::shared_ptr<const void> owner);
+
+    // Reports an Updated change for `name` once the lock is released
+    void notifyOnRelease(const ProductChangeNotifier* notifier, std::string name);
+    void release() noexcept;
 
     std::unique_lock<std::shared_mutex> lock_;
+    const ProductChangeNotifier* notifier_ = nullptr;
+    std::string notifyName_;
 };
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+enum class ProductChangeType { Added, Updated, Removed };
+
+struct ProductChange {
+    std::string name;
+    ProductChangeType type = ProductChangeType::Updated;
+    std::vector<std::string> tags;
+};
+
+/**
+ * Which changes a subscriber wants. A change matches if its product name is
+ * listed, matches one of the glob patterns ('*' and '?'), or carries one of
+ * the tags. An empty filter matches everything.
+ */
+struct ProductSubscriptionFilter {
+    std::vector<std::string> names;
+    std::vector<std::string> patterns;
+    std::vector<std::string> tags;
+
+    static ProductSubscriptionFilter forName(std::string name);
+    static ProductSubscriptionFilter forTag(std::string tag);
+    static ProductSubscriptionFilter forPattern(std::string pattern);
+
+    // Reads {"names": [...], "patterns": [...], "tags": [...]}
+    static ProductSubscriptionFilter fromJson(const nlohmann::json& config);
+
+    bool matches(const ProductChange& change) const;
+    static bool globMatch(const std::string& pattern, const std::string& name);
+};
+
+/**
+ * @class ProductChangeQueue
+ * @brief Mailbox for a subscriber thread that waits instead of polling.
+ *
+ * Holds at most `capacity` changes; on overflow the oldest are dropped and
+ * counted. On Linux, fd() returns an eventfd that becomes readable while
+ * changes are pending, so the queue can join an existing poll()/epoll loop.
+ */
+class ProductChangeQueue {
+public:
+    explicit ProductChangeQueue(std::size_t capacity = 1024);
+    ~ProductChangeQueue();
+
+    ProductChangeQueue(const ProductChangeQueue&) = delete;
+    ProductChangeQueue& operator=(const ProductChangeQueue&) = delete;
+
+    void push(const ProductChange& change);
+
+    // Blocks until changes are pending (or close()) and returns all of them
+    std::vector<ProductChange> wait();
+    // Like wait(), but returns an empty vector after `timeout`
+    std::vector<ProductChange> waitFor(std::chrono::milliseconds timeout);
+    // Returns pending changes without blocking
+    std::vector<ProductChange> drain();
+
+    // Wakes all waiters; later waits return immediately
+    void close();
+    bool closed() const;
+
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    // eventfd, created on first call; -1 where unsupported
+    int fd();
+
+private:
+    std::vector<ProductChange> takeLocked();
+
+    const std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<ProductChange> pending_;
+    bool closed_ = false;
+    int eventFd_ = -1;
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+class ProductSubscription;
+
+/**
+ * @class ProductChangeNotifier
+ * @brief Delivers product add/update/remove events to subscribers.
+ *
+ * Owned by PipelineDataProductManager (see changeNotifier() there). Callbacks run
+ * synchronously on the thread that made the change, after the manager's
+ * locks are released, so they may use the manager but should return quickly.
+ * With no subscribers, active() is a single relaxed load and the manager
+ * skips building change records altogether.
+ */
+class ProductChangeNotifier {
+public:
+    using Callback = std::function<void(const ProductChange&)>;
+
+    ProductChangeNotifier();
+
+    ProductSubscription subscribe(ProductSubscriptionFilter filter, Callback callback);
+
+    // Routes matching changes into `queue`; the subscription holds a reference to it
+    ProductSubscription subscribe(ProductSubscriptionFilter filter, std::shared_ptr<ProductChangeQueue> queue);
+
+    bool active() const noexcept { return state_->count.load(std::memory_order_relaxed) != 0; }
+    std::size_t subscriberCount() const noexcept { return state_->count.load(std::memory_order_relaxed); }
+
+    void notify(const std::vector<ProductChange>& changes) const;
+    void notify(const ProductChange& change) const;
+
+private:
+    friend class ProductSubscription;
+
+    struct Subscriber {
+        ProductSubscriptionFilter filter;
+        Callback callback;
+    };
+
+    // Shared with subscriptions so they can outlive the notifier
+    struct State {
+        std::mutex mutex;
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<const Subscriber>>> subscribers;
+        std::uint64_t nextId = 0;
+        std::atomic<std::size_t> count{0};
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * @class ProductSubscription
+ * @brief Keeps a subscription alive; unsubscribes when destroyed.
+ *
+ * A callback may still be running on another thread when unsubscribe()
+ * returns.
+ */
+class ProductSubscription {
+public:
+    ProductSubscription() = default;
+    ~ProductSubscription() { unsubscribe(); }
+
+    ProductSubscription(ProductSubscription&& other) noexcept;
+    ProductSubscription& operator=(ProductSubscription&& other) noexcept;
+    ProductSubscription(const ProductSubscription&) = delete;
+    ProductSubscription& operator=(const ProductSubscription&) = delete;
+
+    void unsubscribe();
+    bool active() const noexcept { return id_ != 0 && !state_.expired(); }
+
+private:
+    friend class ProductChangeNotifier;
+    ProductSubscription(std::weak_ptr<ProductChangeNotifier::State> state, std::uint64_t id)
+        : state_(std::move(state)), id_(id) {}
+
+    std::weak_ptr<ProductChangeNotifier::State> state_;
+    std::uint64_t id_ = 0;
+};
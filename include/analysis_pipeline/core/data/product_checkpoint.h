@@ -0,0 +1,213 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "analysis_pipeline/core/data/mapped_file.h"
+#include "analysis_pipeline/core/data/product_change_notifier.h"
+#include "analysis_pipeline/core/data/product_selection.h"
+#include "analysis_pipeline/core/data/raw_event_buffer.h"
+
+class PipelineDataProduct;
+class PipelineDataProductManager;
+
+/**
+ * Checkpoint file layout (little-endian):
+ *
+ *   file header : char magic[8] = "APPCKPT1", uint32 version, uint32 reserved
+ *   segment     : uint64 sequence, uint64 unix_time_ns, uint32 record_count,
+ *                 uint32 removed_count, uint32 payload_size, uint32 reserved,
+ *                 uint64 checksum (FNV-1a of the payload),
+ *                 payload = record_count ProductCodec records,
+ *                           removed_count { uint16 name_length, name }
+ *
+ * The first segment holds every checkpointed product. Later segments are
+ * appended and hold only the products that changed, plus the names of the
+ * products that were removed. On restore the newest record of each name wins.
+ * A torn or corrupt segment at the end (e.g. from a crash mid-write) ends the
+ * file.
+ */
+namespace product_checkpoint_format {
+constexpr char kMagic[8] = {'A', 'P', 'P', 'C', 'K', 'P', 'T', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kFileHeaderSize = 16;
+constexpr std::size_t kSegmentHeaderSize = 40;
+}  // namespace product_checkpoint_format
+
+struct CheckpointSegment {
+    std::uint64_t sequence = 0;
+    std::uint32_t recordCount = 0;
+    std::string records;                // recordCount concatenated ProductCodec records
+    std::vector<std::string> removed;
+};
+
+/**
+ * @class ProductCheckpointWriter
+ * @brief Appends checkpoint segments to a file, or rewrites it with a single full segment.
+ */
+class ProductCheckpointWriter {
+public:
+    explicit ProductCheckpointWriter(std::string path);
+
+    // Replaces the file atomically ("<path>.tmp" + rename) with one segment
+    void writeFull(const CheckpointSegment& segment);
+
+    // Appends a segment. `validBytes` > 0 first truncates the file to that
+    // length, dropping a torn tail. A missing file, or one too short to hold a
+    // file header, is written with writeFull() instead.
+    void append(const CheckpointSegment& segment, std::uint64_t validBytes = 0);
+
+    const std::string& path() const noexcept { return path_; }
+    std::uint64_t fileBytes() const noexcept { return fileBytes_; }
+
+private:
+    void openForAppend(std::uint64_t validBytes, std::uint64_t fileSize);
+
+    std::string path_;
+    std::ofstream out_;
+    std::uint64_t fileBytes_ = 0;
+};
+
+/**
+ * @class ProductCheckpointReader
+ * @brief Memory-maps a checkpoint file and indexes the newest record of each product.
+ *
+ * Opening only reads the segment and record headers. Objects are decoded by
+ * restoreInto(), and with `lazy` set only when a product's object is first used.
+ */
+class ProductCheckpointReader {
+public:
+    struct Record {
+        std::string name;
+        std::size_t offset = 0;  // of the ProductCodec record in the file
+        std::size_t size = 0;
+    };
+
+    // Throws std::runtime_error if the file is missing or is not a checkpoint file
+    explicit ProductCheckpointReader(const std::string& path);
+
+    const std::vector<Record>& records() const noexcept { return records_; }
+    std::size_t segmentCount() const noexcept { return segments_; }
+    std::uint64_t lastSequence() const noexcept { return lastSequence_; }
+    // Length of the intact prefix of the file; anything after it is a torn segment
+    std::size_t validBytes() const noexcept { return validBytes_; }
+    // Bytes of the live records, i.e. the size of a fully compacted checkpoint
+    std::size_t liveBytes() const noexcept { return liveBytes_; }
+
+    ByteView recordBytes(const Record& record) const;
+    std::unique_ptr<PipelineDataProduct> decode(const Record& record, bool lazy = true) const;
+
+    // Adds every live product to `manager` in one call, replacing products of
+    // the same name. An existing AtomicCounter/AtomicAccumulator keeps its
+    // object and takes the restored value. Returns the number restored.
+    std::size_t restoreInto(PipelineDataProductManager& manager, bool lazy = true) const;
+
+private:
+    std::shared_ptr<const MappedFile> file_;
+    std::vector<Record> records_;
+    std::size_t segments_ = 0;
+    std::uint64_t lastSequence_ = 0;
+    std::size_t validBytes_ = 0;
+    std::size_t liveBytes_ = 0;
+};
+
+struct ProductCheckpointConfig {
+    std::string path;
+    ProductSelection selection;                // empty: every product
+    double compactRatio = 4.0;                 // rewrite once the file exceeds this multiple of the live data
+
+    // Reads {"file", "products", "tags", "compact_ratio"}
+    static ProductCheckpointConfig fromJson(const nlohmann::json& config);
+};
+
+/**
+ * @class ProductCheckpointer
+ * @brief Writes incremental checkpoints of selected products on a background thread.
+ *
+ * The checkpointer subscribes to the manager's change notifications and only
+ * writes products added or updated since the previous checkpoint. AtomicCounter
+ * and AtomicAccumulator products change without notifications, so loaded ones
+ * are written every time. Each product is encoded under its own read lock, on
+ * the checkpointer's thread, so the pipeline never waits for the disk.
+ *
+ * If the file already holds a checkpoint (e.g. one just restored from), new
+ * segments are appended to it. Otherwise, and whenever the file grows past
+ * compactRatio times its live data, a full checkpoint is written. A full
+ * checkpoint copies the records of unchanged products from the old file
+ * without decoding them.
+ */
+class ProductCheckpointer {
+public:
+    struct Stats {
+        std::uint64_t checkpoints = 0;
+        std::uint64_t fullCheckpoints = 0;
+        std::uint64_t productsWritten = 0;
+        std::uint64_t bytesWritten = 0;
+        std::uint64_t failures = 0;
+        std::chrono::microseconds lastDuration{0};
+    };
+
+    ProductCheckpointer(PipelineDataProductManager& manager, ProductCheckpointConfig config);
+    // Stops the background thread without touching the manager; call finish() first
+    ~ProductCheckpointer();
+
+    ProductCheckpointer(const ProductCheckpointer&) = delete;
+    ProductCheckpointer& operator=(const ProductCheckpointer&) = delete;
+
+    // Wakes the background thread to write a checkpoint; never blocks
+    void request();
+    // Writes a checkpoint on the calling thread. Returns the number of products written.
+    std::size_t checkpointNow();
+    // End of run, while the manager still exists: stops the background thread,
+    // writes a final checkpoint of pending changes and unsubscribes
+    void finish();
+
+    Stats stats() const;
+
+private:
+    // Shared with the notification callback, which may outlive the checkpointer briefly
+    struct ChangeSet {
+        std::mutex mutex;
+        std::unordered_set<std::string> changed;
+        std::unordered_set<std::string> removed;
+    };
+
+    void run();
+    void stopThread();
+    std::size_t writeCheckpoint();
+
+    PipelineDataProductManager& manager_;
+    ProductCheckpointConfig config_;
+    ProductCheckpointWriter writer_;
+    std::shared_ptr<ChangeSet> changes_;
+    ProductSubscription subscription_;
+
+    // Guarded by writeMutex_
+    std::mutex writeMutex_;
+    std::uint64_t nextSequence_ = 1;
+    bool needFull_ = true;
+    std::uint64_t validBytes_ = 0;                                  // truncate to this before the first append
+    std::unordered_map<std::string, std::uint64_t> recordBytes_;    // size of each live record in the file
+    std::uint64_t liveBytes_ = 0;
+
+    mutable std::mutex statsMutex_;
+    Stats stats_;
+
+    std::mutex threadMutex_;
+    std::condition_variable threadCv_;
+    bool requested_ = false;
+    bool stopping_ = false;
+    bool finished_ = false;
+    std::thread thread_;
+};
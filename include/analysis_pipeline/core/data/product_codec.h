@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "analysis_pipeline/core/data/pipeline_data_product.h"
+#include "analysis_pipeline/core/data/raw_event_buffer.h"
+
+/**
+ * @class ProductCodec
+ * @brief Compact binary encoding of a PipelineDataProduct (name, tags and ROOT-streamed object).
+ *
+ * Record layout (little-endian):
+ *   uint32 record_size (bytes following this field)
+ *   uint16 name_length, name
+ *   uint16 tag_count, { uint16 tag_length, tag } * tag_count
+ *   uint32 object_length, object (TBufferFile::WriteObject output)
+ */
+class ProductCodec {
+public:
+    // Appends the encoded product to `out`. Throws if the product holds no object.
+    static void encode(const PipelineDataProduct& product, std::string& out);
+
+    // Decodes the record starting at `offset` and advances `offset` past it
+    static std::unique_ptr<PipelineDataProduct> decode(ByteView bytes, std::size_t& offset);
+
+    // Like decode(), but the object is only deserialized on first access (see
+    // PipelineDataProduct::setLazyObject). `owner` keeps `bytes` alive until then.
+    static std::unique_ptr<PipelineDataProduct> decodeLazy(ByteView bytes, std::size_t& offset,
+                                                           std::shared_ptr<const void> owner);
+
+    // Name of the record at `offset`, without deserializing its object
+    static std::string peekName(ByteView bytes, std::size_t offset);
+
+    // Size in bytes of the record at `offset`, including its length prefix
+    static std::size_t recordSize(ByteView bytes, std::size_t offset);
+
+private:
+    // Name and tags of the record at `offset`; `objectBytes` receives the streamed object
+    static std::unique_ptr<PipelineDataProduct> decodeHeader(ByteView bytes, std::size_t& offset, ByteView& objectBytes);
+    static std::unique_ptr<TObject> decodeObject(ByteView objectBytes, const std::string& name);
+};
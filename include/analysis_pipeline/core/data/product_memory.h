@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+class TClass;
+class TObject;
+class PipelineDataProduct;
+class PipelineDataProductManager;
+
+/**
+ * @class ProductMemoryEstimator
+ * @brief Approximate heap footprint of a product.
+ *
+ * Built-in rules cover ROOT array-backed objects (histograms), ValueBatch and
+ * RawEventProduct. Anything else counts as its class size. Estimates are cheap
+ * and do not stream the object. Register a function for classes whose size
+ * is dominated by dynamic storage.
+ */
+class ProductMemoryEstimator {
+public:
+    using Estimator = std::function<std::size_t(const TObject&)>;
+
+    static std::size_t estimate(const PipelineDataProduct& product);
+    static std::size_t estimate(const TObject& object);
+
+    // Used for `cls` and classes derived from it; later registrations win
+    static void registerEstimator(TClass* cls, Estimator estimator);
+};
+
+// What the manager does when a product would exceed a memory limit
+enum class MemoryLimitPolicy {
+    Reject,   // drop the incoming product and count it
+    EvictLru  // remove least-recently-used evictable products first, then reject if still over
+};
+
+struct MemoryLimitConfig {
+    std::size_t maxBytes = 0;                                 // 0 = unlimited
+    std::unordered_map<std::string, std::size_t> tagLimits;  // per-tag byte limits
+    MemoryLimitPolicy policy = MemoryLimitPolicy::Reject;
+    std::unordered_set<std::string> evictableTags;           // only these are evicted
+
+    bool enabled() const { return maxBytes > 0 || !tagLimits.empty(); }
+
+    /**
+     * Reads
+     *   {"max_bytes": N, "tag_limits": {"tag": N, ...},
+     *    "policy": "reject" | "evict_lru", "evictable_tags": ["tag", ...]}
+     */
+    static MemoryLimitConfig fromJson(const nlohmann::json& config);
+};
+
+struct MemoryUsageReport {
+    struct Usage {
+        std::size_t bytes = 0;
+        std::size_t highWater = 0;
+        std::size_t products = 0;
+    };
+
+    Usage total;
+    std::unordered_map<std::string, Usage> byTag;
+    std::unordered_map<std::string, std::size_t> byProduct;
+    std::uint64_t rejected = 0;
+    std::uint64_t evicted = 0;
+
+    nlohmann::json toJson() const;
+
+    /**
+     * Publishes TParameter<Long64_t> products tagged "memory":
+     *   <prefix>total_bytes, <prefix>high_water_bytes, <prefix>products,
+     *   <prefix>rejected, <prefix>evicted,
+     *   <prefix>tag/<tag>/bytes, <prefix>tag/<tag>/high_water_bytes
+     */
+    void publish(PipelineDataProductManager& manager, const std::string& prefix = "memory/") const;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+
+#include <TObject.h>
+
+/**
+ * @class ProductMerger
+ * @brief Merge rules used when combining products from several pipelines.
+ *
+ * - Any class with a ROOT Merge(TCollection*) method is merged through it.
+ *   This covers TH1/TH2 (bin-wise sum with axis checks) and TParameter
+ *   (sum by default, or max/min/first/last/multiply per its merge-mode bits).
+ *   Counter and accumulator products follow the same rule.
+ * - Anything else cannot be combined and is replaced by the newer object.
+ */
+class ProductMerger {
+public:
+    // True if `obj` has a ROOT merge function
+    static bool isMergeable(const TObject& obj);
+
+    // Merges `source` into `target`. Returns false if the class is not mergeable.
+    static bool merge(TObject& target, const TObject& source);
+
+    // Detached deep copy suitable as a merge target
+    static std::unique_ptr<TObject> clone(const TObject& obj);
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "analysis_pipeline/core/data/mapped_file.h"
+#include "analysis_pipeline/core/data/pipeline_data_product.h"
+
+/**
+ * Product record file layout (little-endian):
+ *
+ *   file header : char magic[8] = "APPRREC1", uint32 version, uint32 reserved
+ *   frame       : uint64 event_number, uint32 product_count, uint32 frame_size,
+ *                 product_count ProductCodec records (frame_size bytes)
+ *
+ * One frame holds the products captured for one event.
+ */
+namespace product_record_format {
+constexpr char kMagic[8] = {'A', 'P', 'P', 'R', 'R', 'E', 'C', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kFileHeaderSize = 16;
+constexpr std::size_t kFrameHeaderSize = 16;
+}  // namespace product_record_format
+
+/**
+ * @class ProductRecordWriter
+ * @brief Writes per-event frames of encoded products.
+ */
+class ProductRecordWriter {
+public:
+    explicit ProductRecordWriter(const std::string& path);
+
+    // `records` holds product_count concatenated ProductCodec records
+    void writeFrame(std::uint64_t eventNumber, std::uint32_t productCount, const std::string& records);
+
+    std::size_t framesWritten() const noexcept { return framesWritten_; }
+    void flush();
+    void close();
+
+private:
+    std::ofstream out_;
+    std::size_t framesWritten_ = 0;
+};
+
+/**
+ * @class ProductRecordReader
+ * @brief Memory-maps a product record file and decodes frames on demand.
+ */
+class ProductRecordReader {
+public:
+    struct Frame {
+        std::uint64_t eventNumber;
+        std::uint32_t productCount;
+        std::size_t offset;  // offset of the first record
+        std::size_t size;
+    };
+
+    explicit ProductRecordReader(const std::string& path);
+
+    std::size_t size() const noexcept { return frames_.size(); }
+    const Frame& frame(std::size_t index) const { return frames_.at(index); }
+    std::vector<std::unique_ptr<PipelineDataProduct>> readFrame(std::size_t index) const;
+
+private:
+    std::shared_ptr<const MappedFile> file_;
+    std::vector<Frame> frames_;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+class PipelineDataProductManager;
+
+/**
+ * @struct ProductSelection
+ * @brief Products picked by name and by tag, as configured on output stages.
+ *
+ * A product is selected if it is listed in `names` or carries one of `tags`.
+ * An empty selection selects every product.
+ */
+struct ProductSelection {
+    std::vector<std::string> names;
+    std::unordered_set<std::string> tags;
+
+    bool selectsAll() const noexcept { return names.empty() && tags.empty(); }
+
+    // Reads the optional "products" and "tags" arrays from a stage's parameters.
+    // Throws std::runtime_error, prefixed with `owner`, if either is not an array.
+    static ProductSelection fromJson(const nlohmann::json& config, const std::string& owner);
+
+    // Selected products the manager currently holds, each listed once
+    std::vector<std::string> resolve(const PipelineDataProductManager& manager) const;
+
+    bool matches(const std::string& name, const std::unordered_set<std::string>& productTags) const;
+};
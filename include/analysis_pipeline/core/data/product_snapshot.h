@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "analysis_pipeline/core/data/pipeline_data_product.h"
+#include "analysis_pipeline/core/data/product_selection.h"
+#include "analysis_pipeline/core/data/raw_event_buffer.h"
+
+class PipelineDataProductManager;
+
+/**
+ * Snapshot layout (little-endian):
+ *
+ *   header : char magic[8] = "APSNAP01", uint32 version, uint32 product_count,
+ *            uint64 sequence, uint16 source_length, source
+ *   body   : product_count ProductCodec records
+ *
+ * A snapshot carries the full current state of the selected products of one
+ * pipeline process. Receivers combine snapshots from several sources with
+ * ProductMerger; see SnapshotAggregator.
+ */
+namespace product_snapshot_format {
+constexpr char kMagic[8] = {'A', 'P', 'S', 'N', 'A', 'P', '0', '1'};
+constexpr std::uint32_t kVersion = 1;
+}  // namespace product_snapshot_format
+
+struct ProductSnapshot {
+    std::string sourceId;
+    std::uint64_t sequence = 0;
+    std::vector<std::unique_ptr<PipelineDataProduct>> products;
+
+    /**
+     * Encodes the selected products of `manager` (by default, every product).
+     * Each product is read under its own read lock; products without an object
+     * are skipped.
+     */
+    static std::string capture(PipelineDataProductManager& manager,
+                               const std::string& sourceId,
+                               std::uint64_t sequence,
+                               const ProductSelection& selection = {});
+
+    // Throws on a malformed or truncated snapshot
+    static ProductSnapshot decode(ByteView bytes);
+};
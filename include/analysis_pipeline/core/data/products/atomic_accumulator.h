@@ -0,0 +1,75 @@
+#pragma once
+
+#include <TObject.h>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+#include "analysis_pipeline/core/data/products/atomic_shard.h"
+
+class TCollection;
+
+/**
+ * @class AtomicAccumulator
+ * @brief Running count, sum, mean, variance, min and max, updated without a product lock.
+ *
+ * Like AtomicCounter, each thread writes its own cache-line-padded shard.
+ * The statistics are aggregated when read. Streaming writes the aggregated
+ * values, and Merge() combines accumulators.
+ */
+class AtomicAccumulator : public TObject {
+public:
+    AtomicAccumulator() = default;
+    ~AtomicAccumulator() override = default;
+
+    void fill(double x) noexcept;
+
+    struct Summary {
+        Long64_t count = 0;
+        double sum = 0.0;
+        double sumSquares = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+
+        double mean() const noexcept;
+        // Population variance
+        double variance() const noexcept;
+        double stdDev() const noexcept;
+    };
+
+    // Aggregates all shards; concurrent fills may or may not be included
+    Summary summary() const noexcept;
+    Long64_t count() const noexcept { return summary().count; }
+    double mean() const noexcept { return summary().mean(); }
+
+    void reset() noexcept;
+    // Takes over other's statistics in place, so holders of this object see them
+    void assign(const AtomicAccumulator& other) noexcept;
+
+    Long64_t Merge(TCollection* list);
+    void Clear(Option_t* option = "") override { reset(); }
+
+private:
+    struct alignas(atomic_shard::kCacheLine) Shard {
+        std::atomic<Long64_t> count{0};
+        std::atomic<double> sum{0.0};
+        std::atomic<double> sumSquares{0.0};
+        std::atomic<double> min{std::numeric_limits<double>::infinity()};
+        std::atomic<double> max{-std::numeric_limits<double>::infinity()};
+    };
+
+    void absorb(const Summary& summary) noexcept;
+
+    // Aggregated on streaming
+    Long64_t count_ = 0;
+    Double_t sum_ = 0.0;
+    Double_t sumSquares_ = 0.0;
+    Double_t min_ = 0.0;
+    Double_t max_ = 0.0;
+
+    std::array<Shard, atomic_shard::kShards> shards_;  //!
+    std::mutex streamMutex_;                           //!
+
+    ClassDefOverride(AtomicAccumulator, 1);
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <TObject.h>
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#include "analysis_pipeline/core/data/products/atomic_shard.h"
+
+class TCollection;
+
+/**
+ * @class AtomicCounter
+ * @brief Integer counter that many threads can bump without a product lock.
+ *
+ * Increments go to one of several cache-line-padded atomic shards, picked
+ * per thread, and value() sums the shards. Obtain one through
+ * PipelineDataProductManager::getOrCreateCounter() and keep the returned
+ * shared_ptr; add() needs no checkout. Streaming (ROOT files, serializeAll)
+ * writes the aggregated value, and Merge() sums counters.
+ */
+class AtomicCounter : public TObject {
+public:
+    AtomicCounter() = default;
+    ~AtomicCounter() override = default;
+
+    void add(Long64_t n = 1) noexcept {
+        shards_[atomic_shard::current()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // Sum over all shards; concurrent adds may or may not be included
+    Long64_t value() const noexcept;
+    void reset() noexcept;
+    // Takes over other's value in place, so holders of this object see it
+    void assign(const AtomicCounter& other) noexcept;
+
+    Long64_t Merge(TCollection* list);
+    void Clear(Option_t* option = "") override { reset(); }
+
+private:
+    struct alignas(atomic_shard::kCacheLine) Shard {
+        std::atomic<Long64_t> value{0};
+    };
+
+    Long64_t value_ = 0;  // aggregated on streaming
+
+    std::array<Shard, atomic_shard::kShards> shards_;  //!
+    std::mutex streamMutex_;                           //!
+
+    ClassDefOverride(AtomicCounter, 1);
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+namespace atomic_shard {
+
+// Updates from different threads go to different cache lines
+constexpr std::size_t kCacheLine = 64;
+constexpr std::size_t kShards = 16;
+
+// Shard of the calling thread; threads are assigned round-robin on first use
+std::size_t current() noexcept;
+
+}  // namespace atomic_shard
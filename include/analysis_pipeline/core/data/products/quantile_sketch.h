@@ -0,0 +1,83 @@
+#pragma once
+
+#include <TObject.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class TCollection;
+
+/**
+ * @class QuantileSketch
+ * @brief Mergeable KLL quantile sketch over a stream of doubles.
+ *
+ * Memory is bounded by roughly 3k values however many are inserted, and an
+ * insert costs O(1) amortized. Quantile queries are approximate in rank: with
+ * the default k = 200 the rank error is about 1.3% (99% confidence),
+ * independent of the value range. Min and max are tracked exactly.
+ *
+ * Sketches built separately (per thread, per process) combine with merge() or
+ * ROOT's Merge(TCollection*), so ProductMerger and SnapshotAggregator handle
+ * them like histograms. NaN values are ignored.
+ */
+class QuantileSketch : public TObject {
+public:
+    static constexpr std::uint32_t kDefaultK = 200;
+    static constexpr std::uint32_t kMinK = 8;
+
+    QuantileSketch() = default;
+    explicit QuantileSketch(std::uint32_t k);
+    ~QuantileSketch() override = default;
+
+    void insert(double value);
+    void insert(const double* values, std::size_t count);
+
+    // Adds `other`'s stream to this one. Throws std::invalid_argument if k differs.
+    void merge(const QuantileSketch& other);
+    Long64_t Merge(TCollection* list);
+
+    void Clear(Option_t* option = "") override;
+
+    // Value at normalized rank q in [0, 1]. NaN when empty.
+    double quantile(double q) const;
+    std::vector<double> quantiles(const std::vector<double>& qs) const;
+
+    // Approximate fraction of inserted values <= x
+    double cdf(double x) const;
+
+    std::uint32_t k() const noexcept { return k_; }
+    std::uint64_t count() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+    double min() const noexcept { return min_; }
+    double max() const noexcept { return max_; }
+
+    // Values currently retained (the memory bound)
+    std::size_t retained() const noexcept;
+    std::size_t numLevels() const noexcept { return levels_.size(); }
+
+private:
+    struct WeightedValue {
+        double value;
+        std::uint64_t weight;
+    };
+
+    std::size_t levelCapacity(std::size_t level) const noexcept;
+    void compress();
+    void compactLevel(std::size_t level);
+    std::vector<WeightedValue> sortedView() const;
+    bool nextCoin();
+    static std::uint64_t initialCoinState() noexcept;
+
+    std::uint32_t k_ = kDefaultK;
+    std::uint64_t count_ = 0;
+    double min_ = 0.0;
+    double max_ = 0.0;
+
+    // levels_[h] holds values of weight 2^h
+    std::vector<std::vector<double>> levels_;
+
+    std::size_t level0Capacity_ = 0;                    //! refreshed by compress()
+    std::uint64_t coinState_ = initialCoinState();  //! compaction offsets, seeded per instance
+
+    ClassDefOverride(QuantileSketch, 1);
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <TObject.h>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "analysis_pipeline/core/data/raw_event_buffer.h"
+#include "analysis_pipeline/core/data/midas_event_view.h"
+
+/**
+ * @class RawEventProduct
+ * @brief Data product exposing a raw event buffer (optionally MIDAS-formatted) without copying it.
+ *
+ * The product only holds a reference to the buffer; any stage can extend the
+ * buffer's lifetime by taking its own copy of buffer().
+ */
+class RawEventProduct : public TObject {
+public:
+    enum class Format { Raw, Midas };
+
+    RawEventProduct() = default;
+    RawEventProduct(std::shared_ptr<const RawEventBuffer> buffer, Format format);
+    ~RawEventProduct() override = default;
+
+    const std::shared_ptr<const RawEventBuffer>& buffer() const noexcept { return buffer_; }
+    ByteView bytes() const noexcept;
+
+    Format format() const noexcept { return format_; }
+    bool isMidas() const noexcept { return midas_.has_value(); }
+
+    // Throws if the product was not built from a MIDAS event
+    const MidasEventView& midas() const;
+
+    // Shortcut for midas().getBank(name)
+    const MidasBank& getBank(const std::string& name) const;
+
+private:
+    std::shared_ptr<const RawEventBuffer> buffer_;  //! not persisted
+    Format format_ = Format::Raw;                   //!
+    std::optional<MidasEventView> midas_;           //!
+    ULong64_t size_ = 0;
+
+    ClassDefOverride(RawEventProduct, 1);
+};
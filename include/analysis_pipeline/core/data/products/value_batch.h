@@ -0,0 +1,31 @@
+#pragma once
+
+#include <TObject.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class ValueBatch
+ * @brief Data product holding a batch (vector) of doubles produced for one event.
+ */
+class ValueBatch : public TObject {
+public:
+    ValueBatch() = default;
+    explicit ValueBatch(std::vector<double> values) : values_(std::move(values)) {}
+    ~ValueBatch() override = default;
+
+    const std::vector<double>& values() const noexcept { return values_; }
+    std::vector<double>& values() noexcept { return values_; }
+
+    std::size_t size() const noexcept { return values_.size(); }
+    double* data() noexcept { return values_.data(); }
+    const double* data() const noexcept { return values_.data(); }
+
+    // Resizes without shrinking capacity so per-event refills do not reallocate
+    void resize(std::size_t n) { values_.resize(n); }
+
+private:
+    std::vector<double> values_;
+
+    ClassDefOverride(ValueBatch, 1);
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <TH1D.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class WindowedTH1D
+ * @brief TH1D that only holds the fills of a rolling time window.
+ *
+ * The window is a ring of `slices` sub-histograms, each covering
+ * length / slices of time, while the TH1D itself holds their running sum.
+ * When a slice expires it is subtracted from the sum and cleared, which
+ * costs O(bins) and never re-fills anything. Since the TH1D part is the
+ * window, serialization, drawing and export see an ordinary histogram of
+ * the last `length`.
+ *
+ * The window only moves when advance() is called (TH1BuilderStage does this
+ * on every event, whether or not it fills). The slices are transient: a copy read back from a file
+ * treats everything it holds as belonging to the current slice. Merging adds
+ * the windows, so a merged copy shows the combined window at merge time.
+ */
+class WindowedTH1D : public TH1D {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    WindowedTH1D() = default;
+    WindowedTH1D(const char* name, const char* title, Int_t bins, Double_t xmin, Double_t xmax,
+                 std::chrono::milliseconds length, std::uint32_t slices);
+    ~WindowedTH1D() override = default;
+
+    using TH1D::Fill;
+    Int_t Fill(Double_t x) override { return Fill(x, 1.0); }
+    Int_t Fill(Double_t x, Double_t w) override;
+
+    void Reset(Option_t* option = "") override;
+    // Copies the window configuration and slices too; TH1::Clone goes through Copy
+    void Copy(TObject& target) const override;
+
+    // Expires every slice that ended before `now`. The first call anchors the window.
+    void advance(Clock::time_point now);
+    // Expires the `count` oldest slices and starts a new one, independent of the clock
+    void advanceSlices(std::uint32_t count);
+
+    std::chrono::milliseconds windowLength() const noexcept { return std::chrono::milliseconds(lengthMs_); }
+    std::chrono::milliseconds sliceLength() const noexcept;
+    std::uint32_t sliceCount() const noexcept { return sliceCount_; }
+
+private:
+    struct Slice {
+        std::vector<double> content;
+        std::vector<double> sumw2;
+        double entries = 0.0;
+        std::array<double, 4> stats{};  // sumw, sumw2, sumwx, sumwx2 as in TH1::GetStats
+    };
+
+    void ensureSlices();
+    void expireNext();
+
+    Long64_t lengthMs_ = 0;
+    UInt_t sliceCount_ = 0;
+
+    std::vector<Slice> slices_;   //!
+    std::uint32_t current_ = 0;   //!
+    Long64_t sliceStartNs_ = 0;   //! steady-clock start of the current slice, 0 until anchored
+
+    ClassDefOverride(WindowedTH1D, 1);
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class TypedByteView
+ * @brief Non-owning, bounds-checked view of trivially copyable elements stored in a byte range.
+ *
+ * Elements are read with memcpy so the underlying bytes do not need to be aligned for T.
+ */
+template <typename T>
+class TypedByteView {
+    static_assert(std::is_trivially_copyable_v<T>, "TypedByteView requires a trivially copyable type");
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = T;
+
+        const_iterator(const std::uint8_t* pos) : pos_(pos) {}
+        T operator*() const noexcept {
+            T value;
+            std::memcpy(&value, pos_, sizeof(T));
+            return value;
+        }
+        const_iterator& operator++() noexcept { pos_ += sizeof(T); return *this; }
+        const_iterator operator++(int) noexcept { auto copy = *this; pos_ += sizeof(T); return copy; }
+        bool operator==(const const_iterator& other) const noexcept { return pos_ == other.pos_; }
+        bool operator!=(const const_iterator& other) const noexcept { return pos_ != other.pos_; }
+
+    private:
+        const std::uint8_t* pos_;
+    };
+
+    TypedByteView() noexcept = default;
+    TypedByteView(const std::uint8_t* data, std::size_t count) noexcept : data_(data), count_(count) {}
+
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+    const std::uint8_t* bytes() const noexcept { return data_; }
+
+    // Unchecked access
+    T operator[](std::size_t index) const noexcept {
+        T value;
+        std::memcpy(&value, data_ + index * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    // Bounds-checked access
+    T at(std::size_t index) const {
+        if (index >= count_) {
+            throw std::out_of_range("TypedByteView: index " + std::to_string(index) +
+                                    " out of range (size " + std::to_string(count_) + ")");
+        }
+        return (*this)[index];
+    }
+
+    const_iterator begin() const noexcept { return const_iterator(data_); }
+    const_iterator end() const noexcept { return const_iterator(data_ + count_ * sizeof(T)); }
+
+private:
+    const std::uint8_t* data_ = nullptr;
+    std::size_t count_ = 0;
+};
+
+/**
+ * @class ByteView
+ * @brief Non-owning, bounds-checked view over a contiguous byte range.
+ */
+class ByteView {
+public:
+    ByteView() noexcept = default;
+    ByteView(const std::uint8_t* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    const std::uint8_t* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    ByteView subview(std::size_t offset, std::size_t length) const {
+        if (offset > size_ || length > size_ - offset) {
+            throw std::out_of_range("ByteView: range [" + std::to_string(offset) + ", +" +
+                                    std::to_string(length) + ") exceeds size " + std::to_string(size_));
+        }
+        return ByteView(data_ + offset, length);
+    }
+
+    template <typename T>
+    T read(std::size_t offset) const {
+        static_assert(std::is_trivially_copyable_v<T>, "ByteView::read requires a trivially copyable type");
+        ByteView field = subview(offset, sizeof(T));
+        T value;
+        std::memcpy(&value, field.data(), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    TypedByteView<T> as() const {
+        if (size_ % sizeof(T) != 0) {
+            throw std::runtime_error("ByteView: size " + std::to_string(size_) +
+                                     " is not a multiple of element size " + std::to_string(sizeof(T)));
+        }
+        return TypedByteView<T>(data_, size_ / sizeof(T));
+    }
+
+private:
+    const std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @class RawEventBuffer
+ * @brief Immutable, reference-counted block of raw event bytes.
+ *
+ * A buffer is never copied once constructed. Stages share it through
+ * std::shared_ptr and the memory is released when the last holder lets go.
+ */
+class RawEventBuffer {
+public:
+    RawEventBuffer(const RawEventBuffer&) = delete;
+    RawEventBuffer& operator=(const RawEventBuffer&) = delete;
+
+    // Takes ownership of an existing byte vector without copying it
+    static std::shared_ptr<const RawEventBuffer> fromBytes(std::vector<std::uint8_t>&& bytes);
+
+    // Reads a whole file into a new buffer (used for synthetic/test events)
+    static std::shared_ptr<const RawEventBuffer> fromFile(const std::string& path);
+
+    // Wraps memory owned elsewhere; `owner` is kept alive for the lifetime of the buffer
+    static std::shared_ptr<const RawEventBuffer> wrap(const std::uint8_t* data,
+                                                      std::size_t size,
+                                                      std::shared_ptr<const void> owner);
+
+    const std::uint8_t* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    ByteView view() const noexcept { return ByteView(data_, size_); }
+
+private:
+    RawEventBuffer(const std::uint8_t* data, std::size_t size, std::shared_ptr<const void> owner);
+
+    const std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::shared_ptr<const void> owner_;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <nlohmann/json.hpp>
+
+/**
+ * @class RootCompression
+ * @brief Parses compression settings for ROOT file output from stage parameters.
+ *
+ * Accepted forms:
+ *   {"algorithm": "zstd", "level": 5}   algorithm: zlib, lzma, lz4, zstd, or default
+ *   "lz4"                               the algorithm at its default level
+ *   505                                 a raw ROOT setting (100 * algorithm + level)
+ * A level of 0 disables compression.
+ */
+class RootCompression {
+public:
+    // Returns a value for TFile / TBranch SetCompressionSettings. Throws std::runtime_error on bad input.
+    static int fromJson(const nlohmann::json& config);
+
+    // Human-readable form for logging, e.g. "zstd:5"
+    static std::string describe(int settings);
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Shared-memory product segment layout, shared by ShmProductPublisher and
+ * ShmProductReader. Everything is native-endian and only meant for readers on
+ * the same machine.
+ *
+ *   SegmentHeader                  (kHeaderSize bytes)
+ *   slot[0] .. slot[slotCount - 1] (slotStride bytes each)
+ *       SlotHeader, payload[payloadCapacity]
+ *
+ * Each slot is a seqlock with a single writer. The writer makes `sequence`
+ * odd, writes the header fields and payload, then makes it even again. A
+ * reader copies the slot and keeps the copy only if `sequence` was even and
+ * unchanged across the copy. Sequence 0 means the slot was never written.
+ *
+ * Slots are assigned to product names in order. A slot's name is written
+ * before `slotsUsed` is advanced past it and never changes afterwards.
+ */
+namespace shm_product_format {
+
+constexpr char kMagic[8] = {'A', 'P', 'S', 'H', 'M', 'E', 'X', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kNameSize = 128;
+constexpr std::size_t kAlignment = 64;
+
+enum class PayloadFormat : std::uint32_t {
+    Json = 1,  // PipelineDataProduct::serializeToJson() text
+    Root = 2   // one ProductCodec record
+};
+
+struct alignas(kAlignment) SegmentHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t slotCount;
+    std::uint64_t slotStride;
+    std::uint64_t payloadCapacity;
+    std::atomic<std::uint32_t> slotsUsed;
+    std::uint32_t reserved;
+    std::atomic<std::uint64_t> publishCount;  // bumped after every publish cycle
+};
+
+struct alignas(kAlignment) SlotHeader {
+    std::atomic<std::uint64_t> sequence;
+    std::uint32_t format;
+    std::uint32_t payloadSize;
+    std::uint64_t updateCount;
+    std::int64_t timestampNs;  // system_clock, nanoseconds since epoch
+    char name[kNameSize];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "shared-memory seqlock requires lock-free 64-bit atomics");
+
+constexpr std::size_t kHeaderSize = sizeof(SegmentHeader);
+
+constexpr std::size_t slotStride(std::size_t payloadCapacity) {
+    return (sizeof(SlotHeader) + payloadCapacity + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+constexpr std::size_t segmentSize(std::size_t slotCount, std::size_t payloadCapacity) {
+    return kHeaderSize + slotCount * slotStride(payloadCapacity);
+}
+
+}  // namespace shm_product_format
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "analysis_pipeline/core/data/product_selection.h"
+#include "analysis_pipeline/core/data/shm_product_layout.h"
+
+class PipelineDataProduct;
+class PipelineDataProductManager;
+
+/**
+ * @class ShmProductPublisher
+ * @brief Mirrors products into a POSIX shared-memory segment for ShmProductReader.
+ *
+ * There is a single writer, so the publisher is not thread-safe. Each product
+ * name gets its own slot on first publish. Products whose payload is larger
+ * than the slot capacity, or that arrive after every slot is taken, are
+ * skipped and counted.
+ */
+class ShmProductPublisher {
+public:
+    struct Stats {
+        std::uint64_t published = 0;
+        std::uint64_t oversized = 0;
+        std::uint64_t noFreeSlot = 0;
+    };
+
+    // Creates (or recreates) the segment. Throws std::runtime_error on failure.
+    ShmProductPublisher(std::string segmentName,
+                        std::size_t slotCount,
+                        std::size_t payloadCapacity,
+                        bool unlinkOnClose = true);
+    ~ShmProductPublisher();
+
+    ShmProductPublisher(const ShmProductPublisher&) = delete;
+    ShmProductPublisher& operator=(const ShmProductPublisher&) = delete;
+
+    bool publish(const std::string& name, shm_product_format::PayloadFormat format, const std::string& payload);
+    bool publish(const PipelineDataProduct& product, shm_product_format::PayloadFormat format);
+
+    /**
+     * Publishes the selected products. Each product is serialized under its
+     * own read lock. Returns the number of products published.
+     */
+    std::size_t publishFrom(PipelineDataProductManager& manager,
+                            const ProductSelection& selection,
+                            shm_product_format::PayloadFormat format);
+
+    const std::string& segmentName() const { return segmentName_; }
+    const Stats& stats() const { return stats_; }
+
+    // Prepends '/' if missing, as shm_open requires
+    static std::string normalizeName(const std::string& name);
+
+private:
+    shm_product_format::SlotHeader* slotAt(std::size_t index);
+    shm_product_format::SlotHeader* slotFor(const std::string& name);
+
+    std::string segmentName_;
+    bool unlinkOnClose_;
+    std::uint8_t* base_ = nullptr;
+    std::size_t size_ = 0;
+    shm_product_format::SegmentHeader* header_ = nullptr;
+
+    std::unordered_map<std::string, std::size_t> slotIndex_;
+    Stats stats_;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "analysis_pipeline/core/data/shm_product_layout.h"
+
+/**
+ * @class ShmProductReader
+ * @brief Read-only view of a segment written by ShmProductPublisher.
+ *
+ * Meant for external monitors. It needs neither ROOT nor the pipeline, and
+ * after the constructor maps the segment, reads are plain memory copies with
+ * no system calls and no locks shared with the publisher. Any number of
+ * readers may attach to the same segment.
+ *
+ *     ShmProductReader reader("/analysis_pipeline");
+ *     std::uint64_t seen = 0;
+ *     ShmProductReader::Entry entry;
+ *     if (auto slot = reader.find("hist_energy")) {
+ *         if (reader.readIfChanged(*slot, seen, entry)) draw(entry.payload);
+ *     }
+ */
+class ShmProductReader {
+public:
+    struct Entry {
+        std::string name;
+        shm_product_format::PayloadFormat format = shm_product_format::PayloadFormat::Json;
+        std::string payload;
+        std::uint64_t updateCount = 0;
+        std::int64_t timestampNs = 0;
+        std::uint64_t sequence = 0;
+    };
+
+    // Throws std::runtime_error if the segment does not exist or is not a product segment
+    explicit ShmProductReader(const std::string& segmentName);
+    ~ShmProductReader();
+
+    ShmProductReader(const ShmProductReader&) = delete;
+    ShmProductReader& operator=(const ShmProductReader&) = delete;
+
+    // Number of slots assigned so far
+    std::size_t size() const;
+    std::vector<std::string> names() const;
+    std::optional<std::size_t> find(const std::string& name) const;
+
+    // Consistent copy of a slot; empty if never written or the writer kept it busy
+    std::optional<Entry> read(std::size_t slot) const;
+    std::optional<Entry> read(const std::string& name) const;
+
+    // Copies the slot into `out` only if its sequence moved past `lastSequence`, which is then updated
+    bool readIfChanged(std::size_t slot, std::uint64_t& lastSequence, Entry& out) const;
+
+    // Number of publish cycles the publisher completed
+    std::uint64_t publishCount() const;
+
+private:
+    const shm_product_format::SlotHeader* slotAt(std::size_t index) const;
+    bool copySlot(std::size_t index, Entry& out, std::uint64_t skipIfSequence) const;
+
+    const std::uint8_t* base_ = nullptr;
+    std::size_t size_ = 0;
+    const shm_product_format::SegmentHeader* header_ = nullptr;
+};
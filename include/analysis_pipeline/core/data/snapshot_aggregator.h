@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "analysis_pipeline/core/data/product_snapshot.h"
+
+class PipelineDataProductManager;
+
+/**
+ * Unix socket framing shared by SnapshotClient and SnapshotAggregator:
+ * each message is a uint32 length (little-endian) followed by one
+ * ProductSnapshot of that many bytes.
+ */
+namespace snapshot_socket {
+constexpr std::uint32_t kMaxFrameSize = 256u << 20;
+}  // namespace snapshot_socket
+
+/**
+ * @class SnapshotAggregator
+ * @brief Merges product snapshots from several local pipeline processes.
+ *
+ * Listens on a Unix stream socket and keeps the latest snapshot of every
+ * source (identified by the snapshot's source id, so a source may reconnect).
+ * When a snapshot arrives, only the product names it contains are re-merged:
+ * the latest copies from all sources are combined with ProductMerger, in
+ * source id order, and the result is published to the target manager under
+ * the same name with the union of the source tags plus "aggregated".
+ * Non-mergeable products take the most recently received copy.
+ *
+ * Snapshots hold totals rather than deltas, so a source re-sending the same
+ * state is idempotent and a lost snapshot is repaired by the next one. A
+ * source that sends nothing for `sourceTimeout` is dropped and its products
+ * re-merged without it, so the totals of a process that exited or restarted
+ * under a new id (the default "<hostname>:<pid>") are not counted twice.
+ *
+ *     SnapshotAggregator aggregator("/tmp/pipeline.sock", manager);
+ *     aggregator.start();
+ *     // each process: SnapshotClient("/tmp/pipeline.sock", id).send(manager)
+ */
+class SnapshotAggregator {
+public:
+    struct Stats {
+        std::uint64_t snapshotsReceived = 0;
+        std::uint64_t snapshotsRejected = 0;  // malformed or out of sequence
+        std::uint64_t productsMerged = 0;
+        std::uint64_t sourcesExpired = 0;
+        std::size_t sources = 0;
+        std::size_t connections = 0;
+    };
+
+    // A zero `sourceTimeout` keeps sources until removeSource()
+    SnapshotAggregator(std::string socketPath, PipelineDataProductManager& manager,
+                       std::chrono::milliseconds sourceTimeout = std::chrono::seconds(60));
+    ~SnapshotAggregator();
+
+    SnapshotAggregator(const SnapshotAggregator&) = delete;
+    SnapshotAggregator& operator=(const SnapshotAggregator&) = delete;
+
+    // Binds the socket (replacing a stale socket file) and starts the receive thread
+    void start();
+    void stop();
+    bool running() const { return running_.load(std::memory_order_acquire); }
+
+    // Applies a snapshot directly, e.g. for in-process sources. Snapshots with a
+    // sequence not newer than the source's last one are ignored (returns false),
+    // except sequence 1, which marks a restarted source and replaces its state.
+    bool ingest(ProductSnapshot snapshot);
+
+    // Forgets a source and re-merges the products it contributed
+    void removeSource(const std::string& sourceId);
+
+    // Removes sources silent for longer than the timeout; returns how many.
+    // The receive thread calls this itself; in-process users of ingest() may.
+    std::size_t expireSources();
+
+    std::vector<std::string> sources() const;
+    Stats stats() const;
+
+    const std::string& socketPath() const { return socketPath_; }
+
+private:
+    struct SourceState {
+        std::uint64_t sequence = 0;
+        std::chrono::steady_clock::time_point lastSeen;
+        std::map<std::string, std::unique_ptr<PipelineDataProduct>> products;
+        std::map<std::string, std::uint64_t> receivedAt;  // arrival order per product
+    };
+
+    struct Connection {
+        int fd = -1;
+        std::string buffer;
+    };
+
+    void run();
+    bool readFrom(Connection& connection);
+    void removeSourceLocked(std::map<std::string, SourceState>::iterator it);
+    void remergeLocked(const std::string& name);
+
+    std::string socketPath_;
+    PipelineDataProductManager& manager_;
+    std::chrono::milliseconds sourceTimeout_;
+
+    int listenFd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<std::size_t> connectionCount_{0};
+
+    mutable std::mutex mutex_;
+    std::map<std::string, SourceState> sources_;
+    std::uint64_t arrivals_ = 0;
+    Stats stats_;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "analysis_pipeline/core/data/product_selection.h"
+
+class PipelineDataProductManager;
+
+/**
+ * @class SnapshotClient
+ * @brief Sends product snapshots to a SnapshotAggregator over a Unix socket.
+ *
+ * Connects lazily and reconnects on the next send after a failure, so a
+ * pipeline keeps running while the aggregator is down. Not thread-safe.
+ */
+class SnapshotClient {
+public:
+    SnapshotClient(std::string socketPath, std::string sourceId);
+    ~SnapshotClient();
+
+    SnapshotClient(const SnapshotClient&) = delete;
+    SnapshotClient& operator=(const SnapshotClient&) = delete;
+
+    // Captures and sends a snapshot (see ProductSnapshot::capture). Returns false if it could not be delivered.
+    bool send(PipelineDataProductManager& manager, const ProductSelection& selection = {});
+
+    // Sends an already encoded snapshot
+    bool sendEncoded(const std::string& snapshot);
+
+    void disconnect();
+
+    const std::string& sourceId() const { return sourceId_; }
+    // Sequence number of the last delivered snapshot, i.e. the number delivered
+    std::uint64_t sequence() const { return sequence_; }
+
+    // "<hostname>:<pid>", the default source id for a process
+    static std::string defaultSourceId();
+
+private:
+    bool connect();
+
+    std::string socketPath_;
+    std::string sourceId_;
+    std::uint64_t sequence_ = 0;
+    int fd_ = -1;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @class NumaTopology
+ * @brief CPU and NUMA node layout of the machine, read from sysfs.
+ *
+ * Only CPUs in the process's affinity mask are listed, so the topology
+ * respects taskset/cgroup restrictions. Without NUMA information (or
+ * off Linux) every usable CPU is placed on node 0.
+ */
+class NumaTopology {
+public:
+    struct Node {
+        int id = 0;
+        std::vector<int> cpus;
+    };
+
+    static NumaTopology detect();
+
+    // Builds a topology directly, e.g. for tests or to override detection
+    explicit NumaTopology(std::vector<Node> nodes);
+
+    const std::vector<Node>& nodes() const noexcept { return nodes_; }
+    std::size_t nodeCount() const noexcept { return nodes_.size(); }
+    std::vector<int> allCpus() const;
+
+    // Node id of `cpu`, or -1 if the CPU is unknown
+    int nodeOfCpu(int cpu) const;
+    const Node* node(int id) const;
+
+    // Parses the sysfs cpulist format, e.g. "0-3,8,10-11"
+    static std::vector<int> parseCpuList(const std::string& list);
+
+private:
+    std::vector<Node> nodes_;
+};
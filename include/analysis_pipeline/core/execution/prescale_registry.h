@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class PrescaleGroup
+ * @brief Shared prescale factor for the stages that may be shed under load.
+ *
+ * Stages join a group with the "shed_group" parameter and run on one event
+ * in factor(). AdaptivePrescaleStage raises and lowers the factor; reading it
+ * costs one relaxed atomic load per event. With one controller per worker
+ * chain, adjust() lets only one of them move the factor per interval.
+ */
+class PrescaleGroup {
+public:
+    explicit PrescaleGroup(std::string name) : name_(std::move(name)) {}
+
+    const std::string& name() const noexcept { return name_; }
+
+    std::uint32_t factor() const noexcept { return factor_.load(std::memory_order_relaxed); }
+    void setFactor(std::uint32_t factor) noexcept {
+        factor_.store(factor < 1 ? 1 : factor, std::memory_order_relaxed);
+    }
+
+    // Changes the factor from `expected` to `factor` unless another caller
+    // adjusted it less than `interval` ago. Returns false if it lost that race.
+    bool adjust(std::uint32_t expected, std::uint32_t factor,
+                std::chrono::steady_clock::time_point now,
+                std::chrono::steady_clock::duration interval) noexcept;
+
+private:
+    std::string name_;
+    std::atomic<std::uint32_t> factor_{1};
+    std::atomic<std::chrono::steady_clock::rep> lastAdjust_{0};  // steady_clock ticks
+};
+
+/**
+ * @class PrescaleRegistry
+ * @brief Process-wide lookup of prescale groups by name.
+ *
+ * Groups are created on first use and live for the whole process, so the
+ * returned references stay valid.
+ */
+class PrescaleRegistry {
+public:
+    static PrescaleRegistry& instance();
+
+    PrescaleGroup& group(const std::string& name);
+
+    // Current factor of every group, e.g. for recording with results
+    std::vector<std::pair<std::string, std::uint32_t>> factors() const;
+
+private:
+    PrescaleRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<PrescaleGroup>> groups_;
+};
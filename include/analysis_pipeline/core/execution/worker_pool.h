@@ -0,0 +1,138 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "analysis_pipeline/core/execution/numa_topology.h"
+
+class BaseStage;
+
+// How WorkerPool places its threads on CPUs
+enum class PlacementPolicy {
+    None,     // no pinning; the OS scheduler decides
+    Compact,  // fill the CPUs of one node before moving to the next
+    Scatter,  // round-robin across nodes
+    Explicit  // use the `cpus` list in order
+};
+
+struct WorkerPoolConfig {
+    std::size_t threads = 0;  // 0 = one per usable CPU (after the node filter)
+    PlacementPolicy placement = PlacementPolicy::None;
+    std::vector<int> cpus;    // Explicit placement
+    std::vector<int> nodes;   // restrict Compact/Scatter to these NUMA nodes (empty = all)
+
+    /**
+     * Reads
+     *   {"threads": N, "placement": "none" | "compact" | "scatter" | "explicit",
+     *    "cpus": [0, 2, 4], "nodes": [0]}
+     */
+    static WorkerPoolConfig fromJson(const nlohmann::json& config);
+};
+
+/**
+ * @class WorkerPool
+ * @brief Fixed set of (optionally pinned) threads with one task queue per worker.
+ *
+ * Tasks are submitted to a specific worker so a pipeline instance, and the
+ * products it owns, stay on one CPU and NUMA node. Memory the worker touches
+ * first is placed on its node by the kernel's first-touch policy;
+ * construct() and WorkerLocal use this for per-worker products and histogram
+ * shards.
+ *
+ *     WorkerPool pool(WorkerPoolConfig::fromJson(config["workers"]));
+ *     // one stage chain per worker
+ *     pool.runOnAll([&](std::size_t w) { for (auto* s : chains[w]) s->Process(); });
+ */
+class WorkerPool {
+public:
+    explicit WorkerPool(const WorkerPoolConfig& config,
+                        const NumaTopology& topology = NumaTopology::detect());
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    std::size_t size() const noexcept { return workers_.size(); }
+
+    // CPU the worker is pinned to (-1 if unpinned) and that CPU's NUMA node (-1 if unknown)
+    int cpuOf(std::size_t worker) const { return workers_.at(worker)->cpu; }
+    int nodeOf(std::size_t worker) const { return workers_.at(worker)->node; }
+
+    std::future<void> submit(std::size_t worker, std::function<void()> task);
+
+    // Runs `task(worker)` on every worker and waits; rethrows the first exception
+    void runOnAll(const std::function<void(std::size_t)>& task);
+
+    // Runs the stages in order on `worker` via BaseStage::Execute()
+    std::future<void> runStages(std::size_t worker, std::vector<BaseStage*> stages);
+
+    // Constructs a T on `worker`, so its memory is first touched from that worker's node
+    template <typename T, typename... Args>
+    std::unique_ptr<T> construct(std::size_t worker, Args&&... args) {
+        std::unique_ptr<T> result;
+        submit(worker, [&] { result = std::make_unique<T>(std::forward<Args>(args)...); }).get();
+        return result;
+    }
+
+    // Index of the calling worker in its pool, or -1 on a non-worker thread
+    static int currentWorker() noexcept;
+
+    // CPU list each worker would get for `config`; -1 means unpinned
+    static std::vector<int> planPlacement(const WorkerPoolConfig& config, const NumaTopology& topology);
+
+private:
+    struct Worker {
+        int cpu = -1;
+        int node = -1;
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::packaged_task<void()>> tasks;
+        bool stopping = false;
+    };
+
+    void run(std::size_t index);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+/**
+ * @class WorkerLocal
+ * @brief One T per worker, each constructed on its own worker (and node).
+ *
+ * Typical use is per-worker histogram shards. Each worker fills its own copy
+ * with no sharing, and the copies are merged at publish time. Each instance
+ * is a separate allocation, so shards never share a cache line.
+ */
+template <typename T>
+class WorkerLocal {
+public:
+    // `factory(worker)` returns std::unique_ptr<T> and runs on that worker
+    template <typename Factory>
+    WorkerLocal(WorkerPool& pool, Factory factory) {
+        instances_.resize(pool.size());
+        pool.runOnAll([&](std::size_t worker) { instances_[worker] = factory(worker); });
+    }
+
+    // Instance of the calling worker; must be called from a worker of the owning pool
+    T& local() { return *instances_.at(static_cast<std::size_t>(WorkerPool::currentWorker())); }
+
+    T& operator[](std::size_t worker) { return *instances_.at(worker); }
+    std::size_t size() const noexcept { return instances_.size(); }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        for (auto& instance : instances_) fn(*instance);
+    }
+
+private:
+    std::vector<std::unique_ptr<T>> instances_;
+};
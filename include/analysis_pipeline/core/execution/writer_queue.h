@@ -0,0 +1,137 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ * @class WriterQueue
+ * @brief Bounded queue feeding one dedicated I/O thread.
+ *
+ * Output stages hand finished items (snapshots, blocks of rows) to push() on
+ * the event loop; the thread passes each one to the write callback, so
+ * compression and disk writes never run on a worker. When the queue is full,
+ * push() either waits or hands the item back to the caller to be dropped.
+ *
+ * stop() lets the thread drain what is already queued, then runs the
+ * optional finish callback on that thread and joins it, so an end-of-run
+ * item pushed with wait = true is always written. The destructor stops too.
+ *
+ * Callbacks run on the I/O thread and handle their own errors.
+ */
+template <typename Item>
+class WriterQueue {
+public:
+    // May move the item out, e.g. to recycle it
+    using WriteFn = std::function<void(std::unique_ptr<Item>&)>;
+    using FinishFn = std::function<void()>;
+
+    WriterQueue() = default;
+    ~WriterQueue() { stop(); }
+
+    WriterQueue(const WriterQueue&) = delete;
+    WriterQueue& operator=(const WriterQueue&) = delete;
+
+    // Stops a running thread first
+    void start(std::size_t capacity, WriteFn write, FinishFn finish = {}) {
+        stop();
+        capacity_ = capacity;
+        write_ = std::move(write);
+        finish_ = std::move(finish);
+        stopping_ = false;
+        thread_ = std::thread(&WriterQueue::run, this);
+    }
+
+    // Returns nullptr once queued. With the queue full and wait false, the
+    // item is returned to the caller instead. Time spent waiting is added to
+    // *waitedMicros when given.
+    std::unique_ptr<Item> push(std::unique_ptr<Item> item, bool wait, std::uint64_t* waitedMicros = nullptr) {
+        {
+            std::unique_lock lock(mutex_);
+            if (queue_.size() >= capacity_) {
+                if (!wait) return item;
+                auto start = std::chrono::steady_clock::now();
+                cv_.wait(lock, [this] { return queue_.size() < capacity_ || stopping_; });
+                if (waitedMicros) {
+                    *waitedMicros += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start).count());
+                }
+            }
+            queue_.push_back(std::move(item));
+        }
+        cv_.notify_all();
+        return nullptr;
+    }
+
+    std::size_t depth() const {
+        std::lock_guard lock(mutex_);
+        return queue_.size();
+    }
+
+    bool running() const noexcept { return thread_.joinable(); }
+
+    void stop() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+private:
+    void run() {
+        std::unique_lock lock(mutex_);
+        for (;;) {
+            cv_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+            // Drain what is queued before honouring a stop, so the end-of-run item is written
+            if (queue_.empty()) break;
+
+            auto item = std::move(queue_.front());
+            queue_.pop_front();
+            lock.unlock();
+            cv_.notify_all();
+
+            write_(item);
+            item.reset();
+            lock.lock();
+        }
+        lock.unlock();
+
+        if (finish_) finish_();
+    }
+
+    std::size_t capacity_ = 1;
+    WriteFn write_;
+    FinishFn finish_;
+
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::unique_ptr<Item>> queue_;
+    bool stopping_ = false;
+};
+
+/**
+ * Output files are written to "<path>.tmp" and moved into place by
+ * commitTemporaryFile() once complete, so readers never see a partial file.
+ */
+inline std::string temporaryFilePath(const std::string& path) {
+    return path + ".tmp";
+}
+
+inline void commitTemporaryFile(const std::string& path) {
+    // rename() replaces a previous file atomically on the same filesystem
+    std::filesystem::rename(temporaryFilePath(path), path);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "analysis_pipeline/core/data/member_accessor.h"
+
+class PipelineDataProductManager;
+
+// Syntax error, with the offending position in the source
+class ExpressionError : public std::runtime_error {
+public:
+    ExpressionError(const std::string& message, std::size_t position)
+        : std::runtime_error(message), position_(position) {}
+    std::size_t position() const noexcept { return position_; }
+
+private:
+    std::size_t position_;
+};
+
+// A referenced product is missing at evaluation time
+class MissingProductError : public std::runtime_error {
+public:
+    explicit MissingProductError(const std::string& product)
+        : std::runtime_error("product '" + product + "' not found"), product_(product) {}
+    const std::string& product() const noexcept { return product_; }
+
+private:
+    std::string product_;
+};
+
+/**
+ * @class Expression
+ * @brief Numeric/boolean expression over product members, compiled once and evaluated per event.
+ *
+ * Grammar (C precedence, lowest first):
+ *   ||  &&  == !=  < <= > >=  + -  * / %  unary ! -
+ * with `and`, `or`, `not`, `true` and `false` accepted as keywords. Operands are:
+ *   - numbers
+ *   - `product.member`, i.e. a numeric data member of a product
+ *   - `product` alone, shorthand for `product.fVal` (TParameter)
+ *   - `abs(x)`, `sqrt(x)`, `min(x, y)`, `max(x, y)`
+ *   - `exists(product)`, which is 1 if the product is present
+ *
+ * Compilation folds constant subexpressions. It stores the tree as a flat
+ * node array and deduplicates member references into cached MemberAccessors.
+ * Evaluation reads each referenced member at most once per call. && and ||
+ * short-circuit, so the right-hand side's products are only read when needed.
+ * Comparisons and logical operators yield 1 or 0.
+ */
+class Expression {
+public:
+    // Throws ExpressionError on syntax errors
+    static Expression compile(const std::string& source);
+
+    // Throws MissingProductError if a product it needs is absent
+    double evaluate(PipelineDataProductManager& manager);
+    bool test(PipelineDataProductManager& manager) { return evaluate(manager) != 0.0; }
+
+    const std::string& source() const noexcept { return source_; }
+    bool isConstant() const noexcept;
+    std::size_t nodeCount() const noexcept { return nodes_.size(); }
+
+    // Distinct products the expression may read
+    std::vector<std::string> productNames() const;
+
+private:
+    friend class ExpressionParser;
+
+    enum class Op : std::uint8_t {
+        Const, Var, Exists,
+        Neg, Not, Bool, Abs, Sqrt,
+        Add, Sub, Mul, Div, Mod, Min, Max,
+        Lt, Le, Gt, Ge, Eq, Ne,
+        And, Or
+    };
+
+    struct Node {
+        Op op = Op::Const;
+        std::int32_t a = -1;  // first operand node, or variable / exists-name index
+        std::int32_t b = -1;  // second operand node
+        double value = 0.0;   // Const
+    };
+
+    Expression() = default;
+
+    void compact();
+    static double apply(Op op, double x, double y);
+    double eval(std::int32_t index, PipelineDataProductManager& manager);
+    double variable(std::int32_t index, PipelineDataProductManager& manager);
+
+    std::string source_;
+    std::vector<Node> nodes_;
+    std::int32_t root_ = -1;
+    std::vector<MemberAccessor> variables_;
+    std::vector<std::string> existsNames_;
+
+    // Per-evaluation value cache: variable i is valid while stamps_[i] == generation_
+    std::vector<double> values_;
+    std::vector<std::uint64_t> stamps_;
+    std::uint64_t generation_ = 0;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "analysis_pipeline/core/random/xoshiro256pp.h"
+
+/**
+ * @class SampleDistribution
+ * @brief Portable sampling of common distributions from a Xoshiro256PlusPlus stream.
+ *
+ * Unlike the std:: distributions, the algorithms here are fixed, so a given
+ * (seed, stream) produces identical values with every compiler and standard library.
+ *
+ * Configuration (fromJson):
+ *   {"type": "uniform",     "min": 0, "max": 1}
+ *   {"type": "gaussian",    "mean": 0, "sigma": 1}
+ *   {"type": "exponential", "lambda": 1}
+ *   {"type": "poisson",     "mean": 1}
+ *   {"type": "histogram",   "edges": [e0, ..., eN], "weights": [w1, ..., wN]}
+ *   {"type": "histogram",   "min": a, "max": b, "weights": [w1, ..., wN]}   (equal-width bins)
+ */
+class SampleDistribution {
+public:
+    enum class Type { Uniform, Gaussian, Exponential, Poisson, Histogram };
+
+    static SampleDistribution fromJson(const nlohmann::json& config);
+
+    static SampleDistribution uniform(double min, double max);
+    static SampleDistribution gaussian(double mean, double sigma);
+    static SampleDistribution exponential(double lambda);
+    static SampleDistribution poisson(double mean);
+    static SampleDistribution histogram(std::vector<double> edges, const std::vector<double>& weights);
+
+    Type type() const noexcept { return type_; }
+    std::string typeName() const;
+
+    double sample(Xoshiro256PlusPlus& rng);
+
+    // Fills out[0..n) with independent samples; the distribution switch is hoisted out of the loop
+    void fill(Xoshiro256PlusPlus& rng, double* out, std::size_t n);
+
+private:
+    SampleDistribution() = default;
+
+    double sampleGaussian(Xoshiro256PlusPlus& rng);
+    double samplePoisson(Xoshiro256PlusPlus& rng) const;
+    double sampleHistogram(Xoshiro256PlusPlus& rng) const;
+
+    Type type_ = Type::Uniform;
+    double a_ = 0.0;  // min / mean / lambda depending on type
+    double b_ = 1.0;  // max / sigma
+
+    // Gaussian: the polar method produces pairs, the second one is cached here
+    bool hasSpare_ = false;
+    double spare_ = 0.0;
+
+    // Poisson: precomputed constants (Knuth for small means, PTRS otherwise)
+    double expMinusMean_ = 0.0;
+    double logMean_ = 0.0;
+    double ptrsA_ = 0.0, ptrsB_ = 0.0, ptrsInvAlpha_ = 0.0, ptrsVr_ = 0.0;
+
+    // Histogram: bin edges and normalized cumulative weights
+    std::vector<double> edges_;
+    std::vector<double> cumulative_;
+};
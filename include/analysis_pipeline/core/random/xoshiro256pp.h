@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class Xoshiro256PlusPlus
+ * @brief xoshiro256++ generator (Blackman & Vigna) with jump-ahead for independent streams.
+ *
+ * Satisfies UniformRandomBitGenerator. Stream n of a seed is the seeded state
+ * advanced by n jumps of 2^128 draws, so streams never overlap in practice and
+ * the same (seed, stream) pair always reproduces the same sequence.
+ */
+class Xoshiro256PlusPlus {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256PlusPlus(std::uint64_t seed = 0, std::uint64_t stream = 0) {
+        this->seed(seed, stream);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0) {
+        // Expand the 64-bit seed with SplitMix64 as recommended by the authors
+        std::uint64_t x = seed;
+        for (auto& word : s_) {
+            std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+        for (std::uint64_t i = 0; i < stream; ++i) jump();
+    }
+
+    result_type operator()() noexcept {
+        const std::uint64_t result = rotl(s_[0] + s_[3], 23) + s_[0];
+        const std::uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    // Uniform double in [0, 1) using the top 53 bits
+    double uniform() noexcept {
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    // Equivalent to 2^128 calls; used to derive non-overlapping streams
+    void jump() noexcept {
+        static constexpr std::uint64_t kJump[] = {
+            0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        applyJump(kJump);
+    }
+
+    // Equivalent to 2^192 calls
+    void longJump() noexcept {
+        static constexpr std::uint64_t kLongJump[] = {
+            0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+        applyJump(kLongJump);
+    }
+
+private:
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    void applyJump(const std::uint64_t (&polynomial)[4]) noexcept {
+        std::uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (std::uint64_t word : polynomial) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (std::uint64_t{1} << b)) {
+                    s0 ^= s_[0];
+                    s1 ^= s_[1];
+                    s2 ^= s_[2];
+                    s3 ^= s_[3];
+                }
+                (*this)();
+            }
+        }
+        s_[0] = s0;
+        s_[1] = s1;
+        s_[2] = s2;
+        s_[3] = s3;
+    }
+
+    std::uint64_t s_[4] = {};
+};
@@ -10,5 +10,28 @@
 #pragma link C++ class RandomDataGeneratorStage+;
 #pragma link C++ class TH1BuilderStage+;
 #pragma link C++ class ClearProductsStage+;
+#pragma link C++ class RawEventInputStage+;
+#pragma link C++ class EventReplayInputStage+;
+#pragma link C++ class ProductReplayInputStage+;
+#pragma link C++ class ProductRecorderStage+;
+#pragma link C++ class SyntheticLoadGeneratorStage+;
+#pragma link C++ class SnapshotSenderStage+;
+#pragma link C++ class SharedMemoryExportStage+;
+#pragma link C++ class RootFileOutputStage+;
+#pragma link C++ class MemoryAccountingStage+;
+#pragma link C++ class ExpressionFilterStage+;
+#pragma link C++ class QuantileSketchStage+;
+#pragma link C++ class AdaptivePrescaleStage+;
+#pragma link C++ class TTreeInputStage+;
+#pragma link C++ class TTreeOutputStage+;
+#pragma link C++ class CheckpointStage+;
+
+// Data product types
+#pragma link C++ class RawEventProduct+;
+#pragma link C++ class ValueBatch+;
+#pragma link C++ class QuantileSketch+;
+#pragma link C++ class WindowedTH1D+;
+#pragma link C++ class AtomicCounter-;      // custom streamer
+#pragma link C++ class AtomicAccumulator-;  // custom streamer
 
 #endif
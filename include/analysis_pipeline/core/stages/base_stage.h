@@ -2,10 +2,14 @@
 #define ANALYSIS_PIPELINE_STAGES_BASESTAGE_H
 
 #include <TObject.h>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include "analysis_pipeline/core/data/pipeline_data_product_manager.h"  // include manager
+#include "analysis_pipeline/core/context/event_context.h"
+
+class PrescaleGroup;
 
 class BaseStage : public TObject {
 public:
@@ -19,19 +23,56 @@ public:
     virtual void Process() = 0;
     virtual std::string Name() const = 0;
 
+    // End of run. Frameworks call this on every stage before destroying the
+    // data product manager; stages that buffer output flush it here rather
+    // than in their destructor, when the manager may already be gone.
+    virtual void Finish() {}
+
+    // Runs Process() unless an earlier stage rejected `event` or the stage is
+    // prescaled away for it. Returns whether Process() ran. Each chain of
+    // stages running concurrently needs its own context.
+    bool Execute(EventContext& event);
+    // Same, with a context owned by the calling thread
+    bool Execute();
+
+    // Current 1-in-N factor: the larger of the "prescale" parameter and the
+    // factor of the stage's "shed_group" (see PrescaleGroup)
+    std::uint32_t EffectivePrescale() const;
+
+    // True for stages that begin a new event; Execute() begins a new
+    // EventContext before running them.
+    virtual bool StartsEvent() const { return false; }
+
+    // True for stages that must run even on rejected events (bookkeeping,
+    // cleanup). Defaults to the "always_run" parameter.
+    virtual bool RunsOnRejectedEvents() const { return alwaysRun_; }
+
 protected:
     virtual void OnInit() {}
 
+    // Event selection, only valid inside Process(). A rejected event skips
+    // the remaining stages until the next one starts (see StartsEvent).
+    void RejectEvent();
+    const EventContext& CurrentEvent() const;
+
     // Instead of direct map access, expose manager pointer to derived classes if needed
     PipelineDataProductManager* getDataProductManager() const { return dataProductManager_; }
 
     nlohmann::json parameters_;
 
 private:
+    std::string prescaleProductName();
+
     // Pointer to shared manager (owned by Pipeline)
     PipelineDataProductManager* dataProductManager_ = nullptr;
 
-    ClassDef(BaseStage, 2)  // Increment version due to interface change
+    bool alwaysRun_ = false;
+    std::uint32_t prescale_ = 1;
+    PrescaleGroup* shedGroup_ = nullptr;  //!
+    std::uint64_t prescaleCounter_ = 0;   //!
+    std::string prescaleProduct_;         //! where the static prescale is recorded
+
+    ClassDef(BaseStage, 4)
 };
 
 #endif // ANALYSIS_PIPELINE_STAGES_BASESTAGE_H
\ No newline at end of file
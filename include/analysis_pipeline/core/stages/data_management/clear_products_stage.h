@@ -14,6 +14,9 @@ public:
     void Process() override;
     std::string Name() const override { return "ClearProductsStage"; }
 
+    // Per-event products must be cleared whether or not the event passed
+    bool RunsOnRejectedEvents() const override { return true; }
+
 protected:
     void OnInit() override;
 
@@ -0,0 +1,41 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_MEMORYACCOUNTINGSTAGE_H
+#define ANALYSIS_PIPELINE_STAGES_MEMORYACCOUNTINGSTAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * Applies memory limits to the data product manager and periodically exports
+ * its memory usage as products tagged "memory" (see MemoryUsageReport::publish).
+ *
+ * Parameters:
+ *   limits          MemoryLimitConfig, e.g.
+ *                   {"max_bytes": 2000000000, "policy": "evict_lru",
+ *                    "evictable_tags": ["per_event"], "tag_limits": {"histogram": 500000000}}
+ *   every_n_events  refresh and publish every N events (default 1000)
+ *   refresh         re-estimate product sizes before publishing (default true)
+ *   prefix          product name prefix (default "memory/")
+ */
+class MemoryAccountingStage : public BaseStage {
+public:
+    MemoryAccountingStage() = default;
+    ~MemoryAccountingStage() override = default;
+
+    void Process() override;
+    std::string Name() const override { return "MemoryAccountingStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+    std::uint64_t everyNEvents_ = 1000;
+    bool refresh_ = true;
+    std::string prefix_ = "memory/";
+
+    std::uint64_t eventsSeen_ = 0;
+
+    ClassDefOverride(MemoryAccountingStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_MEMORYACCOUNTINGSTAGE_H
@@ -0,0 +1,71 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_ADAPTIVEPRESCALESTAGE_H
+#define ANALYSIS_PIPELINE_STAGES_ADAPTIVEPRESCALESTAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+class PrescaleGroup;
+
+/**
+ * Load shedding: adjusts the prescale factor of a PrescaleGroup so the
+ * pipeline keeps up with its input. Place it last in the chain. It runs on
+ * rejected events too and measures each event's latency from the
+ * event-starting stage. Stages opt in with "shed_group".
+ *
+ * Every interval the factor doubles if the mean event latency exceeds the
+ * budget for target_rate_hz, or the ingest queue is fuller than
+ * max_queue_fill. It halves once both are comfortably below target again.
+ * With one instance per worker chain, the group still moves at most one
+ * step per interval: the first instance to decide a change applies it.
+ * The factor is published as "<prefix><group>" (TParameter<Long64_t>,
+ * tagged "prescale") whenever it changes.
+ *
+ * Parameters:
+ *   group           prescale group to control (default "monitoring")
+ *   target_rate_hz  events per second to sustain (0 disables, default 0)
+ *   max_queue_fill  ingest queue fill fraction to stay under, read from the
+ *                   "<queue_prefix>occupancy"/"capacity" products (0 disables, default 0)
+ *   queue_prefix    prefix of the IngestQueueStats products (default "ingest_queue/")
+ *   interval_ms     control period (default 1000)
+ *   max_prescale    upper bound on the factor, 1 to 2^32-1 (default 1024)
+ *   hysteresis      fraction below target required before relaxing (default 0.2)
+ *   prefix          product name prefix (default "prescale/")
+ */
+class AdaptivePrescaleStage : public BaseStage {
+public:
+    AdaptivePrescaleStage() = default;
+    ~AdaptivePrescaleStage() override = default;
+
+    void Process() override;
+    std::string Name() const override { return "AdaptivePrescaleStage"; }
+
+    bool RunsOnRejectedEvents() const override { return true; }
+
+protected:
+    void OnInit() override;
+
+private:
+    double queueFill() const;
+    void update(std::chrono::steady_clock::time_point now);
+    void publish(std::uint32_t factor);
+
+    std::string groupName_;
+    double targetRateHz_ = 0.0;
+    double maxQueueFill_ = 0.0;
+    std::string queuePrefix_;
+    std::chrono::milliseconds interval_{1000};
+    std::uint32_t maxPrescale_ = 1024;
+    double hysteresis_ = 0.2;
+    std::string prefix_;
+
+    PrescaleGroup* group_ = nullptr;                          //!
+    std::chrono::steady_clock::time_point windowStart_;       //!
+    std::chrono::steady_clock::duration latencySum_{};        //!
+    std::uint64_t windowEvents_ = 0;
+
+    ClassDefOverride(AdaptivePrescaleStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_ADAPTIVEPRESCALESTAGE_H
@@ -0,0 +1,45 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_EXPRESSIONFILTERSTAGE_H
+#define ANALYSIS_PIPELINE_STAGES_EXPRESSIONFILTERSTAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/expression/expression.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Event selection from a configured expression (see Expression). Events for
+ * which it is false are rejected, and BaseStage::Execute() skips the
+ * downstream stages for the rest of the event.
+ *
+ * Parameters:
+ *   expression  selection, e.g. "energy.value > 5 && nhits < 100" (required)
+ *   on_missing  what to do when a referenced product is absent:
+ *               "reject" (default), "pass" or "error" (throw)
+ *   invert      reject events that pass the expression instead (default false)
+ */
+class ExpressionFilterStage : public BaseStage {
+public:
+    ExpressionFilterStage() = default;
+    ~ExpressionFilterStage() override;
+
+    void Process() override;
+    std::string Name() const override { return "ExpressionFilterStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+    enum class MissingPolicy { Reject, Pass, Error };
+
+    std::unique_ptr<Expression> expression_;  //!
+    MissingPolicy onMissing_ = MissingPolicy::Reject;  //!
+    bool invert_ = false;
+
+    std::uint64_t passed_ = 0;
+    std::uint64_t rejected_ = 0;
+
+    ClassDefOverride(ExpressionFilterStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_EXPRESSIONFILTERSTAGE_H
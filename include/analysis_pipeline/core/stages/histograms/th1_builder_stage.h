@@ -2,21 +2,26 @@
 #define ANALYSIS_PIPELINE_STAGES_TH1_BUILDER_STAGE_H
 
 #include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/data/double_buffered_histogram.h"
+#include <memory>
 #include <string>
 #include <TH1D.h>
 
 class TH1BuilderStage : public BaseStage {
 public:
     TH1BuilderStage() = default;
-    ~TH1BuilderStage() override = default;
+    ~TH1BuilderStage() override;
 
     void Process() override;
+    void Finish() override;
     std::string Name() const override { return "TH1BuilderStage"; }
 
 protected:
     void OnInit() override;
 
 private:
+    bool readValue(double& value);
+
     std::string inputProductName_;
     std::string histogramName_;
     std::string valueKey_;
@@ -25,7 +30,14 @@ private:
     double min_ = 0.0;
     double max_ = 1.0;
 
-    ClassDefOverride(TH1BuilderStage, 1);
+    // Set when "window" is configured: the product is a WindowedTH1D
+    long long windowMs_ = 0;
+    unsigned windowSlices_ = 0;
+
+    // Set when "double_buffer" is configured: fills bypass the product lock
+    std::shared_ptr<DoubleBufferedHistogram> doubleBuffer_;  //!
+
+    ClassDefOverride(TH1BuilderStage, 2);
 };
 
 #endif // ANALYSIS_PIPELINE_STAGES_TH1_BUILDER_STAGE_H
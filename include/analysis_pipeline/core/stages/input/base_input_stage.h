@@ -12,6 +12,9 @@ public:
     // Receives externally injected input as InputBundle reference.
     virtual void SetInput(const InputBundle& input) = 0;
 
+    // Each input stage run begins a new event
+    bool StartsEvent() const override { return true; }
+
     ClassDefOverride(BaseInputStage, 2);
 };
 
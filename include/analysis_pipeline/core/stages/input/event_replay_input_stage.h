@@ -0,0 +1,69 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_EVENT_REPLAY_INPUT_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_EVENT_REPLAY_INPUT_STAGE_H
+
+#include "analysis_pipeline/core/stages/input/base_input_stage.h"
+#include "analysis_pipeline/core/data/event_record_file.h"
+#include "analysis_pipeline/core/data/products/raw_event_product.h"
+#include <chrono>
+#include <memory>
+#include <string>
+
+/**
+ * Replays a recorded event file (see event_record_file.h) through the pipeline.
+ *
+ * The file is memory-mapped once and every Process() publishes the next event
+ * as a zero-copy RawEventProduct. Each worker's instance can be given its own
+ * contiguous shard of the file via shard_index/shard_count.
+ *
+ * Parameters:
+ *   file          recorded event file (required)
+ *   product_name  output product (default "raw_event")
+ *   format        "raw" or "midas" (default "raw")
+ *   loop          restart from the beginning of the shard when exhausted (default false)
+ *   rate          "max" (as fast as possible) or "original" (recorded timestamps)
+ *   speed         time scale applied to the original rate (default 1.0)
+ *   shard_index / shard_count
+ *
+ * SetInput() is optional; a bundle holding a std::size_t under "replay_seek"
+ * repositions the replay within the shard.
+ */
+class EventReplayInputStage : public BaseInputStage {
+public:
+    EventReplayInputStage() = default;
+    ~EventReplayInputStage() override = default;
+
+    void SetInput(const InputBundle& input) override;
+    void Process() override;
+    std::string Name() const override { return "EventReplayInputStage"; }
+
+    // True once a non-looping replay has published its last event
+    bool IsExhausted() const { return exhausted_; }
+
+protected:
+    void OnInit() override;
+
+private:
+    void waitForOriginalTime(std::uint64_t timestampNs);
+
+    std::string filePath_;
+    std::string productName_;
+    RawEventProduct::Format format_ = RawEventProduct::Format::Raw;  //!
+    bool loop_ = false;
+    bool originalRate_ = false;
+    double speed_ = 1.0;
+
+    std::size_t shardBegin_ = 0;
+    std::size_t shardEnd_ = 0;
+    std::size_t next_ = 0;
+    bool exhausted_ = false;
+
+    std::unique_ptr<EventRecordReader> reader_;  //!
+
+    bool timingStarted_ = false;
+    std::uint64_t firstTimestampNs_ = 0;
+    std::chrono::steady_clock::time_point wallStart_;  //!
+
+    ClassDefOverride(EventReplayInputStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_EVENT_REPLAY_INPUT_STAGE_H
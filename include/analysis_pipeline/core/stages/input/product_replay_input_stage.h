@@ -0,0 +1,46 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_PRODUCT_REPLAY_INPUT_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_PRODUCT_REPLAY_INPUT_STAGE_H
+
+#include "analysis_pipeline/core/stages/input/base_input_stage.h"
+#include "analysis_pipeline/core/data/product_record_file.h"
+#include <memory>
+#include <string>
+
+/**
+ * Replays a file written by ProductRecorderStage: every Process() restores the
+ * products captured for the next recorded event into the manager, so the
+ * downstream stages can be run and profiled in isolation.
+ *
+ * Parameters:
+ *   file  product record file (required)
+ *   loop  restart from the first frame when exhausted (default false)
+ *
+ * SetInput() is optional; a bundle holding a std::size_t under "replay_seek"
+ * jumps to that frame.
+ */
+class ProductReplayInputStage : public BaseInputStage {
+public:
+    ProductReplayInputStage() = default;
+    ~ProductReplayInputStage() override = default;
+
+    void SetInput(const InputBundle& input) override;
+    void Process() override;
+    std::string Name() const override { return "ProductReplayInputStage"; }
+
+    bool IsExhausted() const { return exhausted_; }
+
+protected:
+    void OnInit() override;
+
+private:
+    std::string filePath_;
+    bool loop_ = false;
+    std::size_t next_ = 0;
+    bool exhausted_ = false;
+
+    std::unique_ptr<ProductRecordReader> reader_;  //!
+
+    ClassDefOverride(ProductReplayInputStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_PRODUCT_REPLAY_INPUT_STAGE_H
@@ -0,0 +1,39 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_RAW_EVENT_INPUT_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_RAW_EVENT_INPUT_STAGE_H
+
+#include "analysis_pipeline/core/stages/input/base_input_stage.h"
+#include "analysis_pipeline/core/data/products/raw_event_product.h"
+#include <memory>
+#include <string>
+
+/**
+ * Accepts a raw event buffer through SetInput() and publishes it as a RawEventProduct
+ * without copying the payload.
+ *
+ * The bundle entry under `input_key` may hold either a
+ * std::shared_ptr<const RawEventBuffer> or a std::string path to a file
+ * containing one event (handy for synthetic test events).
+ */
+class RawEventInputStage : public BaseInputStage {
+public:
+    RawEventInputStage() = default;
+    ~RawEventInputStage() override = default;
+
+    void SetInput(const InputBundle& input) override;
+    void Process() override;
+    std::string Name() const override { return "RawEventInputStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+    std::string inputKey_;
+    std::string productName_;
+    RawEventProduct::Format format_ = RawEventProduct::Format::Raw;  //!
+
+    std::shared_ptr<const RawEventBuffer> pending_;  //!
+
+    ClassDefOverride(RawEventInputStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_RAW_EVENT_INPUT_STAGE_H
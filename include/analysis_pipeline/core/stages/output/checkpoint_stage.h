@@ -0,0 +1,61 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_CHECKPOINT_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_CHECKPOINT_STAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include <chrono>
+#include <memory>
+#include <string>
+
+class ProductCheckpointer;
+
+/**
+ * Checkpoints selected products to a binary file and restores them at startup.
+ *
+ * At init, the products in an existing checkpoint are added to the manager in
+ * one call. With lazy restore the file is memory-mapped and each object is only
+ * deserialized when a stage first uses it, so restarting with a large
+ * checkpoint takes about as long as reading its index. Restored counters and
+ * accumulators are moved into the objects that stages already obtained from
+ * getOrCreateCounter/Accumulator, so stage order does not matter.
+ *
+ * Checkpoints are then written by a ProductCheckpointer on its own thread.
+ * Process() only wakes it when interval_ms has passed. Each checkpoint appends
+ * the products changed since the previous one, and the file is rewritten in
+ * full once it grows past compact_ratio times its live data. A final
+ * checkpoint is written by Finish(), while the manager still exists.
+ *
+ * Parameters:
+ *   file           checkpoint path (required)
+ *   products       product names to checkpoint
+ *   tags           checkpoint every product carrying one of these tags
+ *                  (if neither is given, every product is checkpointed)
+ *   interval_ms    checkpoint interval (default 10000; 0 = only at end of run)
+ *   restore        restore from `file` at init if it exists (default true)
+ *   lazy           defer deserializing restored objects until first use (default true)
+ *   compact_ratio  file size, relative to the live data, that triggers a rewrite (default 4)
+ */
+class CheckpointStage : public BaseStage {
+public:
+    // Out of line: members hold types that are only forward-declared here
+    CheckpointStage();
+    ~CheckpointStage() override;
+
+    void Process() override;
+    void Finish() override;
+    std::string Name() const override { return "CheckpointStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+    void restore(const std::string& path, bool lazy);
+
+    int intervalMs_ = 10000;
+
+    std::chrono::steady_clock::time_point nextCheckpoint_;  //!
+    std::unique_ptr<ProductCheckpointer> checkpointer_;     //!
+
+    ClassDefOverride(CheckpointStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_CHECKPOINT_STAGE_H
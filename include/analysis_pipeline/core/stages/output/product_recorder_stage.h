@@ -0,0 +1,48 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_PRODUCT_RECORDER_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_PRODUCT_RECORDER_STAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/data/product_selection.h"
+#include "analysis_pipeline/core/data/product_record_file.h"
+#include <memory>
+#include <string>
+
+/**
+ * Captures the products present at this point of the pipeline into a product
+ * record file, for a sample of events. Insert it right after the stage whose
+ * output should be captured; ProductReplayInputStage plays the file back into
+ * a pipeline holding only the downstream stages.
+ *
+ * Parameters:
+ *   file          output file (required)
+ *   products      product names to capture
+ *   tags          capture every product carrying one of these tags
+ *                 (if neither is given, every product is captured)
+ *   sample_every  capture one event out of N (default 1)
+ *   max_events    stop after this many captured events (default 0 = unlimited)
+ */
+class ProductRecorderStage : public BaseStage {
+public:
+    ProductRecorderStage() = default;
+    ~ProductRecorderStage() override;
+
+    void Process() override;
+    std::string Name() const override { return "ProductRecorderStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+
+    std::string filePath_;
+    ProductSelection selection_;  //!
+    std::uint64_t sampleEvery_ = 1;
+    std::uint64_t maxEvents_ = 0;
+
+    std::uint64_t eventsSeen_ = 0;
+    std::unique_ptr<ProductRecordWriter> writer_;  //!
+
+    ClassDefOverride(ProductRecorderStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_PRODUCT_RECORDER_STAGE_H
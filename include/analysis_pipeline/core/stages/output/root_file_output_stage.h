@@ -0,0 +1,88 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_ROOT_FILE_OUTPUT_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_ROOT_FILE_OUTPUT_STAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/data/product_selection.h"
+#include "analysis_pipeline/core/execution/writer_queue.h"
+#include <TObject.h>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Writes selected products to a ROOT file, periodically and at end of run.
+ *
+ * When a write is due, Process() clones the selected objects, holding each
+ * product's read lock only for its clone, and hands the batch to a dedicated
+ * I/O thread through a bounded WriterQueue. Compression and disk writes happen on
+ * that thread. If the queue is full the batch is dropped and counted, so the
+ * event loop never waits on the disk.
+ *
+ * Every file is written to "<path>.tmp" and renamed into place when complete,
+ * so readers never see a partial file. The end-of-run file is written by
+ * Finish(); the destructor only waits for writes already queued.
+ *
+ * Parameters:
+ *   file         output path (required)
+ *   products     product names to write
+ *   tags         write every product carrying one of these tags
+ *                (if neither is given, every product is written)
+ *   interval_ms  periodic write interval (default 0 = only at end of run)
+ *   rotate       false (default): each write replaces `file`;
+ *                true: each write creates "<stem>_<NNNN><ext>"
+ *   keep_files   with rotate, keep only the newest N files (default 0 = all)
+ *   compression  see RootCompression (default: ROOT's general-purpose setting)
+ *   queue_size   pending batches before new ones are dropped (default 2)
+ *
+ * Product names containing '/' are written into matching subdirectories.
+ */
+class RootFileOutputStage : public BaseStage {
+public:
+    RootFileOutputStage() = default;
+    ~RootFileOutputStage() override;
+
+    void Process() override;
+    void Finish() override;
+    std::string Name() const override { return "RootFileOutputStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+    struct Batch {
+        std::uint64_t sequence = 0;
+        std::vector<std::pair<std::string, std::unique_ptr<TObject>>> objects;
+    };
+
+    std::unique_ptr<Batch> snapshot();
+    bool enqueue(std::unique_ptr<Batch> batch, bool wait);
+    void startWriter();
+    void writeBatch(const Batch& batch);
+    std::string pathFor(std::uint64_t sequence) const;
+
+    std::string filePath_;
+    ProductSelection selection_;  //!
+    int intervalMs_ = 0;
+    bool rotate_ = false;
+    std::size_t keepFiles_ = 0;
+    int compression_ = 0;
+    std::size_t queueSize_ = 2;
+
+    std::chrono::steady_clock::time_point nextWrite_;  //!
+    std::uint64_t batchesQueued_ = 0;
+    std::uint64_t batchesDropped_ = 0;
+    std::uint64_t eventsSeen_ = 0;
+
+    WriterQueue<Batch> writer_;                   //!
+
+    // Touched only by the writer thread
+    std::deque<std::string> writtenFiles_;        //!
+    std::uint64_t writeFailures_ = 0;
+
+    ClassDefOverride(RootFileOutputStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_ROOT_FILE_OUTPUT_STAGE_H
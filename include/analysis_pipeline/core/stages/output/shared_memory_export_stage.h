@@ -0,0 +1,59 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_SHARED_MEMORY_EXPORT_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_SHARED_MEMORY_EXPORT_STAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/data/product_selection.h"
+#include "analysis_pipeline/core/data/shm_product_publisher.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Mirrors selected products into a POSIX shared-memory segment for external
+ * monitors (see ShmProductReader). Serialization and copying happen on a
+ * background thread at a fixed interval, so Process() does nothing and the
+ * pipeline only shares per-product read locks with the exporter.
+ *
+ * Parameters:
+ *   segment          shared-memory name (default "/analysis_pipeline")
+ *   products         product names to export
+ *   tags             export every product carrying one of these tags
+ *                    (default ["histogram"] if neither is given)
+ *   format           "json" (default) or "root" (ProductCodec records)
+ *   slots            number of product slots (default 256)
+ *   slot_size        payload capacity per slot in bytes (default 1 MiB)
+ *   interval_ms      export period (default 1000)
+ *   unlink_on_close  remove the segment when the stage is destroyed (default true)
+ */
+class SharedMemoryExportStage : public BaseStage {
+public:
+    SharedMemoryExportStage() = default;
+    ~SharedMemoryExportStage() override;
+
+    void Process() override {}
+    std::string Name() const override { return "SharedMemoryExportStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+    void stopExporter();
+    void run();
+
+    ProductSelection selection_;  //!
+    shm_product_format::PayloadFormat format_ = shm_product_format::PayloadFormat::Json;  //!
+    int intervalMs_ = 1000;
+
+    std::unique_ptr<ShmProductPublisher> publisher_;  //!
+    std::thread thread_;                               //!
+    std::mutex mutex_;                                 //!
+    std::condition_variable cv_;                       //!
+    bool stopping_ = false;                            //!
+
+    ClassDefOverride(SharedMemoryExportStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_SHARED_MEMORY_EXPORT_STAGE_H
@@ -0,0 +1,48 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_SNAPSHOT_SENDER_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_SNAPSHOT_SENDER_STAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/data/product_selection.h"
+#include "analysis_pipeline/core/data/snapshot_client.h"
+#include <memory>
+#include <string>
+
+/**
+ * Periodically sends a snapshot of accumulator products to a
+ * SnapshotAggregator, so several pipeline processes on one machine can be
+ * merged into a single view. A final snapshot is sent by Finish().
+ *
+ * Parameters:
+ *   socket          aggregator Unix socket path (required)
+ *   source_id       identity of this process (default "<hostname>:<pid>")
+ *   products        product names to send
+ *   tags            send every product carrying one of these tags
+ *                   (if neither is given, every product is sent)
+ *   every_n_events  send one snapshot every N events (default 1000)
+ */
+class SnapshotSenderStage : public BaseStage {
+public:
+    SnapshotSenderStage() = default;
+    ~SnapshotSenderStage() override;
+
+    void Process() override;
+    void Finish() override;
+    std::string Name() const override { return "SnapshotSenderStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+    void sendSnapshot();
+
+    ProductSelection selection_;  //!
+    std::uint64_t everyNEvents_ = 1000;
+
+    std::uint64_t eventsSeen_ = 0;
+    std::uint64_t failedSends_ = 0;
+    std::unique_ptr<SnapshotClient> client_;  //!
+
+    ClassDefOverride(SnapshotSenderStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_SNAPSHOT_SENDER_STAGE_H
@@ -0,0 +1,143 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_TTREE_OUTPUT_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_TTREE_OUTPUT_STAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/data/product_selection.h"
+#include "analysis_pipeline/core/execution/writer_queue.h"
+#include <TObject.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TClass;
+class TFile;
+class TTree;
+
+/**
+ * Writes selected per-event products to a TTree, with one branch per product.
+ *
+ * Process() only copies the selected values into a columnar staging block.
+ * Numbers go to flat arrays, ValueBatch contents go to one flat array with
+ * per-event offsets, and other objects are cloned. A full block is handed to a
+ * dedicated I/O thread through a bounded WriterQueue. That thread fills the tree, so
+ * basket compression and disk writes never run on a worker. When the queue is
+ * full, Process() either waits (on_full "block") or drops the block ("drop").
+ * Both cases are counted and published as "<stats_prefix>..." products.
+ *
+ * Branches are fixed by the first event that has any selected product:
+ *   TParameter<double|float>          double branch
+ *   TParameter<int|Long64_t|bool>     Long64_t branch
+ *   ValueBatch                        std::vector<double> branch
+ *   any other TObject                 object branch of that class
+ * A product missing from a later event is written as 0, an empty vector or a
+ * default-constructed object.
+ *
+ * Parameters:
+ *   file          output path (required); written as "<file>.tmp" and renamed when complete
+ *   tree          tree name (default "events")
+ *   products      product names to write
+ *   tags          write every product carrying one of these tags (products or tags required)
+ *   block_size    events staged per block (default 1024)
+ *   queue_size    blocks pending on the I/O thread (default 8)
+ *   on_full       "block" (default) or "drop"
+ *   auto_flush    TTree::SetAutoFlush setting (default 0 = ROOT's default)
+ *   compression   see RootCompression (default: ROOT's general-purpose setting)
+ *   stats_prefix  prefix of the published counters (default "ttree_output/")
+ *
+ * Branch names are the product names with every character other than a
+ * letter, digit or '_' replaced by '_'. When two products map to the same
+ * name, the later one in sorted order gets a "_2", "_3", ... suffix.
+ */
+class TTreeOutputStage : public BaseStage {
+public:
+    // Out of line: members hold types that are only forward-declared here
+    TTreeOutputStage();
+    ~TTreeOutputStage() override;
+
+    void Process() override;
+    std::string Name() const override { return "TTreeOutputStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+    enum class Source { Double, Float, Int, Long64, Bool, Batch, Object };
+
+    struct ColumnSpec {
+        std::string product;
+        std::string branch;
+        Source source = Source::Double;
+        TClass* cls = nullptr;  // class the product had when the schema was fixed
+    };
+
+    // Staged values of one branch. Scalars use `doubles` or `longs`; batches
+    // use `doubles` with `offsets` (rows + 1 entries); objects use `objects`.
+    struct Column {
+        std::vector<double> doubles;
+        std::vector<Long64_t> longs;
+        std::vector<std::size_t> offsets;
+        std::vector<std::unique_ptr<TObject>> objects;
+    };
+
+    struct Block {
+        std::size_t rows = 0;
+        std::vector<Column> columns;
+    };
+
+    // Branch addresses on the I/O thread
+    struct BranchBuffer {
+        double value = 0.0;
+        Long64_t integer = 0;
+        std::vector<double> values;
+        void* object = nullptr;  // full object, as the branch expects
+        std::unique_ptr<TObject> defaultObject;
+    };
+
+    bool resolveSchema();
+    void stageEvent(Block& block);
+    std::unique_ptr<Block> takeBlock();
+    void handOff(std::unique_ptr<Block> block, bool wait);
+    void recycle(std::unique_ptr<Block> block);
+    void publishStats();
+    void startWriter();
+    void writeQueued(std::unique_ptr<Block>& block);
+    void openFile();
+    void writeBlock(const Block& block);
+    void closeFile();
+
+    std::string filePath_;
+    std::string treeName_;
+    ProductSelection selection_;  //!
+    std::size_t blockSize_ = 1024;
+    std::size_t queueSize_ = 8;
+    bool dropWhenFull_ = false;
+    Long64_t autoFlush_ = 0;
+    int compression_ = 0;
+    std::string statsPrefix_;
+
+    std::vector<ColumnSpec> columns_;                   //! fixed before the first block is queued
+    std::unique_ptr<Block> staging_;                    //!
+
+    std::uint64_t blocksQueued_ = 0;
+    std::uint64_t blocksDropped_ = 0;
+    std::uint64_t eventsDropped_ = 0;
+    std::uint64_t blockedMicros_ = 0;
+
+    WriterQueue<Block> writer_;                         //!
+    std::mutex freeMutex_;                              //!
+    std::vector<std::unique_ptr<Block>> freeBlocks_;    //! written blocks, reused for staging
+
+    // Touched only by the writer thread
+    std::unique_ptr<TFile> file_;                       //!
+    TTree* tree_ = nullptr;                             //! owned by file_
+    std::vector<BranchBuffer> buffers_;                 //!
+    std::atomic<std::uint64_t> entriesWritten_{0};      //!
+    std::atomic<std::uint64_t> writeFailures_{0};       //!
+
+    ClassDefOverride(TTreeOutputStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_TTREE_OUTPUT_STAGE_H
@@ -0,0 +1,59 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_STAGE_REGISTRY_H
+#define ANALYSIS_PIPELINE_STAGES_STAGE_REGISTRY_H
+
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class BaseStage;
+
+/**
+ * Name -> constructor table for stages, filled at library load time by
+ * REGISTER_STAGE. Creating a registered stage is a hash lookup plus `new`,
+ * with no TClass lookup or dictionary access. Stages that are not registered
+ * (e.g. from libraries that only ship a ROOT dictionary) are still created
+ * through TClass::New() as a fallback.
+ *
+ * The registry does not defer dictionary loading. Stages and products use
+ * ClassDefOverride, whose IsA()/Streamer() are defined in the library's G__
+ * dictionary, so that dictionary is linked in and registered when the
+ * library loads.
+ */
+class StageRegistry {
+public:
+    using Factory = BaseStage* (*)();
+
+    static StageRegistry& instance();
+
+    // Returns false (and keeps the existing entry) if the name is already registered
+    bool registerStage(const std::string& name, Factory factory);
+
+    // Returns nullptr if the name is neither registered nor known to ROOT as a BaseStage
+    std::unique_ptr<BaseStage> create(const std::string& name) const;
+
+    bool contains(const std::string& name) const;
+    std::vector<std::string> registeredNames() const;
+
+    // Enables/disables the TClass::New() fallback for unregistered names (enabled by default)
+    void setDictionaryFallback(bool enabled);
+
+private:
+    StageRegistry() = default;
+
+    BaseStage* createFromDictionary(const std::string& name) const;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, Factory> factories_;
+    bool dictionaryFallback_ = true;
+};
+
+// Registers a stage under its class name. Use once per stage, in its .cpp file.
+#define REGISTER_STAGE(ClassName)                                                   \
+    namespace {                                                                     \
+    const bool ClassName##_registered = StageRegistry::instance().registerStage(   \
+        #ClassName, []() -> BaseStage* { return new ClassName(); });               \
+    }
+
+#endif // ANALYSIS_PIPELINE_STAGES_STAGE_REGISTRY_H
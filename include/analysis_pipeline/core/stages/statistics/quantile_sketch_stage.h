@@ -0,0 +1,53 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_QUANTILESKETCHSTAGE_H
+#define ANALYSIS_PIPELINE_STAGES_QUANTILESKETCHSTAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/data/member_accessor.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Maintains a QuantileSketch product over a numeric member of an input
+ * product. Unlike TH1BuilderStage it needs no range or binning up front.
+ * A ValueBatch input contributes all of its values.
+ *
+ * Parameters:
+ *   input_product      product to read (required)
+ *   value_key          numeric data member to read (default "value"; ignored for ValueBatch)
+ *   product_name       sketch product name (default "quantile_sketch")
+ *   k                  sketch accuracy parameter (default 200, about 1.3% rank error)
+ *   publish_quantiles  quantiles to also publish as TParameter<double> products
+ *                      "<product_name>/pNN", e.g. [0.5, 0.9, 0.99] (default none)
+ *   every_n_events     publish period for publish_quantiles (default 1000)
+ */
+class QuantileSketchStage : public BaseStage {
+public:
+    QuantileSketchStage() = default;
+    ~QuantileSketchStage() override = default;
+
+    void Process() override;
+    std::string Name() const override { return "QuantileSketchStage"; }
+
+protected:
+    void OnInit() override;
+
+private:
+    bool readInput();
+    void publishQuantiles();
+
+    std::string inputProductName_;
+    std::string productName_;
+    std::uint32_t k_ = 200;
+    std::vector<double> publishQuantiles_;
+    std::vector<std::string> quantileNames_;
+    std::uint64_t everyNEvents_ = 1000;
+
+    MemberAccessor accessor_;       //!
+    std::vector<double> scratch_;   //! values read this event
+    std::uint64_t eventsSeen_ = 0;
+
+    ClassDefOverride(QuantileSketchStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_QUANTILESKETCHSTAGE_H
@@ -11,6 +11,7 @@ public:
 
     void Process() override;
     std::string Name() const override { return "RandomDataGeneratorStage"; }
+    bool StartsEvent() const override { return true; }
 
 protected:
     void OnInit() override;
@@ -0,0 +1,53 @@
+#ifndef ANALYSIS_PIPELINE_STAGES_SYNTHETIC_LOAD_GENERATOR_STAGE_H
+#define ANALYSIS_PIPELINE_STAGES_SYNTHETIC_LOAD_GENERATOR_STAGE_H
+
+#include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/random/sample_distribution.h"
+#include "analysis_pipeline/core/random/xoshiro256pp.h"
+#include <memory>
+#include <string>
+
+/**
+ * High-rate counterpart of RandomDataGeneratorStage for load testing.
+ *
+ * Every Process() publishes a ValueBatch of `batch_size` samples drawn from a
+ * configurable distribution using xoshiro256++. Give each worker's instance a
+ * different `stream` to get independent, reproducible sequences per thread.
+ *
+ * Parameters:
+ *   product_name   output product (default "synthetic_values")
+ *   batch_size     samples per event (default 1000)
+ *   distribution   see SampleDistribution::fromJson (default uniform [0, 1))
+ *   seed           base seed shared by all workers (default 0)
+ *   stream         per-worker stream index (default 0)
+ *   in_place       refill the existing product instead of allocating a new one (default true)
+ */
+class SyntheticLoadGeneratorStage : public BaseStage {
+public:
+    SyntheticLoadGeneratorStage() = default;
+    ~SyntheticLoadGeneratorStage() override = default;
+
+    void Process() override;
+    std::string Name() const override { return "SyntheticLoadGeneratorStage"; }
+    bool StartsEvent() const override { return true; }
+
+protected:
+    void OnInit() override;
+
+private:
+    bool refillInPlace();
+    void publishNew();
+
+    std::string productName_;
+    std::size_t batchSize_ = 1000;
+    std::uint64_t seed_ = 0;
+    std::uint64_t stream_ = 0;
+    bool inPlace_ = true;
+
+    Xoshiro256PlusPlus rng_;                             //!
+    std::unique_ptr<SampleDistribution> distribution_;  //!
+
+    ClassDefOverride(SyntheticLoadGeneratorStage, 1);
+};
+
+#endif // ANALYSIS_PIPELINE_STAGES_SYNTHETIC_LOAD_GENERATOR_STAGE_H
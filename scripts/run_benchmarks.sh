@@ -0,0 +1,71 @@
+#!/bin/bash
+
+# Resolve absolute paths
+SCRIPT_DIR=$(dirname "$(realpath "$0")")
+BASE_DIR=$(realpath "$SCRIPT_DIR/..")
+BUILD_DIR="$BASE_DIR/build-benchmarks"
+RESULTS_DIR="$BASE_DIR/benchmarks/results"
+
+# Default flags
+FILTER=""
+JOBS_ARG="-j"  # Use all processors
+
+# Help message
+show_help() {
+    echo "Usage: ./run_benchmarks.sh [OPTIONS]"
+    echo
+    echo "Builds the benchmark target in Release mode and writes JSON results to benchmarks/results/."
+    echo
+    echo "Options:"
+    echo "  -f, --filter <regex>      Only run benchmarks matching the regex"
+    echo "  -j, --jobs <number>       Specify number of processors to use (default: all available)"
+    echo "  -h, --help                Display this help message"
+}
+
+# Parse arguments
+while [[ "$#" -gt 0 ]]; do
+    case $1 in
+        -f|--filter)
+            FILTER="$2"
+            shift 2
+            ;;
+        -j|--jobs)
+            if [[ -n "$2" && "$2" != -* ]]; then
+                JOBS_ARG="-j$2"
+                shift 2
+            else
+                JOBS_ARG="-j"
+                shift
+            fi
+            ;;
+        -h|--help)
+            show_help
+            exit 0
+            ;;
+        *)
+            echo "[run_benchmarks.sh, ERROR] Unknown option: $1"
+            show_help
+            exit 1
+            ;;
+    esac
+done
+
+mkdir -p "$BUILD_DIR" "$RESULTS_DIR"
+cd "$BUILD_DIR" || exit 1
+
+echo "[run_benchmarks.sh] Configuring benchmarks in: $BUILD_DIR"
+cmake "$BASE_DIR" -DCMAKE_BUILD_TYPE=Release -DBUILD_BENCHMARKS=ON || exit 1
+
+echo "[run_benchmarks.sh] Building with make $JOBS_ARG"
+make $JOBS_ARG analysis_pipeline_core_benchmarks || exit 1
+
+GIT_REV=$(git -C "$BASE_DIR" rev-parse --short HEAD 2>/dev/null || echo "unknown")
+OUTPUT="$RESULTS_DIR/benchmarks_${GIT_REV}_$(date +%Y%m%d_%H%M%S).json"
+
+echo "[run_benchmarks.sh] Running benchmarks, results -> $OUTPUT"
+./benchmarks/analysis_pipeline_core_benchmarks \
+    ${FILTER:+--benchmark_filter="$FILTER"} \
+    --benchmark_out="$OUTPUT" \
+    --benchmark_out_format=json
+
+echo "[run_benchmarks.sh] Done."
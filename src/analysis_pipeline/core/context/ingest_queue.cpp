@@ -0,0 +1,57 @@
+#include "analysis_pipeline/core/context/ingest_queue.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+
+#include <TParameter.h>
+
+IngestQueueConfig IngestQueueConfig::fromJson(const nlohmann::json& config) {
+    IngestQueueConfig result;
+    result.capacity = config.value("capacity", result.capacity);
+
+    std::string policy = config.value("policy", "block");
+    if (policy == "block") {
+        result.policy = BackpressurePolicy::Block;
+    } else if (policy == "drop_oldest") {
+        result.policy = BackpressurePolicy::DropOldest;
+    } else if (policy == "drop_newest") {
+        result.policy = BackpressurePolicy::DropNewest;
+    } else {
+        throw std::runtime_error("IngestQueueConfig: unknown policy '" + policy +
+                                 "' (expected 'block', 'drop_oldest' or 'drop_newest')");
+    }
+    return result;
+}
+
+nlohmann::json IngestQueueStats::toJson() const {
+    return {
+        {"capacity", capacity},
+        {"occupancy", occupancy},
+        {"high_water", highWater},
+        {"pushed", pushed},
+        {"popped", popped},
+        {"dropped_oldest", droppedOldest},
+        {"dropped_newest", droppedNewest}
+    };
+}
+
+void IngestQueueStats::publish(PipelineDataProductManager& manager, const std::string& prefix) const {
+    std::vector<std::pair<std::string, std::unique_ptr<PipelineDataProduct>>> products;
+
+    auto add = [&](const char* counter, std::uint64_t value) {
+        std::string name = prefix + counter;
+        auto product = std::make_unique<PipelineDataProduct>();
+        product->setName(name);
+        product->setObject(std::make_unique<TParameter<Long64_t>>(name.c_str(), static_cast<Long64_t>(value)));
+        product->addTag("ingest_queue");
+        products.emplace_back(name, std::move(product));
+    };
+
+    add("capacity", capacity);
+    add("occupancy", occupancy);
+    add("high_water", highWater);
+    add("pushed", pushed);
+    add("popped", popped);
+    add("dropped_oldest", droppedOldest);
+    add("dropped_newest", droppedNewest);
+
+    manager.addOrUpdateMultiple(std::move(products));
+}
@@ -0,0 +1,110 @@
+#include "analysis_pipeline/core/data/double_buffered_histogram.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+DoubleBufferedHistogram::DoubleBufferedHistogram(std::unique_ptr<TH1> prototype,
+                                                 std::string productName,
+                                                 std::unordered_set<std::string> tags,
+                                                 std::chrono::milliseconds publishInterval,
+                                                 PipelineDataProductManager* manager)
+    : productName_(std::move(productName)),
+      tags_(std::move(tags)),
+      publishInterval_(publishInterval),
+      manager_(manager) {
+    if (!prototype) {
+        throw std::invalid_argument("DoubleBufferedHistogram: null prototype");
+    }
+    if (!manager_) {
+        throw std::invalid_argument("DoubleBufferedHistogram: null manager");
+    }
+    live_ = emptyCopy(*prototype);
+    spare_ = emptyCopy(*prototype);
+
+    // Created up front, so instances sharing the name only ever add to it
+    if (!manager_->hasProduct(productName_)) {
+        std::shared_ptr<TObject> empty(emptyCopy(*prototype).release());
+        manager_->addOrUpdate(productName_, makeProduct(std::move(empty)));
+    }
+}
+
+DoubleBufferedHistogram::~DoubleBufferedHistogram() = default;
+
+std::unique_ptr<TH1> DoubleBufferedHistogram::emptyCopy(const TH1& prototype) {
+    std::unique_ptr<TH1> copy(static_cast<TH1*>(prototype.Clone()));
+    copy->SetDirectory(nullptr);
+    copy->Reset();
+    return copy;
+}
+
+void DoubleBufferedHistogram::fill(double x, double weight) {
+    std::lock_guard lock(fillMutex_);
+    live_->Fill(x, weight);
+}
+
+void DoubleBufferedHistogram::publish() {
+    std::lock_guard lock(publishMutex_);
+    if (detached_) return;
+    publishLocked();
+}
+
+void DoubleBufferedHistogram::detach() {
+    std::lock_guard lock(publishMutex_);
+    if (detached_) return;
+    publishLocked();
+    detached_ = true;
+}
+
+void DoubleBufferedHistogram::discard() {
+    // Waits for an in-flight publish, which may still use the manager
+    std::lock_guard lock(publishMutex_);
+    detached_ = true;
+}
+
+void DoubleBufferedHistogram::publishLocked() {
+    {
+        std::lock_guard lock(fillMutex_);
+        live_.swap(spare_);
+    }
+
+    // Every instance publishing this name (e.g. one TH1BuilderStage per
+    // worker chain) adds its own fills to the published total, as unbuffered
+    // fills would. The total is copied, not edited in place, so a reader still
+    // holding the previous object never sees it change.
+    try {
+        if (manager_->hasProduct(productName_)) {
+            auto handle = manager_->checkoutWrite(productName_);
+            if (auto* published = dynamic_cast<TH1*>(handle->getObject())) {
+                std::shared_ptr<TObject> total(published->Clone(productName_.c_str()));
+                auto* hist = static_cast<TH1*>(total.get());
+                hist->SetDirectory(nullptr);
+                if (hist->Add(spare_.get())) {
+                    handle->setSharedObject(std::move(total));
+                    spare_->Reset();
+                    return;
+                }
+            }
+            spdlog::warn("[DoubleBufferedHistogram] '{}' holds an incompatible object; replacing it",
+                         productName_);
+        }
+    } catch (const std::exception& e) {
+        // Removed between the check and the checkout; recreate it below
+        spdlog::debug("[DoubleBufferedHistogram] Re-creating '{}': {}", productName_, e.what());
+    }
+
+    std::shared_ptr<TObject> snapshot(spare_->Clone(productName_.c_str()));
+    static_cast<TH1*>(snapshot.get())->SetDirectory(nullptr);
+    spare_->Reset();
+    manager_->addOrUpdate(productName_, makeProduct(std::move(snapshot)));
+}
+
+std::unique_ptr<PipelineDataProduct> DoubleBufferedHistogram::makeProduct(std::shared_ptr<TObject> object) const {
+    auto product = std::make_unique<PipelineDataProduct>();
+    product->setName(productName_);
+    product->setSharedObject(std::move(object));
+    for (const auto& tag : tags_) {
+        product->addTag(tag);
+    }
+    return product;
+}
@@ -0,0 +1,91 @@
+#include "analysis_pipeline/core/data/event_record_file.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t align8(std::size_t n) {
+    return (n + 7) & ~static_cast<std::size_t>(7);
+}
+
+template <typename T>
+void writePod(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+EventRecordWriter::EventRecordWriter(const std::string& path)
+    : out_(path, std::ios::binary | std::ios::trunc), path_(path) {
+    if (!out_) {
+        throw std::runtime_error("EventRecordWriter: cannot open '" + path + "' for writing");
+    }
+    out_.write(event_record_format::kMagic, sizeof(event_record_format::kMagic));
+    writePod<std::uint32_t>(out_, event_record_format::kVersion);
+    writePod<std::uint32_t>(out_, 0);
+}
+
+void EventRecordWriter::write(const std::uint8_t* data, std::size_t size, std::uint64_t timestampNs) {
+    if (size > UINT32_MAX) {
+        throw std::runtime_error("EventRecordWriter: event of " + std::to_string(size) + " bytes is too large");
+    }
+    writePod<std::uint64_t>(out_, timestampNs);
+    writePod<std::uint32_t>(out_, static_cast<std::uint32_t>(size));
+    writePod<std::uint32_t>(out_, 0);
+    out_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+
+    static const char padding[8] = {};
+    out_.write(padding, static_cast<std::streamsize>(align8(size) - size));
+
+    if (!out_) {
+        throw std::runtime_error("EventRecordWriter: write failed");
+    }
+    ++eventsWritten_;
+}
+
+void EventRecordWriter::write(const RawEventBuffer& event, std::uint64_t timestampNs) {
+    write(event.data(), event.size(), timestampNs);
+}
+
+void EventRecordWriter::close() {
+    if (!out_.is_open()) return;
+    out_.flush();
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error("EventRecordWriter: failed to flush '" + path_ + "', the file is incomplete");
+    }
+}
+
+EventRecordReader::EventRecordReader(const std::string& path)
+    : file_(MappedFile::open(path)) {
+    ByteView bytes(file_->data(), file_->size());
+
+    if (bytes.size() < event_record_format::kFileHeaderSize ||
+        std::memcmp(bytes.data(), event_record_format::kMagic, sizeof(event_record_format::kMagic)) != 0) {
+        throw std::runtime_error("EventRecordReader: '" + path + "' is not a recorded event file");
+    }
+    auto version = bytes.read<std::uint32_t>(8);
+    if (version != event_record_format::kVersion) {
+        throw std::runtime_error("EventRecordReader: unsupported version " + std::to_string(version));
+    }
+
+    std::size_t offset = event_record_format::kFileHeaderSize;
+    while (offset + event_record_format::kRecordHeaderSize <= bytes.size()) {
+        Entry entry;
+        entry.timestampNs = bytes.read<std::uint64_t>(offset);
+        entry.size = bytes.read<std::uint32_t>(offset + 8);
+        entry.offset = offset + event_record_format::kRecordHeaderSize;
+
+        if (entry.size > bytes.size() - entry.offset) {
+            throw std::runtime_error("EventRecordReader: truncated record at offset " + std::to_string(offset));
+        }
+        entries_.push_back(entry);
+        offset = entry.offset + align8(entry.size);
+    }
+}
+
+std::shared_ptr<const RawEventBuffer> EventRecordReader::event(std::size_t index) const {
+    const Entry& e = entries_.at(index);
+    return RawEventBuffer::wrap(file_->data() + e.offset, e.size, file_);
+}
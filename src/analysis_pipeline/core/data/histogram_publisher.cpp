@@ -0,0 +1,112 @@
+#include "analysis_pipeline/core/data/histogram_publisher.h"
+
+#include <TROOT.h>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+HistogramPublisher& HistogramPublisher::instance() {
+    static HistogramPublisher publisher;
+    return publisher;
+}
+
+HistogramPublisher::~HistogramPublisher() {
+    // The managers of any histograms still registered may already be destroyed
+    stopThread();
+}
+
+void HistogramPublisher::shutdown() {
+    stopThread();
+
+    std::vector<Entry> remaining;
+    {
+        std::lock_guard lock(mutex_);
+        remaining.swap(entries_);
+    }
+    for (auto& entry : remaining) {
+        entry.histogram->detach();
+    }
+}
+
+void HistogramPublisher::stopThread() {
+    std::thread thread;
+    {
+        std::lock_guard lock(mutex_);
+        ++generation_;
+        thread.swap(thread_);
+    }
+    cv_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void HistogramPublisher::add(std::shared_ptr<DoubleBufferedHistogram> histogram) {
+    if (!histogram) return;
+    {
+        std::lock_guard lock(mutex_);
+        if (!thread_.joinable()) {
+            // Snapshots are cloned on the publisher thread
+            ROOT::EnableThreadSafety();
+            thread_ = std::thread(&HistogramPublisher::run, this, generation_);
+        }
+        auto next = std::chrono::steady_clock::now() + histogram->publishInterval();
+        entries_.push_back({std::move(histogram), next});
+    }
+    cv_.notify_all();
+}
+
+void HistogramPublisher::remove(const std::shared_ptr<DoubleBufferedHistogram>& histogram, bool flush) {
+    std::thread idle;
+    {
+        std::lock_guard lock(mutex_);
+        entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                      [&](const Entry& e) { return e.histogram == histogram; }),
+                       entries_.end());
+        if (entries_.empty()) {
+            // Nothing left to publish; a later add() starts a new thread
+            ++generation_;
+            idle.swap(thread_);
+        }
+    }
+    cv_.notify_all();
+    if (idle.joinable()) idle.join();
+    // Waits for an in-flight publish on the background thread, then flushes
+    if (!histogram) return;
+    if (flush) {
+        histogram->detach();
+    } else {
+        histogram->discard();
+    }
+}
+
+void HistogramPublisher::run(std::uint64_t generation) {
+    std::unique_lock lock(mutex_);
+    while (generation_ == generation) {
+        auto now = std::chrono::steady_clock::now();
+        auto wakeUp = now + std::chrono::seconds(1);
+
+        std::vector<std::shared_ptr<DoubleBufferedHistogram>> due;
+        for (auto& entry : entries_) {
+            if (entry.nextPublish <= now) {
+                due.push_back(entry.histogram);
+                entry.nextPublish = now + entry.histogram->publishInterval();
+            }
+            wakeUp = std::min(wakeUp, entry.nextPublish);
+        }
+
+        if (!due.empty()) {
+            lock.unlock();
+            for (auto& histogram : due) {
+                try {
+                    histogram->publish();
+                } catch (const std::exception& e) {
+                    spdlog::error("[HistogramPublisher] Failed to publish '{}': {}", histogram->productName(), e.what());
+                }
+            }
+            lock.lock();
+            continue;
+        }
+
+        cv_.wait_until(lock, wakeUp);
+    }
+}
@@ -0,0 +1,184 @@
+#include "analysis_pipeline/core/data/json_encoder_registry.h"
+
+#include <mutex>
+
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <TBufferJSON.h>
+#include <TClass.h>
+#include <TH1.h>
+#include <TParameter.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+#include <TString.h>
+
+namespace {
+
+nlohmann::json doubleArray(const double* values, int count) {
+    nlohmann::json out = nlohmann::json::array();
+    auto& array = out.get_ref<nlohmann::json::array_t&>();
+    array.reserve(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i) array.emplace_back(values[i]);
+    return out;
+}
+
+nlohmann::json encodeAxis(const TAxis& axis) {
+    const int nbins = axis.GetNbins();
+    nlohmann::json out = {
+        {"nbins", nbins},
+        {"min", axis.GetXmin()},
+        {"max", axis.GetXmax()},
+        {"title", axis.GetTitle()},
+    };
+    const TArrayD* edges = axis.GetXbins();
+    if (edges && edges->fN > 0) {
+        out["edges"] = doubleArray(edges->GetArray(), edges->fN);
+    }
+    if (axis.GetLabels()) {
+        nlohmann::json labels = nlohmann::json::array();
+        for (int bin = 1; bin <= nbins; ++bin) labels.push_back(axis.GetBinLabel(bin));
+        out["labels"] = std::move(labels);
+    }
+    return out;
+}
+
+nlohmann::json encodeHistogram(const TObject& object) {
+    const auto& hist = static_cast<const TH1&>(object);
+    const int dimension = hist.GetDimension();
+    const int cells = hist.GetNcells();
+
+    nlohmann::json out = {
+        {"_typename", hist.ClassName()},
+        {"name", hist.GetName()},
+        {"title", hist.GetTitle()},
+        {"entries", hist.GetEntries()},
+        {"x", encodeAxis(*hist.GetXaxis())},
+    };
+    if (dimension > 1) out["y"] = encodeAxis(*hist.GetYaxis());
+    if (dimension > 2) out["z"] = encodeAxis(*hist.GetZaxis());
+
+    // TH1D/TH2D/TH3D keep their cells in a TArrayD; copy it without a virtual call per bin
+    if (const auto* array = dynamic_cast<const TArrayD*>(&hist); array && array->fN == cells) {
+        out["contents"] = doubleArray(array->GetArray(), cells);
+    } else {
+        nlohmann::json contents = nlohmann::json::array();
+        auto& values = contents.get_ref<nlohmann::json::array_t&>();
+        values.reserve(static_cast<std::size_t>(cells));
+        for (int bin = 0; bin < cells; ++bin) values.emplace_back(hist.GetBinContent(bin));
+        out["contents"] = std::move(contents);
+    }
+
+    if (hist.GetSumw2N() > 0) {
+        const TArrayD* sumw2 = hist.GetSumw2();
+        out["sumw2"] = doubleArray(sumw2->GetArray(), sumw2->fN);
+    }
+
+    static constexpr const char* kStatNames[] = {"sumw",  "sumw2",  "sumwx", "sumwx2", "sumwy", "sumwy2",
+                                                 "sumwxy", "sumwz", "sumwz2", "sumwxz", "sumwyz"};
+    const int statCount = dimension == 1 ? 4 : dimension == 2 ? 7 : 11;
+    double stats[TH1::kNstat] = {};
+    hist.GetStats(stats);
+    nlohmann::json statsJson = nlohmann::json::object();
+    for (int i = 0; i < statCount; ++i) statsJson[kStatNames[i]] = stats[i];
+    out["stats"] = std::move(statsJson);
+
+    return out;
+}
+
+template <typename T>
+nlohmann::json encodeParameter(const TObject& object) {
+    const auto& parameter = static_cast<const TParameter<T>&>(object);
+    return {
+        {"_typename", parameter.ClassName()},
+        {"name", parameter.GetName()},
+        {"value", parameter.GetVal()},
+    };
+}
+
+}  // namespace
+
+JsonEncoderRegistry& JsonEncoderRegistry::instance() {
+    static JsonEncoderRegistry registry;
+    return registry;
+}
+
+JsonEncoderRegistry::JsonEncoderRegistry() {
+    registerBuiltins();
+}
+
+void JsonEncoderRegistry::registerBuiltins() {
+    registerEncoder(TH1::Class(), encodeHistogram);
+    // Profiles store sums of y in their cells, which the histogram schema cannot express
+    registerEncoder(TProfile::Class(), nullptr);
+    registerEncoder(TProfile2D::Class(), nullptr);
+    registerEncoder(TProfile3D::Class(), nullptr);
+
+    registerEncoder(TParameter<double>::Class(), encodeParameter<double>, false);
+    registerEncoder(TParameter<float>::Class(), encodeParameter<float>, false);
+    registerEncoder(TParameter<int>::Class(), encodeParameter<int>, false);
+    registerEncoder(TParameter<Long64_t>::Class(), encodeParameter<Long64_t>, false);
+    registerEncoder(TParameter<bool>::Class(), encodeParameter<bool>, false);
+}
+
+void JsonEncoderRegistry::registerEncoder(const TClass* cls, Encoder encoder, bool includeDerived) {
+    if (!cls) return;
+    std::unique_lock lock(mutex_);
+    Registration& registration = registrations_[cls];
+    registration.encoder = encoder ? std::make_shared<const Encoder>(std::move(encoder)) : nullptr;
+    registration.includeDerived = includeDerived;
+    resolved_.clear();
+}
+
+void JsonEncoderRegistry::unregisterEncoder(const TClass* cls) {
+    std::unique_lock lock(mutex_);
+    registrations_.erase(cls);
+    resolved_.clear();
+}
+
+bool JsonEncoderRegistry::hasEncoder(const TClass* cls) const {
+    return resolve(cls) != nullptr;
+}
+
+std::shared_ptr<const JsonEncoderRegistry::Encoder> JsonEncoderRegistry::resolve(const TClass* cls) const {
+    if (!cls) return nullptr;
+    {
+        std::shared_lock lock(mutex_);
+        auto it = resolved_.find(cls);
+        if (it != resolved_.end()) return it->second;
+    }
+
+    std::unique_lock lock(mutex_);
+    auto cached = resolved_.find(cls);
+    if (cached != resolved_.end()) return cached->second;
+
+    std::shared_ptr<const Encoder> encoder;
+    auto exact = registrations_.find(cls);
+    if (exact != registrations_.end()) {
+        encoder = exact->second.encoder;
+    } else {
+        // Most-derived registered base class that covers subclasses
+        const TClass* best = nullptr;
+        for (const auto& [base, registration] : registrations_) {
+            if (!registration.includeDerived || !cls->InheritsFrom(base)) continue;
+            if (!best || base->InheritsFrom(best)) {
+                best = base;
+                encoder = registration.encoder;
+            }
+        }
+    }
+    resolved_.emplace(cls, encoder);
+    return encoder;
+}
+
+nlohmann::json JsonEncoderRegistry::encode(const TObject& object) const {
+    if (fastPathEnabled()) {
+        if (auto encoder = resolve(object.IsA())) return (*encoder)(object);
+    }
+    return encodeGeneric(object);
+}
+
+nlohmann::json JsonEncoderRegistry::encodeGeneric(const TObject& object) {
+    TString jsonStr = TBufferJSON::ConvertToJSON(&object);
+    return nlohmann::json::parse(jsonStr.Data());
+}
@@ -0,0 +1,50 @@
+#include "analysis_pipeline/core/data/mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(std::string path, const std::uint8_t* data, std::size_t size)
+    : path_(std::move(path)), data_(data), size_(size) {}
+
+MappedFile::~MappedFile() {
+    if (data_ && size_ > 0) {
+        ::munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+}
+
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("MappedFile: cannot open '" + path + "': " + std::strerror(errno));
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("MappedFile: cannot stat '" + path + "': " + std::strerror(err));
+    }
+
+    auto size = static_cast<std::size_t>(st.st_size);
+    const std::uint8_t* data = nullptr;
+    if (size > 0) {
+        void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            int err = errno;
+            ::close(fd);
+            throw std::runtime_error("MappedFile: cannot map '" + path + "': " + std::strerror(err));
+        }
+        ::madvise(addr, size, MADV_SEQUENTIAL);
+        data = static_cast<const std::uint8_t*>(addr);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    return std::shared_ptr<const MappedFile>(new MappedFile(path, data, size));
+}
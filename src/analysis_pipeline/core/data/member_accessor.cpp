@@ -0,0 +1,88 @@
+#include "analysis_pipeline/core/data/member_accessor.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+
+#include <TClass.h>
+#include <TDataMember.h>
+
+#include <cstdint>
+#include <stdexcept>
+
+MemberAccessor::MemberAccessor(std::string productName, std::string memberName)
+    : productName_(std::move(productName)), memberName_(std::move(memberName)) {}
+
+MemberAccessor::Kind MemberAccessor::kindOf(const std::string& typeName) {
+    if (typeName == "double" || typeName == "Double_t" || typeName == "Double32_t") return Kind::Double;
+    if (typeName == "float" || typeName == "Float_t" || typeName == "Float16_t") return Kind::Float;
+    if (typeName == "int" || typeName == "Int_t") return Kind::Int;
+    if (typeName == "unsigned int" || typeName == "UInt_t") return Kind::UInt;
+    if (typeName == "short" || typeName == "Short_t") return Kind::Short;
+    if (typeName == "unsigned short" || typeName == "UShort_t") return Kind::UShort;
+    if (typeName == "long" || typeName == "Long_t") return Kind::Long;
+    if (typeName == "unsigned long" || typeName == "ULong_t") return Kind::ULong;
+    if (typeName == "long long" || typeName == "Long64_t") return Kind::Long64;
+    if (typeName == "unsigned long long" || typeName == "ULong64_t") return Kind::ULong64;
+    if (typeName == "bool" || typeName == "Bool_t") return Kind::Bool;
+    if (typeName == "char" || typeName == "Char_t") return Kind::Char;
+    if (typeName == "unsigned char" || typeName == "UChar_t") return Kind::UChar;
+    return Kind::Unresolved;
+}
+
+bool MemberAccessor::isNumericType(const std::string& typeName) {
+    return kindOf(typeName) != Kind::Unresolved;
+}
+
+void MemberAccessor::resolve(const TObject& object) {
+    TClass* cls = object.IsA();
+    if (!cls) {
+        throw std::runtime_error("MemberAccessor: no class information for product '" + productName_ + "'");
+    }
+    TDataMember* dm = cls->GetDataMember(memberName_.c_str());
+    if (!dm) {
+        throw std::runtime_error("MemberAccessor: member '" + memberName_ + "' not found in class '" +
+                                 cls->GetName() + "'");
+    }
+    Kind kind = kindOf(dm->GetFullTypeName());
+    if (kind == Kind::Unresolved) {
+        throw std::runtime_error("MemberAccessor: member '" + memberName_ + "' has non-numeric type '" +
+                                 dm->GetFullTypeName() + "'");
+    }
+    cachedClass_ = cls;
+    offset_ = dm->GetOffset();
+    kind_ = kind;
+}
+
+double MemberAccessor::read(const PipelineDataProduct& product) {
+    TObject* object = product.getObject();
+    if (!object) {
+        throw std::runtime_error("MemberAccessor: product '" + productName_ + "' holds no object");
+    }
+    if (object->IsA() != cachedClass_) {
+        resolve(*object);
+    }
+
+    const char* p = reinterpret_cast<const char*>(object) + offset_;
+    switch (kind_) {
+        case Kind::Double:  return *reinterpret_cast<const double*>(p);
+        case Kind::Float:   return *reinterpret_cast<const float*>(p);
+        case Kind::Int:     return *reinterpret_cast<const int*>(p);
+        case Kind::UInt:    return *reinterpret_cast<const unsigned int*>(p);
+        case Kind::Short:   return *reinterpret_cast<const short*>(p);
+        case Kind::UShort:  return *reinterpret_cast<const unsigned short*>(p);
+        case Kind::Long:    return static_cast<double>(*reinterpret_cast<const long*>(p));
+        case Kind::ULong:   return static_cast<double>(*reinterpret_cast<const unsigned long*>(p));
+        case Kind::Long64:  return static_cast<double>(*reinterpret_cast<const long long*>(p));
+        case Kind::ULong64: return static_cast<double>(*reinterpret_cast<const unsigned long long*>(p));
+        case Kind::Bool:    return *reinterpret_cast<const bool*>(p) ? 1.0 : 0.0;
+        case Kind::Char:    return *reinterpret_cast<const char*>(p);
+        case Kind::UChar:   return *reinterpret_cast<const unsigned char*>(p);
+        case Kind::Unresolved: break;
+    }
+    throw std::logic_error("MemberAccessor: unresolved member '" + memberName_ + "'");
+}
+
+bool MemberAccessor::read(PipelineDataProductManager& manager, double& value) {
+    auto handle = manager.tryCheckoutRead(productName_);
+    if (!handle || !handle->getObject()) return false;
+    value = read(*handle);
+    return true;
+}
@@ -0,0 +1,101 @@
+#include "analysis_pipeline/core/data/midas_event_view.h"
+
+namespace {
+
+constexpr std::size_t align8(std::size_t n) {
+    return (n + 7) & ~static_cast<std::size_t>(7);
+}
+
+}  // namespace
+
+MidasEventView::MidasEventView(ByteView event) {
+    if (event.size() < kEventHeaderSize + kBankHeaderSize) {
+        throw std::runtime_error("MidasEventView: buffer too small for event and bank headers");
+    }
+
+    eventId_ = event.read<std::uint16_t>(0);
+    triggerMask_ = event.read<std::uint16_t>(2);
+    serialNumber_ = event.read<std::uint32_t>(4);
+    timeStamp_ = event.read<std::uint32_t>(8);
+    auto eventDataSize = event.read<std::uint32_t>(12);
+
+    if (eventDataSize > event.size() - kEventHeaderSize) {
+        throw std::runtime_error("MidasEventView: event data size " + std::to_string(eventDataSize) +
+                                 " exceeds buffer size " + std::to_string(event.size()));
+    }
+
+    ByteView body = event.subview(kEventHeaderSize, eventDataSize);
+    auto banksSize = body.read<std::uint32_t>(0);
+    bankFlags_ = body.read<std::uint32_t>(4);
+
+    if (banksSize > body.size() - kBankHeaderSize) {
+        throw std::runtime_error("MidasEventView: bank area size " + std::to_string(banksSize) +
+                                 " exceeds event data size " + std::to_string(eventDataSize));
+    }
+
+    ByteView bankArea = body.subview(kBankHeaderSize, banksSize);
+
+    const bool is32 = (bankFlags_ & kBankFormat32Bit) != 0;
+    const bool is32a = is32 && (bankFlags_ & kBankFormat64BitAligned) != 0;
+    const std::size_t headerSize = is32a ? 16 : (is32 ? 12 : 8);
+
+    std::size_t offset = 0;
+    while (offset + headerSize <= bankArea.size()) {
+        MidasBank bank;
+        bank.name = std::string_view(reinterpret_cast<const char*>(bankArea.data() + offset), 4);
+
+        std::size_t dataSize = 0;
+        if (is32) {
+            bank.type = bankArea.read<std::uint32_t>(offset + 4);
+            dataSize = bankArea.read<std::uint32_t>(offset + 8);
+        } else {
+            bank.type = bankArea.read<std::uint16_t>(offset + 4);
+            dataSize = bankArea.read<std::uint16_t>(offset + 6);
+        }
+
+        // subview() throws if the bank claims more data than the event holds
+        bank.data = bankArea.subview(offset + headerSize, dataSize);
+        banks_.push_back(bank);
+
+        offset += headerSize + align8(dataSize);
+    }
+}
+
+const MidasBank* MidasEventView::findBank(std::string_view name) const noexcept {
+    for (const auto& bank : banks_) {
+        if (bank.name == name) return &bank;
+    }
+    return nullptr;
+}
+
+const MidasBank& MidasEventView::getBank(std::string_view name) const {
+    const MidasBank* bank = findBank(name);
+    if (!bank) {
+        throw std::runtime_error("MidasEventView: bank '" + std::string(name) + "' not found");
+    }
+    return *bank;
+}
+
+std::size_t MidasEventView::typeSize(std::uint32_t type) noexcept {
+    switch (type) {
+        case 1:  // TID_UINT8
+        case 2:  // TID_INT8
+        case 3:  // TID_CHAR
+            return 1;
+        case 4:  // TID_UINT16
+        case 5:  // TID_INT16
+            return 2;
+        case 6:  // TID_UINT32
+        case 7:  // TID_INT32
+        case 8:  // TID_BOOL
+        case 9:  // TID_FLOAT
+        case 11: // TID_BITFIELD
+            return 4;
+        case 10: // TID_DOUBLE
+        case 17: // TID_INT64
+        case 18: // TID_UINT64
+            return 8;
+        default:
+            return 0;
+    }
+}
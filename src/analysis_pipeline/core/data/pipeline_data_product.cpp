@@ -1,6 +1,6 @@
 #include "analysis_pipeline/core/data/pipeline_data_product.h"
+#include "analysis_pipeline/core/data/json_encoder_registry.h"
 
-#include <TBufferJSON.h>
 #include <TClass.h>
 #include <TDataMember.h>
 #include <TCollection.h>
@@ -16,6 +16,7 @@ void PipelineDataProduct::setObject(std::unique_ptr<TObject> obj) {
         return;
     }
     object_ = std::shared_ptr<TObject>(std::move(obj));
+    lazy_.reset();
 }
 
 void PipelineDataProduct::setSharedObject(std::shared_ptr<TObject> obj) {
@@ -24,14 +25,49 @@ void PipelineDataProduct::setSharedObject(std::shared_ptr<TObject> obj) {
         return;
     }
     object_ = std::move(obj);
+    lazy_.reset();
+}
+
+void PipelineDataProduct::setLazyObject(ObjectLoader loader, std::size_t sizeHint) {
+    if (!loader) {
+        spdlog::warn("PipelineDataProduct::setLazyObject called with empty loader");
+        return;
+    }
+    object_.reset();
+    lazy_ = std::make_shared<LazyObject>();
+    lazy_->loader = std::move(loader);
+    lazy_->sizeHint = sizeHint;
+}
+
+bool PipelineDataProduct::isLoaded() const noexcept {
+    return !lazy_ || lazy_->loaded.load(std::memory_order_acquire);
+}
+
+std::size_t PipelineDataProduct::lazySizeHint() const noexcept {
+    return lazy_ ? lazy_->sizeHint : 0;
+}
+
+const std::shared_ptr<TObject>& PipelineDataProduct::LazyObject::get() {
+    std::call_once(once, [this] {
+        try {
+            if (auto loadedObject = loader()) object = std::shared_ptr<TObject>(std::move(loadedObject));
+        } catch (const std::exception& e) {
+            spdlog::error("PipelineDataProduct: failed to load deferred object: {}", e.what());
+        }
+        loader = nullptr;  // release whatever the loader kept alive
+        loaded.store(true, std::memory_order_release);
+    });
+    return object;
 }
 
 // Object accessor
 TObject* PipelineDataProduct::getObject() const {
+    if (lazy_) return lazy_->get().get();
     return object_ ? object_.get() : nullptr;
 }
 
 std::shared_ptr<TObject> PipelineDataProduct::getSharedObject() const {
+    if (lazy_) return lazy_->get();
     return object_;
 }
 
@@ -95,8 +131,7 @@ nlohmann::json PipelineDataProduct::serializeToJson() const {
     if (!obj) return {};
 
     try {
-        TString jsonStr = TBufferJSON::ConvertToJSON(obj);
-        return nlohmann::json::parse(jsonStr.Data());
+        return JsonEncoderRegistry::instance().encode(*obj);
     } catch (const std::exception& e) {
         spdlog::error("Failed to serialize PipelineDataProduct '{}': {}", name_, e.what());
         return {};
@@ -1,5 +1,7 @@
 #include "analysis_pipeline/core/data/pipeline_data_product_lock.h"
 
+#include <utility>
+
 
 bool PipelineDataProductLock::valid() const noexcept {
     return product_ != nullptr;
@@ -9,5 +11,5 @@ PipelineDataProductLock::operator bool() const noexcept {
     return valid();
 }
 
-PipelineDataProductLock::PipelineDataProductLock(PipelineDataProduct* prod)
-    : product_(prod) {}
+PipelineDataProductLock::PipelineDataProductLock(PipelineDataProduct* prod, std::shared_ptr<const void> owner)
+    : product_(prod), owner_(std::move(owner)) {}
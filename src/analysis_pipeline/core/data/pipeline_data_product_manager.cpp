@@ -1,8 +1,45 @@
 #include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
 #include "spdlog/spdlog.h"
 #include <algorithm>
+#include <chrono>
 #include <stdexcept>
 
+namespace {
+
+std::size_t saturatingSub(std::size_t a, std::size_t b) {
+    return a > b ? a - b : 0;
+}
+
+// Replacing a product that holds a loaded T keeps that object and moves the
+// new value into it, so pointers from getOrCreateCounter/Accumulator stay live
+template <typename T>
+bool adoptShared(const PipelineDataProduct& existing, PipelineDataProduct& incoming) {
+    auto current = std::dynamic_pointer_cast<T>(existing.getSharedObject());
+    if (!current) return false;
+    // Atomic products are a few bytes, so a lazy replacement is simply loaded
+    auto replacement = std::dynamic_pointer_cast<T>(incoming.getSharedObject());
+    if (!replacement) return false;
+    if (replacement != current) {
+        current->assign(*replacement);
+        incoming.setSharedObject(current);
+    }
+    return true;
+}
+
+void keepSharedObject(const PipelineDataProduct& existing, PipelineDataProduct& incoming) {
+    if (!existing.isLoaded()) return;  // nobody can hold a pointer to an object never loaded
+    if (!adoptShared<AtomicCounter>(existing, incoming)) adoptShared<AtomicAccumulator>(existing, incoming);
+}
+
+// True if a pointer to the product's object is held outside the manager
+// (e.g. from getOrCreateCounter); evicting the product would orphan it
+bool objectHeldElsewhere(const PipelineDataProduct& product) {
+    if (!product.isLoaded()) return false;
+    return product.getSharedObject().use_count() > 2;  // the product's own, plus this copy
+}
+
+}  // namespace
+
 // Add or update a single product
 void PipelineDataProductManager::addOrUpdate(const std::string& name, std::unique_ptr<PipelineDataProduct> product) {
     if (!product) {
@@ -11,7 +48,8 @@ void PipelineDataProductManager::addOrUpdate(const std::string& name, std::uniqu
     }
     std::unique_lock managerLock(managerMutex_);
     product->setName(name);
-    products_[name].product = std::move(product);
+    storeLocked(name, std::move(product));
+    flushChanges(managerLock);
 }
 
 // Add or update multiple products atomically
@@ -23,28 +61,45 @@ void PipelineDataProductManager::addOrUpdateMultiple(std::vector<std::pair<std::
             continue;
         }
         product->setName(name);
-        products_[name].product = std::move(product);
+        storeLocked(name, std::move(product));
     }
+    flushChanges(managerLock);
 }
 
 // Remove a single product by name
 void PipelineDataProductManager::remove(const std::string& name) {
     std::unique_lock managerLock(managerMutex_);
-    products_.erase(name);
+    auto it = products_.find(name);
+    if (it != products_.end()) eraseLocked(it);
+    flushChanges(managerLock);
 }
 
 // Remove multiple products atomically
 void PipelineDataProductManager::removeMultiple(const std::vector<std::string>& names) {
     std::unique_lock managerLock(managerMutex_);
     for (const auto& name : names) {
-        products_.erase(name);
+        auto it = products_.find(name);
+        if (it != products_.end()) eraseLocked(it);
     }
+    flushChanges(managerLock);
 }
 
 // Clear all products
 void PipelineDataProductManager::clear() {
     std::unique_lock managerLock(managerMutex_);
+    if (notifier_.active()) {
+        for (const auto& [name, entry] : products_) {
+            recordChangeLocked(name, ProductChangeType::Removed, *entry);
+        }
+    }
     products_.clear();
+    totalUsage_.bytes = 0;
+    totalUsage_.products = 0;
+    for (auto& [tag, usage] : tagUsage_) {
+        usage.bytes = 0;
+        usage.products = 0;
+    }
+    flushChanges(managerLock);
 }
 
 // Get all product names
@@ -92,11 +147,32 @@ PipelineDataProductReadLock PipelineDataProductManager::checkoutRead(const std::
     if (it == products_.end()) {
         throw std::runtime_error("Product not found: " + name);
     }
-    ProductEntry& entry = it->second;
+    // The lock shares ownership of the entry, so a concurrent remove or
+    // eviction cannot free it before or while it is locked
+    std::shared_ptr<ProductEntry> entry = it->second;
+    touch(*entry);
     managerLock.unlock();
 
-    std::shared_lock productLock(entry.mutex);
-    return PipelineDataProductReadLock(entry.product.get(), std::move(productLock));
+    std::shared_lock productLock(entry->mutex);
+    PipelineDataProduct* product = entry->product.get();
+    return PipelineDataProductReadLock(product, std::move(productLock), std::move(entry));
+}
+
+PipelineDataProductReadLock PipelineDataProductManager::tryCheckoutRead(const std::string& name) {
+    std::shared_lock managerLock(managerMutex_);
+    auto it = products_.find(name);
+    if (it == products_.end()) {
+        return PipelineDataProductReadLock();
+    }
+    // The lock shares ownership of the entry, so a concurrent remove or
+    // eviction cannot free it before or while it is locked
+    std::shared_ptr<ProductEntry> entry = it->second;
+    touch(*entry);
+    managerLock.unlock();
+
+    std::shared_lock productLock(entry->mutex);
+    PipelineDataProduct* product = entry->product.get();
+    return PipelineDataProductReadLock(product, std::move(productLock), std::move(entry));
 }
 
 // Checkout a single product for writing (unique lock)
@@ -106,83 +182,154 @@ PipelineDataProductWriteLock PipelineDataProductManager::checkoutWrite(const std
     if (it == products_.end()) {
         throw std::runtime_error("Product not found: " + name);
     }
-    ProductEntry& entry = it->second;
+    std::shared_ptr<ProductEntry> entry = it->second;
+    touch(*entry);
     managerLock.unlock();
 
-    std::unique_lock productLock(entry.mutex);
-    return PipelineDataProductWriteLock(entry.product.get(), std::move(productLock));
+    std::unique_lock productLock(entry->mutex);
+    PipelineDataProduct* product = entry->product.get();
+    PipelineDataProductWriteLock handle(product, std::move(productLock), std::move(entry));
+    if (notifier_.active()) handle.notifyOnRelease(&notifier_, name);
+    return handle;
 }
 
-// Replace the checkoutReadMultiple method (around line 130-145):
+// Checkout multiple products for reading; locks are taken in entry id order
 std::vector<PipelineDataProductReadLock> PipelineDataProductManager::checkoutReadMultiple(const std::vector<std::string>& names) {
-    std::vector<std::string> sortedNames = names;
-    std::sort(sortedNames.begin(), sortedNames.end());
-
-    std::vector<PipelineDataProductReadLock> handles;
-    handles.reserve(sortedNames.size());
+    std::vector<std::shared_ptr<ProductEntry>> entries;
+    entries.reserve(names.size());
 
     std::shared_lock managerLock(managerMutex_);
-
-    std::vector<ProductEntry*> entries;
-    entries.reserve(sortedNames.size());
-    for (const auto& name : sortedNames) {
+    for (const auto& name : names) {
         auto it = products_.find(name);
         if (it == products_.end()) {
             throw std::runtime_error("Product not found: " + name);
         }
-        entries.push_back(&it->second);
+        touch(*it->second);
+        entries.push_back(it->second);
     }
-
     managerLock.unlock();
 
-    for (auto* entry : entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& a, const auto& b) { return a->id < b->id; });
+
+    std::vector<PipelineDataProductReadLock> handles;
+    handles.reserve(entries.size());
+    for (auto& entry : entries) {
         std::shared_lock productLock(entry->mutex);
         // You have to be careful with adding these to vectors; the vector cannot
         // construct new PipelineDataProductReadLocks as PipelineDataProductManager is the 
         // only friend class that is allowed to do so. So we have to make them here
         // then push them back (cannot do emplace_back or similar)
-        PipelineDataProductReadLock lock(entry->product.get(), std::move(productLock)); // local construction
+        PipelineDataProductReadLock lock(entry->product.get(), std::move(productLock), entry); // local construction
         handles.push_back(std::move(lock));                                             // then push_back move
     }
 
     return handles;
 }
 
-// Replace the checkoutWriteMultiple method (around line 150-175):
+// Checkout multiple products for writing; locks are taken in entry id order
 std::vector<PipelineDataProductWriteLock> PipelineDataProductManager::checkoutWriteMultiple(const std::vector<std::string>& names) {
-    std::vector<std::string> sortedNames = names;
-    std::sort(sortedNames.begin(), sortedNames.end());
-
-    std::vector<PipelineDataProductWriteLock> handles;
-    handles.reserve(sortedNames.size());
+    std::vector<std::shared_ptr<ProductEntry>> entries;
+    entries.reserve(names.size());
 
     std::shared_lock managerLock(managerMutex_);
-
-    std::vector<ProductEntry*> entries;
-    entries.reserve(sortedNames.size());
-    for (const auto& name : sortedNames) {
+    for (const auto& name : names) {
         auto it = products_.find(name);
         if (it == products_.end()) {
             throw std::runtime_error("Product not found: " + name);
         }
-        entries.push_back(&it->second);
+        touch(*it->second);
+        entries.push_back(it->second);
     }
-
     managerLock.unlock();
 
-    for (auto* entry : entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& a, const auto& b) { return a->id < b->id; });
+
+    std::vector<PipelineDataProductWriteLock> handles;
+    handles.reserve(entries.size());
+    for (auto& entry : entries) {
         std::unique_lock productLock(entry->mutex);
         // You have to be careful with adding these to vectors; the vector cannot
         // construct new PipelineDataProductWriteLocks as PipelineDataProductManager is the 
         // only friend class that is allowed to do so. So we have to make them here
         // then push them back (cannot do emplace_back or similar)
-        PipelineDataProductWriteLock lock(entry->product.get(), std::move(productLock)); // local construction
+        PipelineDataProductWriteLock lock(entry->product.get(), std::move(productLock), entry); // local construction
+        if (notifier_.active()) lock.notifyOnRelease(&notifier_, entry->product->getName());
         handles.push_back(std::move(lock));                                              // then push_back move
     }
 
     return handles;
 }
 
+ProductHandle PipelineDataProductManager::getHandle(const std::string& name) {
+    std::shared_lock managerLock(managerMutex_);
+    auto it = products_.find(name);
+    if (it == products_.end()) {
+        throw std::runtime_error("Product not found: " + name);
+    }
+    return ProductHandle(it->second);
+}
+
+void PipelineDataProductManager::resolveHandles(const CheckoutRequest* requests, ProductHandle* handles, std::size_t count) {
+    std::shared_lock managerLock(managerMutex_);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!requests[i].name) {
+            if (!requests[i].handle) {
+                throw std::invalid_argument("checkoutMixed: request has neither a name nor a handle");
+            }
+            handles[i] = requests[i].handle;
+            continue;
+        }
+        auto it = products_.find(*requests[i].name);
+        if (it == products_.end()) {
+            throw std::runtime_error("Product not found: " + *requests[i].name);
+        }
+        touch(*it->second);
+        handles[i] = ProductHandle(it->second);
+    }
+}
+
+template <typename T>
+std::shared_ptr<T> PipelineDataProductManager::getOrCreateShared(const std::string& name,
+                                                                 const std::unordered_set<std::string>& tags) {
+    for (;;) {
+        // An existing product may still have to be deserialized, which only
+        // needs its own read lock, not the manager lock
+        if (auto handle = tryCheckoutRead(name)) {
+            auto existing = std::dynamic_pointer_cast<T>(handle->getSharedObject());
+            if (!existing) {
+                throw std::runtime_error("Product '" + name + "' exists but is not a " + T::Class_Name());
+            }
+            return existing;
+        }
+
+        std::unique_lock managerLock(managerMutex_);
+        if (products_.count(name)) continue;  // created by another thread in between
+
+        auto object = std::make_shared<T>();
+        auto product = std::make_unique<PipelineDataProduct>();
+        product->setName(name);
+        product->setSharedObject(object);
+        for (const auto& tag : tags) {
+            product->addTag(tag);
+        }
+        storeLocked(name, std::move(product));
+        flushChanges(managerLock);
+        return object;
+    }
+}
+
+std::shared_ptr<AtomicCounter> PipelineDataProductManager::getOrCreateCounter(
+    const std::string& name, const std::unordered_set<std::string>& tags) {
+    return getOrCreateShared<AtomicCounter>(name, tags);
+}
+
+std::shared_ptr<AtomicAccumulator> PipelineDataProductManager::getOrCreateAccumulator(
+    const std::string& name, const std::unordered_set<std::string>& tags) {
+    return getOrCreateShared<AtomicAccumulator>(name, tags);
+}
+
 std::unique_ptr<PipelineDataProduct> PipelineDataProductManager::extractProduct(const std::string& name) {
     std::unique_lock managerLock(managerMutex_);
     auto it = products_.find(name);
@@ -191,9 +338,13 @@ std::unique_ptr<PipelineDataProduct> PipelineDataProductManager::extractProduct(
         return nullptr;
     }
 
-    std::unique_lock productLock(it->second.mutex);
-    auto result = std::move(it->second.product);
+    if (notifier_.active()) recordChangeLocked(name, ProductChangeType::Removed, *it->second);
+    std::unique_lock productLock(it->second->mutex);
+    auto result = std::move(it->second->product);
+    productLock.unlock();
+    accountRemoveLocked(*it->second);
     products_.erase(it);
+    flushChanges(managerLock);
     return result;
 }
 
@@ -202,8 +353,8 @@ nlohmann::json PipelineDataProductManager::serializeAll() const {
 
     std::shared_lock managerLock(managerMutex_);
     for (const auto& [name, entry] : products_) {
-        std::shared_lock entryLock(entry.mutex);
-        output[name] = entry.product->serializeToJson();
+        std::shared_lock entryLock(entry->mutex);
+        output[name] = entry->product->serializeToJson();
     }
 
     return output;
@@ -215,7 +366,7 @@ std::unordered_set<std::string> PipelineDataProductManager::getAllTags() const {
     std::shared_lock managerLock(managerMutex_);
     std::unordered_set<std::string> result;
     for (const auto& [_, entry] : products_) {
-        const auto& tags = entry.product->getTags();
+        const auto& tags = entry->product->getTags();
         result.insert(tags.begin(), tags.end());
     }
     return result;
@@ -225,24 +376,26 @@ std::unordered_set<std::string> PipelineDataProductManager::getAllTags() const {
 void PipelineDataProductManager::removeByTag(const std::string& tag) {
     std::unique_lock managerLock(managerMutex_);
     for (auto it = products_.begin(); it != products_.end(); ) {
-        if (it->second.product->hasTag(tag)) {
-            it = products_.erase(it);
+        if (it->second->product->hasTag(tag)) {
+            it = eraseLocked(it);
         } else {
             ++it;
         }
     }
+    flushChanges(managerLock);
 }
 
 // Remove all products that DO NOT contain the given tag
 void PipelineDataProductManager::removeExcludingTag(const std::string& tag) {
     std::unique_lock managerLock(managerMutex_);
     for (auto it = products_.begin(); it != products_.end(); ) {
-        if (!it->second.product->hasTag(tag)) {
-            it = products_.erase(it);
+        if (!it->second->product->hasTag(tag)) {
+            it = eraseLocked(it);
         } else {
             ++it;
         }
     }
+    flushChanges(managerLock);
 }
 
 // Get names of products with the specified tag
@@ -250,7 +403,7 @@ std::vector<std::string> PipelineDataProductManager::getNamesWithTag(const std::
     std::shared_lock managerLock(managerMutex_);
     std::vector<std::string> names;
     for (const auto& [name, entry] : products_) {
-        if (entry.product->hasTag(tag)) {
+        if (entry->product->hasTag(tag)) {
             names.push_back(name);
         }
     }
@@ -261,28 +414,30 @@ std::vector<std::string> PipelineDataProductManager::getNamesWithTag(const std::
 void PipelineDataProductManager::removeByTags(const std::unordered_set<std::string>& tags) {
     std::unique_lock managerLock(managerMutex_);
     for (auto it = products_.begin(); it != products_.end(); ) {
-        const auto& prodTags = it->second.product->getTags();
+        const auto& prodTags = it->second->product->getTags();
         if (std::any_of(tags.begin(), tags.end(),
                         [&](const std::string& tag) { return prodTags.count(tag); })) {
-            it = products_.erase(it);
+            it = eraseLocked(it);
         } else {
             ++it;
         }
     }
+    flushChanges(managerLock);
 }
 
 // Remove products that DO NOT have ANY of the specified tags
 void PipelineDataProductManager::removeExcludingTags(const std::unordered_set<std::string>& tags) {
     std::unique_lock managerLock(managerMutex_);
     for (auto it = products_.begin(); it != products_.end(); ) {
-        const auto& prodTags = it->second.product->getTags();
+        const auto& prodTags = it->second->product->getTags();
         if (std::none_of(tags.begin(), tags.end(),
                          [&](const std::string& tag) { return prodTags.count(tag); })) {
-            it = products_.erase(it);
+            it = eraseLocked(it);
         } else {
             ++it;
         }
     }
+    flushChanges(managerLock);
 }
 
 // Get names of products with ANY of the specified tags
@@ -290,7 +445,7 @@ std::vector<std::string> PipelineDataProductManager::getNamesWithAnyTags(const s
     std::shared_lock managerLock(managerMutex_);
     std::vector<std::string> names;
     for (const auto& [name, entry] : products_) {
-        const auto& prodTags = entry.product->getTags();
+        const auto& prodTags = entry->product->getTags();
         if (std::any_of(tags.begin(), tags.end(),
                         [&](const std::string& tag) { return prodTags.count(tag); })) {
             names.push_back(name);
@@ -304,7 +459,7 @@ std::vector<std::string> PipelineDataProductManager::getNamesWithAllTags(const s
     std::shared_lock managerLock(managerMutex_);
     std::vector<std::string> names;
     for (const auto& [name, entry] : products_) {
-        const auto& prodTags = entry.product->getTags();
+        const auto& prodTags = entry->product->getTags();
         if (std::all_of(tags.begin(), tags.end(),
                         [&](const std::string& tag) { return prodTags.count(tag); })) {
             names.push_back(name);
@@ -318,7 +473,7 @@ std::vector<std::string> PipelineDataProductManager::getNamesWithExactTags(const
     std::shared_lock managerLock(managerMutex_);
     std::vector<std::string> names;
     for (const auto& [name, entry] : products_) {
-        const auto& prodTags = entry.product->getTags();
+        const auto& prodTags = entry->product->getTags();
         if (prodTags == tags) {
             names.push_back(name);
         }
@@ -331,9 +486,290 @@ std::vector<std::string> PipelineDataProductManager::getNamesWithNoTags() const
     std::shared_lock managerLock(managerMutex_);
     std::vector<std::string> names;
     for (const auto& [name, entry] : products_) {
-        if (entry.product->getTags().empty()) {
+        if (entry->product->getTags().empty()) {
             names.push_back(name);
         }
     }
     return names;
-}
\ No newline at end of file
+}
+// ---------------------------------------------------------------------------
+// Memory accounting
+// ---------------------------------------------------------------------------
+
+void PipelineDataProductManager::touch(ProductEntry& entry) const {
+    if (!trackAccess_.load(std::memory_order_relaxed)) return;
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    entry.lastAccess.store(static_cast<std::uint64_t>(now.count()), std::memory_order_relaxed);
+}
+
+void PipelineDataProductManager::storeLocked(const std::string& name, std::unique_ptr<PipelineDataProduct> product) {
+    // The product is not shared yet, so it can be inspected without its lock
+    const std::size_t bytes = ProductMemoryEstimator::estimate(*product);
+    if (!admitLocked(name, *product, bytes)) return;
+
+    auto [it, inserted] = products_.try_emplace(name);
+    if (inserted) {
+        it->second = std::make_shared<ProductEntry>();
+        it->second->id = ++nextEntryId_;
+    }
+    ProductEntry& entry = *it->second;
+    if (entry.product) {
+        accountRemoveLocked(entry);
+        keepSharedObject(*entry.product, *product);
+    }
+    entry.product = std::move(product);
+    entry.bytes = bytes;
+    accountAddLocked(entry, true);
+    touch(entry);
+    if (notifier_.active()) {
+        recordChangeLocked(name, inserted ? ProductChangeType::Added : ProductChangeType::Updated, entry);
+    }
+}
+
+PipelineDataProductManager::ProductMap::iterator PipelineDataProductManager::eraseLocked(ProductMap::iterator it) {
+    accountRemoveLocked(*it->second);
+    if (notifier_.active()) recordChangeLocked(it->first, ProductChangeType::Removed, *it->second);
+    return products_.erase(it);
+}
+
+void PipelineDataProductManager::accountAddLocked(ProductEntry& entry, bool captureTags) {
+    if (captureTags) {
+        const auto& tags = entry.product->getTags();
+        entry.accountedTags.assign(tags.begin(), tags.end());
+    }
+
+    totalUsage_.bytes += entry.bytes;
+    totalUsage_.products += 1;
+    totalUsage_.highWater = std::max(totalUsage_.highWater, totalUsage_.bytes);
+    for (const auto& tag : entry.accountedTags) {
+        auto& usage = tagUsage_[tag];
+        usage.bytes += entry.bytes;
+        usage.products += 1;
+        usage.highWater = std::max(usage.highWater, usage.bytes);
+    }
+}
+
+void PipelineDataProductManager::accountRemoveLocked(const ProductEntry& entry) {
+    totalUsage_.bytes = saturatingSub(totalUsage_.bytes, entry.bytes);
+    totalUsage_.products = saturatingSub(totalUsage_.products, 1);
+    for (const auto& tag : entry.accountedTags) {
+        auto it = tagUsage_.find(tag);
+        if (it == tagUsage_.end()) continue;
+        it->second.bytes = saturatingSub(it->second.bytes, entry.bytes);
+        it->second.products = saturatingSub(it->second.products, 1);
+    }
+}
+
+bool PipelineDataProductManager::exceedsLimitsLocked(std::size_t bytes,
+                                                     const std::unordered_set<std::string>& tags,
+                                                     const ProductEntry* replaced,
+                                                     std::unordered_set<std::string>* overTags) const {
+    const std::size_t replacedBytes = replaced ? replaced->bytes : 0;
+    bool exceeded = false;
+
+    if (memoryLimits_.maxBytes > 0 &&
+        saturatingSub(totalUsage_.bytes, replacedBytes) + bytes > memoryLimits_.maxBytes) {
+        exceeded = true;
+    }
+
+    for (const auto& tag : tags) {
+        auto limit = memoryLimits_.tagLimits.find(tag);
+        if (limit == memoryLimits_.tagLimits.end()) continue;
+
+        auto usage = tagUsage_.find(tag);
+        std::size_t current = usage != tagUsage_.end() ? usage->second.bytes : 0;
+        if (replaced && std::find(replaced->accountedTags.begin(), replaced->accountedTags.end(), tag) !=
+                            replaced->accountedTags.end()) {
+            current = saturatingSub(current, replacedBytes);
+        }
+        if (current + bytes > limit->second) {
+            exceeded = true;
+            if (overTags) overTags->insert(tag);
+        }
+    }
+    return exceeded;
+}
+
+bool PipelineDataProductManager::evictForLocked(std::size_t bytes,
+                                                const std::unordered_set<std::string>& tags,
+                                                const std::string& incomingName) {
+    std::vector<std::pair<std::uint64_t, ProductMap::iterator>> candidates;
+    for (auto it = products_.begin(); it != products_.end(); ++it) {
+        if (it->first == incomingName) continue;
+        const auto& entryTags = it->second->accountedTags;
+        if (std::any_of(entryTags.begin(), entryTags.end(),
+                        [&](const std::string& tag) { return memoryLimits_.evictableTags.count(tag); })) {
+            candidates.emplace_back(it->second->lastAccess.load(std::memory_order_relaxed), it);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    auto replacedEntry = [&]() -> const ProductEntry* {
+        auto it = products_.find(incomingName);
+        return it != products_.end() && it->second->product ? it->second.get() : nullptr;
+    };
+
+    for (auto& [lastAccess, it] : candidates) {
+        std::unordered_set<std::string> overTags;
+        const ProductEntry* replaced = replacedEntry();
+        if (!exceedsLimitsLocked(bytes, tags, replaced, &overTags)) return true;
+
+        // Only evict products that reduce a limit that is actually exceeded
+        const bool totalOver = memoryLimits_.maxBytes > 0 &&
+            saturatingSub(totalUsage_.bytes, replaced ? replaced->bytes : 0) + bytes > memoryLimits_.maxBytes;
+        const auto& entryTags = it->second->accountedTags;
+        if (!totalOver && std::none_of(entryTags.begin(), entryTags.end(),
+                                       [&](const std::string& tag) { return overTags.count(tag); })) {
+            continue;
+        }
+
+        // A product that is checked out, being checked out, or held by a
+        // ProductHandle would outlive its eviction and free nothing
+        if (it->second.use_count() > 1) continue;
+        if (it->second->product && objectHeldElsewhere(*it->second->product)) continue;
+
+        spdlog::debug("[PipelineDataProductManager] Evicting '{}' ({} bytes) to stay within memory limits",
+                      it->first, it->second->bytes);
+        eraseLocked(it);
+        ++evictedProducts_;
+    }
+    return !exceedsLimitsLocked(bytes, tags, replacedEntry());
+}
+
+bool PipelineDataProductManager::admitLocked(const std::string& name, const PipelineDataProduct& product,
+                                             std::size_t bytes) {
+    if (!memoryLimits_.enabled()) return true;
+
+    auto it = products_.find(name);
+    const ProductEntry* replaced = it != products_.end() && it->second->product ? it->second.get() : nullptr;
+    if (!exceedsLimitsLocked(bytes, product.getTags(), replaced)) return true;
+
+    if (memoryLimits_.policy == MemoryLimitPolicy::EvictLru &&
+        evictForLocked(bytes, product.getTags(), name)) {
+        return true;
+    }
+
+    // Warn on the 1st, 2nd, 4th, 8th... rejection so a runaway producer does not flood the log
+    ++rejectedProducts_;
+    if ((rejectedProducts_ & (rejectedProducts_ - 1)) == 0) {
+        spdlog::warn("[PipelineDataProductManager] Rejected '{}' ({} bytes): memory limit exceeded "
+                     "({} bytes in use, {} rejections so far)",
+                     name, bytes, totalUsage_.bytes, rejectedProducts_);
+    }
+    return false;
+}
+
+void PipelineDataProductManager::setMemoryLimits(const MemoryLimitConfig& limits) {
+    std::unique_lock managerLock(managerMutex_);
+    memoryLimits_ = limits;
+    trackAccess_.store(limits.enabled() && limits.policy == MemoryLimitPolicy::EvictLru,
+                       std::memory_order_relaxed);
+}
+
+MemoryLimitConfig PipelineDataProductManager::getMemoryLimits() const {
+    std::shared_lock managerLock(managerMutex_);
+    return memoryLimits_;
+}
+
+MemoryUsageReport PipelineDataProductManager::getMemoryUsage() const {
+    std::shared_lock managerLock(managerMutex_);
+    MemoryUsageReport report;
+    report.total = totalUsage_;
+    report.byTag = tagUsage_;
+    report.byProduct.reserve(products_.size());
+    for (const auto& [name, entry] : products_) {
+        report.byProduct.emplace(name, entry->bytes);
+    }
+    report.rejected = rejectedProducts_;
+    report.evicted = evictedProducts_;
+    return report;
+}
+
+std::size_t PipelineDataProductManager::getProductBytes(const std::string& name) const {
+    std::shared_lock managerLock(managerMutex_);
+    auto it = products_.find(name);
+    return it != products_.end() ? it->second->bytes : 0;
+}
+
+void PipelineDataProductManager::refreshMemoryUsage() {
+    std::unique_lock managerLock(managerMutex_);
+
+    totalUsage_.bytes = 0;
+    totalUsage_.products = 0;
+    for (auto& [tag, usage] : tagUsage_) {
+        usage.bytes = 0;
+        usage.products = 0;
+    }
+
+    for (auto& [name, entry] : products_) {
+        // Products checked out for writing keep their previous estimate and tags
+        std::shared_lock<std::shared_mutex> productLock(entry->mutex, std::try_to_lock);
+        const bool readable = productLock.owns_lock() && entry->product;
+        if (readable) {
+            entry->bytes = ProductMemoryEstimator::estimate(*entry->product);
+        }
+        accountAddLocked(*entry, readable);
+    }
+
+    if (!memoryLimits_.enabled()) return;
+
+    std::unordered_set<std::string> limitedTags;
+    for (const auto& [tag, limit] : memoryLimits_.tagLimits) {
+        limitedTags.insert(tag);
+    }
+    const bool withinLimits =
+        memoryLimits_.policy == MemoryLimitPolicy::EvictLru && evictForLocked(0, limitedTags, "");
+    if (!withinLimits && exceedsLimitsLocked(0, limitedTags, nullptr)) {
+        spdlog::warn("[PipelineDataProductManager] Products exceed memory limits after refresh ({} bytes in use)",
+                     totalUsage_.bytes);
+    }
+    flushChanges(managerLock);
+}
+
+// ---------------------------------------------------------------------------
+// Change notifications
+// ---------------------------------------------------------------------------
+
+ProductSubscription PipelineDataProductManager::subscribe(ProductSubscriptionFilter filter,
+                                                          ProductChangeNotifier::Callback callback) {
+    return notifier_.subscribe(std::move(filter), std::move(callback));
+}
+
+ProductSubscription PipelineDataProductManager::subscribe(ProductSubscriptionFilter filter,
+                                                          std::shared_ptr<ProductChangeQueue> queue) {
+    return notifier_.subscribe(std::move(filter), std::move(queue));
+}
+
+void PipelineDataProductManager::notifyUpdated(const std::string& name) {
+    if (!notifier_.active()) return;
+    std::unique_lock managerLock(managerMutex_);
+    auto it = products_.find(name);
+    if (it == products_.end()) return;
+    recordChangeLocked(name, ProductChangeType::Updated, *it->second);
+    flushChanges(managerLock);
+}
+
+void PipelineDataProductManager::recordChangeLocked(const std::string& name, ProductChangeType type,
+                                                    const ProductEntry& entry) {
+    ProductChange change{name, type, {}};
+    // The product's current tags, read under its lock like the write handle
+    // does; accountedTags miss tags changed since the product was stored. A
+    // product checked out for writing right now reports its accounted tags.
+    std::shared_lock<std::shared_mutex> productLock(entry.mutex, std::try_to_lock);
+    if (productLock.owns_lock() && entry.product) {
+        const auto& tags = entry.product->getTags();
+        change.tags.assign(tags.begin(), tags.end());
+    } else {
+        change.tags = entry.accountedTags;
+    }
+    pendingChanges_.push_back(std::move(change));
+}
+
+void PipelineDataProductManager::flushChanges(std::unique_lock<std::shared_mutex>& managerLock) {
+    if (pendingChanges_.empty()) return;
+    std::vector<ProductChange> changes;
+    changes.swap(pendingChanges_);
+    managerLock.unlock();
+    notifier_.notify(changes);
+}
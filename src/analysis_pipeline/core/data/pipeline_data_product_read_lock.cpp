@@ -1,9 +1,22 @@
 #include "analysis_pipeline/core/data/pipeline_data_product_read_lock.h"
 
+#include <utility>
+
 PipelineDataProductReadLock::PipelineDataProductReadLock(
     PipelineDataProduct* prod,
-    std::shared_lock<std::shared_mutex>&& lock)
-    : PipelineDataProductLock(prod), lock_(std::move(lock)) {}
+    std::shared_lock<std::shared_mutex>&& lock,
+    std::shared_ptr<const void> owner)
+    : PipelineDataProductLock(prod, std::move(owner)), lock_(std::move(lock)) {}
+
+// Unlocks before the base releases the slot that owns the mutex
+PipelineDataProductReadLock& PipelineDataProductReadLock::operator=(PipelineDataProductReadLock&& other) noexcept {
+    if (this != &other) {
+        if (lock_.owns_lock()) lock_.unlock();
+        lock_ = std::move(other.lock_);
+        PipelineDataProductLock::operator=(std::move(other));
+    }
+    return *this;
+}
 
 const PipelineDataProduct* PipelineDataProductReadLock::operator->() const noexcept {
     return product_;
@@ -1,18 +1,63 @@
 #include "analysis_pipeline/core/data/pipeline_data_product_write_lock.h"
+#include "analysis_pipeline/core/data/pipeline_data_product.h"
+#include "analysis_pipeline/core/data/product_change_notifier.h"
+
+#include <utility>
 
 PipelineDataProductWriteLock::PipelineDataProductWriteLock(
     PipelineDataProduct* prod,
-    std::unique_lock<std::shared_mutex>&& lock)
-    : PipelineDataProductLock(prod), lock_(std::move(lock)) {}
+    std::unique_lock<std::shared_mutex>&& lock,
+    std::shared_ptr<const void> owner)
+    : PipelineDataProductLock(prod, std::move(owner)), lock_(std::move(lock)) {}
+
+PipelineDataProductWriteLock::PipelineDataProductWriteLock(PipelineDataProductWriteLock&& other) noexcept
+    : PipelineDataProductLock(std::move(other)),
+      lock_(std::move(other.lock_)),
+      notifier_(std::exchange(other.notifier_, nullptr)),
+      notifyName_(std::move(other.notifyName_)) {
+    other.product_ = nullptr;
+}
 
-PipelineDataProduct* PipelineDataProductWriteLock::operator->() noexcept {
-    return product_;
+PipelineDataProductWriteLock& PipelineDataProductWriteLock::operator=(PipelineDataProductWriteLock&& other) noexcept {
+    if (this != &other) {
+        release();
+        PipelineDataProductLock::operator=(std::move(other));
+        lock_ = std::move(other.lock_);
+        notifier_ = std::exchange(other.notifier_, nullptr);
+        notifyName_ = std::move(other.notifyName_);
+        other.product_ = nullptr;
+    }
+    return *this;
 }
 
-PipelineDataProduct& PipelineDataProductWriteLock::operator*() noexcept {
-    return *product_;
+PipelineDataProductWriteLock::~PipelineDataProductWriteLock() {
+    release();
 }
 
-PipelineDataProduct* PipelineDataProductWriteLock::get() noexcept {
-    return product_;
+void PipelineDataProductWriteLock::notifyOnRelease(const ProductChangeNotifier* notifier, std::string name) {
+    notifier_ = notifier;
+    notifyName_ = std::move(name);
+}
+
+void PipelineDataProductWriteLock::release() noexcept {
+    const ProductChangeNotifier* notifier = std::exchange(notifier_, nullptr);
+    if (!lock_.owns_lock()) return;
+    if (!notifier) {
+        lock_.unlock();
+        return;
+    }
+
+    // Tags are captured under the lock; subscribers run after it is released.
+    // Nothing may escape a destructor, and the notifier already logs subscriber errors.
+    try {
+        ProductChange change{std::move(notifyName_), ProductChangeType::Updated, {}};
+        if (product_) {
+            const auto& tags = product_->getTags();
+            change.tags.assign(tags.begin(), tags.end());
+        }
+        lock_.unlock();
+        notifier->notify(change);
+    } catch (...) {
+        if (lock_.owns_lock()) lock_.unlock();
+    }
 }
@@ -0,0 +1,279 @@
+#include "analysis_pipeline/core/data/product_change_notifier.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// ProductSubscriptionFilter
+// ---------------------------------------------------------------------------
+
+ProductSubscriptionFilter ProductSubscriptionFilter::forName(std::string name) {
+    ProductSubscriptionFilter filter;
+    filter.names.push_back(std::move(name));
+    return filter;
+}
+
+ProductSubscriptionFilter ProductSubscriptionFilter::forTag(std::string tag) {
+    ProductSubscriptionFilter filter;
+    filter.tags.push_back(std::move(tag));
+    return filter;
+}
+
+ProductSubscriptionFilter ProductSubscriptionFilter::forPattern(std::string pattern) {
+    ProductSubscriptionFilter filter;
+    filter.patterns.push_back(std::move(pattern));
+    return filter;
+}
+
+ProductSubscriptionFilter ProductSubscriptionFilter::fromJson(const nlohmann::json& config) {
+    ProductSubscriptionFilter filter;
+    if (config.is_null()) return filter;
+    if (!config.is_object()) {
+        throw std::runtime_error("ProductSubscriptionFilter: expected an object");
+    }
+    auto readList = [&](const char* key, std::vector<std::string>& out) {
+        if (!config.contains(key)) return;
+        if (!config[key].is_array()) {
+            throw std::runtime_error(std::string("ProductSubscriptionFilter: '") + key + "' must be an array");
+        }
+        for (const auto& item : config[key]) out.push_back(item.get<std::string>());
+    };
+    readList("names", filter.names);
+    readList("patterns", filter.patterns);
+    readList("tags", filter.tags);
+    return filter;
+}
+
+bool ProductSubscriptionFilter::globMatch(const std::string& pattern, const std::string& name) {
+    // Iterative matcher; backtracks to the most recent '*' only
+    std::size_t p = 0, n = 0;
+    std::size_t star = std::string::npos, resume = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++p;
+            ++n;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            resume = n;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            n = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+bool ProductSubscriptionFilter::matches(const ProductChange& change) const {
+    if (names.empty() && patterns.empty() && tags.empty()) return true;
+    if (std::find(names.begin(), names.end(), change.name) != names.end()) return true;
+    for (const auto& pattern : patterns) {
+        if (globMatch(pattern, change.name)) return true;
+    }
+    for (const auto& tag : change.tags) {
+        if (std::find(tags.begin(), tags.end(), tag) != tags.end()) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// ProductChangeQueue
+// ---------------------------------------------------------------------------
+
+ProductChangeQueue::ProductChangeQueue(std::size_t capacity) : capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("ProductChangeQueue: capacity must be positive");
+    }
+}
+
+ProductChangeQueue::~ProductChangeQueue() {
+#ifdef __linux__
+    if (eventFd_ >= 0) ::close(eventFd_);
+#endif
+}
+
+void ProductChangeQueue::push(const ProductChange& change) {
+    {
+        std::lock_guard lock(mutex_);
+        if (closed_) return;
+        if (pending_.size() >= capacity_) {
+            pending_.pop_front();
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        pending_.push_back(change);
+#ifdef __linux__
+        if (eventFd_ >= 0) {
+            std::uint64_t one = 1;
+            [[maybe_unused]] auto written = ::write(eventFd_, &one, sizeof(one));
+        }
+#endif
+    }
+    cv_.notify_one();
+}
+
+std::vector<ProductChange> ProductChangeQueue::takeLocked() {
+    std::vector<ProductChange> changes(std::make_move_iterator(pending_.begin()),
+                                       std::make_move_iterator(pending_.end()));
+    pending_.clear();
+#ifdef __linux__
+    if (eventFd_ >= 0) {
+        std::uint64_t count;
+        [[maybe_unused]] auto read = ::read(eventFd_, &count, sizeof(count));
+    }
+#endif
+    return changes;
+}
+
+std::vector<ProductChange> ProductChangeQueue::wait() {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return closed_ || !pending_.empty(); });
+    return takeLocked();
+}
+
+std::vector<ProductChange> ProductChangeQueue::waitFor(std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    cv_.wait_for(lock, timeout, [this] { return closed_ || !pending_.empty(); });
+    return takeLocked();
+}
+
+std::vector<ProductChange> ProductChangeQueue::drain() {
+    std::lock_guard lock(mutex_);
+    return takeLocked();
+}
+
+void ProductChangeQueue::close() {
+    {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+#ifdef __linux__
+        if (eventFd_ >= 0) {
+            std::uint64_t one = 1;
+            [[maybe_unused]] auto written = ::write(eventFd_, &one, sizeof(one));
+        }
+#endif
+    }
+    cv_.notify_all();
+}
+
+bool ProductChangeQueue::closed() const {
+    std::lock_guard lock(mutex_);
+    return closed_;
+}
+
+int ProductChangeQueue::fd() {
+#ifdef __linux__
+    std::lock_guard lock(mutex_);
+    if (eventFd_ < 0) {
+        // Non-blocking so draining an already-empty counter never stalls
+        eventFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (eventFd_ >= 0 && (closed_ || !pending_.empty())) {
+            std::uint64_t one = 1;
+            [[maybe_unused]] auto written = ::write(eventFd_, &one, sizeof(one));
+        }
+    }
+    return eventFd_;
+#else
+    return -1;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// ProductSubscription
+// ---------------------------------------------------------------------------
+
+ProductSubscription::ProductSubscription(ProductSubscription&& other) noexcept
+    : state_(std::move(other.state_)), id_(other.id_) {
+    other.id_ = 0;
+}
+
+ProductSubscription& ProductSubscription::operator=(ProductSubscription&& other) noexcept {
+    if (this != &other) {
+        unsubscribe();
+        state_ = std::move(other.state_);
+        id_ = other.id_;
+        other.id_ = 0;
+    }
+    return *this;
+}
+
+void ProductSubscription::unsubscribe() {
+    if (id_ == 0) return;
+    if (auto state = state_.lock()) {
+        std::lock_guard lock(state->mutex);
+        auto& subscribers = state->subscribers;
+        auto it = std::find_if(subscribers.begin(), subscribers.end(),
+                               [this](const auto& entry) { return entry.first == id_; });
+        if (it != subscribers.end()) {
+            subscribers.erase(it);
+            state->count.store(subscribers.size(), std::memory_order_relaxed);
+        }
+    }
+    state_.reset();
+    id_ = 0;
+}
+
+// ---------------------------------------------------------------------------
+// ProductChangeNotifier
+// ---------------------------------------------------------------------------
+
+ProductChangeNotifier::ProductChangeNotifier() : state_(std::make_shared<State>()) {}
+
+ProductSubscription ProductChangeNotifier::subscribe(ProductSubscriptionFilter filter, Callback callback) {
+    if (!callback) {
+        throw std::invalid_argument("ProductChangeNotifier: null callback");
+    }
+    auto subscriber = std::make_shared<const Subscriber>(Subscriber{std::move(filter), std::move(callback)});
+
+    std::lock_guard lock(state_->mutex);
+    const std::uint64_t id = ++state_->nextId;
+    state_->subscribers.emplace_back(id, std::move(subscriber));
+    state_->count.store(state_->subscribers.size(), std::memory_order_relaxed);
+    return ProductSubscription(state_, id);
+}
+
+ProductSubscription ProductChangeNotifier::subscribe(ProductSubscriptionFilter filter,
+                                                     std::shared_ptr<ProductChangeQueue> queue) {
+    if (!queue) {
+        throw std::invalid_argument("ProductChangeNotifier: null queue");
+    }
+    return subscribe(std::move(filter), [queue = std::move(queue)](const ProductChange& change) {
+        queue->push(change);
+    });
+}
+
+void ProductChangeNotifier::notify(const ProductChange& change) const {
+    if (!active()) return;
+    notify(std::vector<ProductChange>{change});
+}
+
+void ProductChangeNotifier::notify(const std::vector<ProductChange>& changes) const {
+    if (changes.empty() || !active()) return;
+
+    // Callbacks run without the lock so they can subscribe or unsubscribe
+    std::vector<std::shared_ptr<const Subscriber>> subscribers;
+    {
+        std::lock_guard lock(state_->mutex);
+        subscribers.reserve(state_->subscribers.size());
+        for (const auto& entry : state_->subscribers) subscribers.push_back(entry.second);
+    }
+
+    for (const auto& subscriber : subscribers) {
+        for (const auto& change : changes) {
+            if (!subscriber->filter.matches(change)) continue;
+            try {
+                subscriber->callback(change);
+            } catch (const std::exception& e) {
+                spdlog::error("[ProductChangeNotifier] Subscriber failed on '{}': {}", change.name, e.what());
+            }
+        }
+    }
+}
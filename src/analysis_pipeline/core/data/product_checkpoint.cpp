@@ -0,0 +1,538 @@
+#include "analysis_pipeline/core/data/product_checkpoint.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+#include "analysis_pipeline/core/data/product_codec.h"
+
+#include <TROOT.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace format = product_checkpoint_format;
+
+namespace {
+
+template <typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+std::uint64_t fnv1a(const void* data, std::size_t size, std::uint64_t hash = kFnvOffset) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * kFnvPrime;
+    }
+    return hash;
+}
+
+std::string fileHeader() {
+    std::string header(format::kMagic, sizeof(format::kMagic));
+    append<std::uint32_t>(header, format::kVersion);
+    append<std::uint32_t>(header, 0);
+    return header;
+}
+
+std::string removedBytes(const std::vector<std::string>& removed) {
+    std::string out;
+    for (const auto& name : removed) {
+        if (name.size() > UINT16_MAX) {
+            throw std::runtime_error("ProductCheckpoint: product name too long: " + name.substr(0, 32) + "...");
+        }
+        append<std::uint16_t>(out, static_cast<std::uint16_t>(name.size()));
+        out.append(name);
+    }
+    return out;
+}
+
+void writeSegment(std::ostream& out, const CheckpointSegment& segment, std::uint64_t& bytes) {
+    std::string removed = removedBytes(segment.removed);
+    std::size_t payloadSize = segment.records.size() + removed.size();
+    if (payloadSize > UINT32_MAX) {
+        throw std::runtime_error("ProductCheckpoint: segment exceeds 4 GiB");
+    }
+
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::string header;
+    header.reserve(format::kSegmentHeaderSize);
+    append<std::uint64_t>(header, segment.sequence);
+    append<std::uint64_t>(header, static_cast<std::uint64_t>(now));
+    append<std::uint32_t>(header, segment.recordCount);
+    append<std::uint32_t>(header, static_cast<std::uint32_t>(segment.removed.size()));
+    append<std::uint32_t>(header, static_cast<std::uint32_t>(payloadSize));
+    append<std::uint32_t>(header, 0);
+    append<std::uint64_t>(header, fnv1a(removed.data(), removed.size(),
+                                        fnv1a(segment.records.data(), segment.records.size())));
+
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(segment.records.data(), static_cast<std::streamsize>(segment.records.size()));
+    out.write(removed.data(), static_cast<std::streamsize>(removed.size()));
+    bytes += header.size() + payloadSize;
+}
+
+bool isAtomicProduct(const PipelineDataProduct& product) {
+    // Only look at objects already in memory; a deferred one has not changed
+    if (!product.isLoaded()) return false;
+    TObject* object = product.getObject();
+    return dynamic_cast<AtomicCounter*>(object) || dynamic_cast<AtomicAccumulator*>(object);
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// ProductCheckpointWriter
+
+ProductCheckpointWriter::ProductCheckpointWriter(std::string path) : path_(std::move(path)) {}
+
+void ProductCheckpointWriter::writeFull(const CheckpointSegment& segment) {
+    out_.close();
+
+    const std::string tmpPath = path_ + ".tmp";
+    std::uint64_t bytes = 0;
+    {
+        std::ofstream tmp(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!tmp) {
+            throw std::runtime_error("ProductCheckpointWriter: cannot open '" + tmpPath + "'");
+        }
+        std::string header = fileHeader();
+        tmp.write(header.data(), static_cast<std::streamsize>(header.size()));
+        bytes += header.size();
+        writeSegment(tmp, segment, bytes);
+        tmp.flush();
+        if (!tmp) {
+            std::remove(tmpPath.c_str());
+            throw std::runtime_error("ProductCheckpointWriter: write to '" + tmpPath + "' failed");
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path_, ec);
+    if (ec) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("ProductCheckpointWriter: cannot rename '" + tmpPath + "': " + ec.message());
+    }
+
+    fileBytes_ = bytes;
+    out_.open(path_, std::ios::binary | std::ios::app);
+    if (!out_) {
+        throw std::runtime_error("ProductCheckpointWriter: cannot reopen '" + path_ + "' for appending");
+    }
+}
+
+void ProductCheckpointWriter::append(const CheckpointSegment& segment, std::uint64_t validBytes) {
+    if (!out_.is_open()) {
+        std::error_code ec;
+        const std::uint64_t size = std::filesystem::file_size(path_, ec);
+        if (ec || size < format::kFileHeaderSize) {
+            // Nothing to append to yet; never truncate what is there in place
+            writeFull(segment);
+            return;
+        }
+        openForAppend(validBytes, size);
+    }
+
+    std::uint64_t bytes = 0;
+    writeSegment(out_, segment, bytes);
+    out_.flush();
+    if (!out_) {
+        out_.close();
+        throw std::runtime_error("ProductCheckpointWriter: append to '" + path_ + "' failed");
+    }
+    fileBytes_ += bytes;
+}
+
+void ProductCheckpointWriter::openForAppend(std::uint64_t validBytes, std::uint64_t fileSize) {
+    if (validBytes > 0 && validBytes < fileSize) {
+        if (validBytes < format::kFileHeaderSize) {
+            throw std::invalid_argument("ProductCheckpointWriter: valid length " + std::to_string(validBytes) +
+                                        " of '" + path_ + "' is shorter than the file header");
+        }
+        std::error_code ec;
+        std::filesystem::resize_file(path_, validBytes, ec);
+        if (ec) {
+            throw std::runtime_error("ProductCheckpointWriter: cannot truncate '" + path_ + "': " + ec.message());
+        }
+        fileSize = validBytes;
+    }
+    fileBytes_ = fileSize;
+
+    out_.open(path_, std::ios::binary | std::ios::app);
+    if (!out_) {
+        throw std::runtime_error("ProductCheckpointWriter: cannot open '" + path_ + "'");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ProductCheckpointReader
+
+ProductCheckpointReader::ProductCheckpointReader(const std::string& path) : file_(MappedFile::open(path)) {
+    ByteView bytes(file_->data(), file_->size());
+    if (bytes.size() < format::kFileHeaderSize ||
+        std::memcmp(bytes.data(), format::kMagic, sizeof(format::kMagic)) != 0) {
+        throw std::runtime_error("ProductCheckpointReader: '" + path + "' is not a checkpoint file");
+    }
+    auto version = bytes.read<std::uint32_t>(sizeof(format::kMagic));
+    if (version != format::kVersion) {
+        throw std::runtime_error("ProductCheckpointReader: '" + path + "' has unsupported version " +
+                                 std::to_string(version));
+    }
+
+    std::unordered_map<std::string, Record> live;
+    std::size_t pos = format::kFileHeaderSize;
+    validBytes_ = pos;
+
+    while (bytes.size() - pos >= format::kSegmentHeaderSize) {
+        auto sequence = bytes.read<std::uint64_t>(pos);
+        auto recordCount = bytes.read<std::uint32_t>(pos + 16);
+        auto removedCount = bytes.read<std::uint32_t>(pos + 20);
+        auto payloadSize = bytes.read<std::uint32_t>(pos + 24);
+        auto checksum = bytes.read<std::uint64_t>(pos + 32);
+
+        const std::size_t payloadStart = pos + format::kSegmentHeaderSize;
+        if (payloadSize > bytes.size() - payloadStart) break;  // torn write
+        ByteView payload = bytes.subview(payloadStart, payloadSize);
+        if (fnv1a(payload.data(), payload.size()) != checksum) break;
+
+        // Apply a segment only once all of it has parsed
+        std::vector<Record> added;
+        std::vector<std::string> removed;
+        try {
+            std::size_t offset = 0;
+            for (std::uint32_t i = 0; i < recordCount; ++i) {
+                Record record;
+                record.name = ProductCodec::peekName(payload, offset);
+                record.size = ProductCodec::recordSize(payload, offset);
+                record.offset = payloadStart + offset;
+                offset += record.size;
+                added.push_back(std::move(record));
+            }
+            for (std::uint32_t i = 0; i < removedCount; ++i) {
+                auto length = payload.read<std::uint16_t>(offset);
+                ByteView name = payload.subview(offset + 2, length);
+                removed.emplace_back(reinterpret_cast<const char*>(name.data()), name.size());
+                offset += 2 + length;
+            }
+            if (offset != payload.size()) break;
+        } catch (const std::out_of_range&) {
+            break;
+        }
+
+        for (auto& record : added) {
+            live[record.name] = std::move(record);
+        }
+        for (const auto& name : removed) {
+            live.erase(name);
+        }
+        ++segments_;
+        lastSequence_ = sequence;
+        pos = payloadStart + payloadSize;
+        validBytes_ = pos;
+    }
+
+    if (validBytes_ < bytes.size()) {
+        spdlog::warn("ProductCheckpointReader: ignoring {} bytes of incomplete data at the end of '{}'",
+                     bytes.size() - validBytes_, path);
+    }
+
+    records_.reserve(live.size());
+    for (auto& [name, record] : live) {
+        liveBytes_ += record.size;
+        records_.push_back(std::move(record));
+    }
+    // File order, so a full restore reads the mapping front to back
+    std::sort(records_.begin(), records_.end(),
+              [](const Record& a, const Record& b) { return a.offset < b.offset; });
+}
+
+ByteView ProductCheckpointReader::recordBytes(const Record& record) const {
+    return ByteView(file_->data(), file_->size()).subview(record.offset, record.size);
+}
+
+std::unique_ptr<PipelineDataProduct> ProductCheckpointReader::decode(const Record& record, bool lazy) const {
+    ByteView bytes(file_->data(), file_->size());
+    std::size_t offset = record.offset;
+    if (lazy) {
+        return ProductCodec::decodeLazy(bytes, offset, file_);
+    }
+    return ProductCodec::decode(bytes, offset);
+}
+
+std::size_t ProductCheckpointReader::restoreInto(PipelineDataProductManager& manager, bool lazy) const {
+    std::vector<std::pair<std::string, std::unique_ptr<PipelineDataProduct>>> products;
+    products.reserve(records_.size());
+    for (const auto& record : records_) {
+        try {
+            products.emplace_back(record.name, decode(record, lazy));
+        } catch (const std::exception& e) {
+            spdlog::error("ProductCheckpointReader: cannot restore '{}': {}", record.name, e.what());
+        }
+    }
+
+    std::size_t restored = products.size();
+    manager.addOrUpdateMultiple(std::move(products));
+    return restored;
+}
+
+// ---------------------------------------------------------------------------
+// ProductCheckpointConfig
+
+ProductCheckpointConfig ProductCheckpointConfig::fromJson(const nlohmann::json& config) {
+    ProductCheckpointConfig result;
+    result.path = config.value("file", "");
+    result.compactRatio = config.value("compact_ratio", result.compactRatio);
+    result.selection = ProductSelection::fromJson(config, "ProductCheckpointConfig");
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// ProductCheckpointer
+
+ProductCheckpointer::ProductCheckpointer(PipelineDataProductManager& manager, ProductCheckpointConfig config)
+    : manager_(manager),
+      config_(std::move(config)),
+      writer_(config_.path),
+      changes_(std::make_shared<ChangeSet>()) {
+    if (config_.path.empty()) {
+        throw std::runtime_error("ProductCheckpointer: a file path is required");
+    }
+    if (config_.compactRatio < 1.0) {
+        throw std::runtime_error("ProductCheckpointer: compact_ratio must be at least 1");
+    }
+
+    ProductSubscriptionFilter filter;
+    filter.names = config_.selection.names;
+    filter.tags.assign(config_.selection.tags.begin(), config_.selection.tags.end());
+    subscription_ = manager_.subscribe(std::move(filter), [changes = changes_](const ProductChange& change) {
+        std::lock_guard lock(changes->mutex);
+        if (change.type == ProductChangeType::Removed) {
+            changes->changed.erase(change.name);
+            changes->removed.insert(change.name);
+        } else {
+            changes->removed.erase(change.name);
+            changes->changed.insert(change.name);
+        }
+    });
+
+    // Continue an existing checkpoint rather than rewriting it
+    std::error_code ec;
+    if (std::filesystem::exists(config_.path, ec)) {
+        try {
+            ProductCheckpointReader reader(config_.path);
+            if (reader.segmentCount() > 0) {
+                nextSequence_ = reader.lastSequence() + 1;
+                validBytes_ = reader.validBytes();
+                for (const auto& record : reader.records()) {
+                    recordBytes_[record.name] = record.size;
+                }
+                liveBytes_ = reader.liveBytes();
+                needFull_ = false;
+            }
+        } catch (const std::exception& e) {
+            spdlog::warn("ProductCheckpointer: not continuing '{}': {}", config_.path, e.what());
+        }
+    }
+
+    // Everything selected is pending, except deferred products: those were just
+    // restored and still match their records. Records of products the manager
+    // no longer holds are removed.
+    {
+        std::lock_guard lock(changes_->mutex);
+        for (const auto& name : config_.selection.resolve(manager_)) {
+            auto handle = manager_.tryCheckoutRead(name);
+            if (handle && handle->isLoaded()) changes_->changed.insert(name);
+        }
+        for (const auto& [name, size] : recordBytes_) {
+            if (!manager_.hasProduct(name)) changes_->removed.insert(name);
+        }
+    }
+
+    // Objects are streamed on the checkpoint thread
+    ROOT::EnableThreadSafety();
+    thread_ = std::thread(&ProductCheckpointer::run, this);
+}
+
+ProductCheckpointer::~ProductCheckpointer() {
+    // No final checkpoint here: the manager may already be destroyed (see finish)
+    stopThread();
+    subscription_.unsubscribe();
+}
+
+void ProductCheckpointer::stopThread() {
+    {
+        std::lock_guard lock(threadMutex_);
+        stopping_ = true;
+    }
+    threadCv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void ProductCheckpointer::finish() {
+    stopThread();
+    if (finished_) return;
+    finished_ = true;
+
+    try {
+        checkpointNow();
+    } catch (const std::exception& e) {
+        spdlog::error("ProductCheckpointer: final checkpoint of '{}' failed: {}", config_.path, e.what());
+    }
+    subscription_.unsubscribe();
+}
+
+void ProductCheckpointer::request() {
+    {
+        std::lock_guard lock(threadMutex_);
+        requested_ = true;
+    }
+    threadCv_.notify_one();
+}
+
+std::size_t ProductCheckpointer::checkpointNow() {
+    std::lock_guard lock(writeMutex_);
+    return writeCheckpoint();
+}
+
+ProductCheckpointer::Stats ProductCheckpointer::stats() const {
+    std::lock_guard lock(statsMutex_);
+    return stats_;
+}
+
+void ProductCheckpointer::run() {
+    std::unique_lock lock(threadMutex_);
+    while (true) {
+        threadCv_.wait(lock, [this] { return requested_ || stopping_; });
+        if (stopping_) return;
+        requested_ = false;
+        lock.unlock();
+
+        try {
+            std::lock_guard writeLock(writeMutex_);
+            writeCheckpoint();
+        } catch (const std::exception& e) {
+            spdlog::error("ProductCheckpointer: checkpoint of '{}' failed: {}", config_.path, e.what());
+        }
+
+        lock.lock();
+    }
+}
+
+std::size_t ProductCheckpointer::writeCheckpoint() {
+    auto start = std::chrono::steady_clock::now();
+
+    std::unordered_set<std::string> changed;
+    std::unordered_set<std::string> removed;
+    {
+        std::lock_guard lock(changes_->mutex);
+        changed.swap(changes_->changed);
+        removed.swap(changes_->removed);
+    }
+
+    // Lock-free counters change without notifications
+    auto selected = config_.selection.resolve(manager_);
+    for (const auto& name : selected) {
+        if (changed.count(name)) continue;
+        auto handle = manager_.tryCheckoutRead(name);
+        if (handle && isAtomicProduct(*handle)) changed.insert(name);
+    }
+
+    const bool full = needFull_ ||
+                      (liveBytes_ > 0 && writer_.fileBytes() > config_.compactRatio * static_cast<double>(liveBytes_));
+
+    CheckpointSegment segment;
+    segment.sequence = nextSequence_;
+    std::unordered_map<std::string, std::uint64_t> written;
+
+    auto encode = [&](const std::string& name) {
+        auto handle = manager_.tryCheckoutRead(name);
+        if (!handle || !config_.selection.matches(name, handle->getTags()) || !handle->getObject()) return;
+        std::size_t before = segment.records.size();
+        ProductCodec::encode(*handle, segment.records);
+        written[name] = segment.records.size() - before;
+        ++segment.recordCount;
+    };
+
+    try {
+        if (full) {
+            // Unchanged products are copied from the current file as stored
+            std::unique_ptr<ProductCheckpointReader> previous;
+            if (!recordBytes_.empty()) {
+                try {
+                    previous = std::make_unique<ProductCheckpointReader>(config_.path);
+                } catch (const std::exception& e) {
+                    spdlog::warn("ProductCheckpointer: re-encoding every product, cannot read '{}': {}",
+                                 config_.path, e.what());
+                }
+            }
+            std::unordered_map<std::string, const ProductCheckpointReader::Record*> stored;
+            if (previous) {
+                for (const auto& record : previous->records()) stored[record.name] = &record;
+            }
+
+            for (const auto& name : selected) {
+                auto it = stored.find(name);
+                if (!changed.count(name) && it != stored.end()) {
+                    ByteView bytes = previous->recordBytes(*it->second);
+                    segment.records.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+                    written[name] = bytes.size();
+                    ++segment.recordCount;
+                } else {
+                    encode(name);
+                }
+            }
+            writer_.writeFull(segment);
+
+            recordBytes_ = written;
+            needFull_ = false;
+            validBytes_ = 0;
+        } else {
+            for (const auto& name : changed) encode(name);
+            for (const auto& name : removed) {
+                if (recordBytes_.count(name) && !written.count(name)) segment.removed.push_back(name);
+            }
+            if (segment.recordCount == 0 && segment.removed.empty()) return 0;
+
+            writer_.append(segment, validBytes_);
+            validBytes_ = 0;
+
+            for (const auto& name : segment.removed) recordBytes_.erase(name);
+            for (const auto& [name, size] : written) recordBytes_[name] = size;
+        }
+    } catch (...) {
+        // Keep the changes for the next attempt, which rewrites the file in
+        // case this one left a partial segment behind
+        {
+            std::lock_guard lock(changes_->mutex);
+            changes_->changed.insert(changed.begin(), changed.end());
+            changes_->removed.insert(removed.begin(), removed.end());
+        }
+        needFull_ = true;
+        std::lock_guard lock(statsMutex_);
+        ++stats_.failures;
+        throw;
+    }
+
+    liveBytes_ = 0;
+    for (const auto& [name, size] : recordBytes_) liveBytes_ += size;
+    ++nextSequence_;
+
+    std::uint64_t bytes = segment.records.size();
+    {
+        std::lock_guard lock(statsMutex_);
+        ++stats_.checkpoints;
+        if (full) ++stats_.fullCheckpoints;
+        stats_.productsWritten += segment.recordCount;
+        stats_.bytesWritten += bytes;
+        stats_.lastDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+    }
+    spdlog::debug("ProductCheckpointer: {} checkpoint {} of '{}': {} products, {} removed, {} bytes",
+                  full ? "full" : "incremental", segment.sequence, config_.path,
+                  segment.recordCount, segment.removed.size(), bytes);
+    return segment.recordCount;
+}
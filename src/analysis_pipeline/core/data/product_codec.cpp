@@ -0,0 +1,130 @@
+#include "analysis_pipeline/core/data/product_codec.h"
+
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <TH1.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+template <typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendString16(std::string& out, const std::string& s) {
+    if (s.size() > UINT16_MAX) {
+        throw std::runtime_error("ProductCodec: string too long to encode: " + s.substr(0, 32) + "...");
+    }
+    append<std::uint16_t>(out, static_cast<std::uint16_t>(s.size()));
+    out.append(s);
+}
+
+std::string readString16(ByteView bytes, std::size_t& offset) {
+    auto length = bytes.read<std::uint16_t>(offset);
+    ByteView s = bytes.subview(offset + 2, length);
+    offset += 2 + length;
+    return std::string(reinterpret_cast<const char*>(s.data()), s.size());
+}
+
+}  // namespace
+
+void ProductCodec::encode(const PipelineDataProduct& product, std::string& out) {
+    TObject* obj = product.getObject();
+    if (!obj) {
+        throw std::runtime_error("ProductCodec: product '" + product.getName() + "' has no object");
+    }
+
+    // Checked before anything is appended, so a rejected product leaves `out` unchanged
+    const auto& tags = product.getTags();
+    if (tags.size() > UINT16_MAX) {
+        throw std::runtime_error("ProductCodec: product '" + product.getName() + "' has too many tags to encode (" +
+                                 std::to_string(tags.size()) + ")");
+    }
+
+    const std::size_t start = out.size();
+    append<std::uint32_t>(out, 0);  // patched below
+
+    appendString16(out, product.getName());
+
+    append<std::uint16_t>(out, static_cast<std::uint16_t>(tags.size()));
+    for (const auto& tag : tags) {
+        appendString16(out, tag);
+    }
+
+    TBufferFile buffer(TBuffer::kWrite);
+    buffer.WriteObject(obj);
+    append<std::uint32_t>(out, static_cast<std::uint32_t>(buffer.Length()));
+    out.append(buffer.Buffer(), static_cast<std::size_t>(buffer.Length()));
+
+    auto recordSize = static_cast<std::uint32_t>(out.size() - start - sizeof(std::uint32_t));
+    std::memcpy(&out[start], &recordSize, sizeof(recordSize));
+}
+
+std::unique_ptr<PipelineDataProduct> ProductCodec::decode(ByteView bytes, std::size_t& offset) {
+    ByteView objectBytes;
+    auto product = decodeHeader(bytes, offset, objectBytes);
+    product->setObject(decodeObject(objectBytes, product->getName()));
+    return product;
+}
+
+std::unique_ptr<PipelineDataProduct> ProductCodec::decodeLazy(ByteView bytes, std::size_t& offset,
+                                                              std::shared_ptr<const void> owner) {
+    ByteView objectBytes;
+    auto product = decodeHeader(bytes, offset, objectBytes);
+    std::string name = product->getName();
+    product->setLazyObject(
+        [objectBytes, owner = std::move(owner), name = std::move(name)] { return decodeObject(objectBytes, name); },
+        objectBytes.size());
+    return product;
+}
+
+std::unique_ptr<PipelineDataProduct> ProductCodec::decodeHeader(ByteView bytes, std::size_t& offset,
+                                                                ByteView& objectBytes) {
+    auto size = bytes.read<std::uint32_t>(offset);
+    ByteView record = bytes.subview(offset + sizeof(std::uint32_t), size);
+
+    std::size_t pos = 0;
+    auto product = std::make_unique<PipelineDataProduct>();
+    product->setName(readString16(record, pos));
+
+    auto tagCount = record.read<std::uint16_t>(pos);
+    pos += sizeof(std::uint16_t);
+    for (std::uint16_t i = 0; i < tagCount; ++i) {
+        product->addTag(readString16(record, pos));
+    }
+
+    auto objectLength = record.read<std::uint32_t>(pos);
+    objectBytes = record.subview(pos + sizeof(std::uint32_t), objectLength);
+
+    offset += sizeof(std::uint32_t) + size;
+    return product;
+}
+
+std::unique_ptr<TObject> ProductCodec::decodeObject(ByteView objectBytes, const std::string& name) {
+    // TBufferFile needs a mutable pointer but does not write to a buffer it does not adopt
+    TBufferFile buffer(TBuffer::kRead, static_cast<int>(objectBytes.size()),
+                       const_cast<std::uint8_t*>(objectBytes.data()), false);
+    TObject* obj = buffer.ReadObject(TObject::Class());
+    if (!obj) {
+        throw std::runtime_error("ProductCodec: failed to deserialize object for '" + name + "'");
+    }
+
+    // Histograms attach themselves to gDirectory when streamed in; products own them instead
+    if (auto* hist = dynamic_cast<TH1*>(obj)) {
+        hist->SetDirectory(nullptr);
+    }
+    return std::unique_ptr<TObject>(obj);
+}
+
+std::string ProductCodec::peekName(ByteView bytes, std::size_t offset) {
+    auto size = bytes.read<std::uint32_t>(offset);
+    ByteView record = bytes.subview(offset + sizeof(std::uint32_t), size);
+    std::size_t pos = 0;
+    return readString16(record, pos);
+}
+
+std::size_t ProductCodec::recordSize(ByteView bytes, std::size_t offset) {
+    return sizeof(std::uint32_t) + bytes.read<std::uint32_t>(offset);
+}
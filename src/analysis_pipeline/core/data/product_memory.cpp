@@ -0,0 +1,192 @@
+#include "analysis_pipeline/core/data/product_memory.h"
+#include "analysis_pipeline/core/data/pipeline_data_product.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+#include "analysis_pipeline/core/data/products/quantile_sketch.h"
+#include "analysis_pipeline/core/data/products/raw_event_product.h"
+#include "analysis_pipeline/core/data/products/value_batch.h"
+#include "analysis_pipeline/core/data/products/windowed_th1d.h"
+
+#include <TArrayC.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+#include <TArrayL64.h>
+#include <TArrayS.h>
+#include <TClass.h>
+#include <TH1.h>
+#include <TParameter.h>
+
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Registry {
+    std::shared_mutex mutex;
+    std::vector<std::pair<TClass*, ProductMemoryEstimator::Estimator>> estimators;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Bytes held by a TArray base, e.g. the bin contents of a TH1D
+std::size_t arrayBytes(const TObject& object) {
+    if (auto* a = dynamic_cast<const TArrayD*>(&object)) return a->GetSize() * sizeof(Double_t);
+    if (auto* a = dynamic_cast<const TArrayF*>(&object)) return a->GetSize() * sizeof(Float_t);
+    if (auto* a = dynamic_cast<const TArrayI*>(&object)) return a->GetSize() * sizeof(Int_t);
+    if (auto* a = dynamic_cast<const TArrayL64*>(&object)) return a->GetSize() * sizeof(Long64_t);
+    if (auto* a = dynamic_cast<const TArrayS*>(&object)) return a->GetSize() * sizeof(Short_t);
+    if (auto* a = dynamic_cast<const TArrayC*>(&object)) return a->GetSize() * sizeof(Char_t);
+    return 0;
+}
+
+std::size_t classSize(const TObject& object) {
+    TClass* cls = object.IsA();
+    return cls ? static_cast<std::size_t>(cls->Size()) : sizeof(TObject);
+}
+
+std::size_t parseBytes(const nlohmann::json& value, const std::string& what) {
+    if (!value.is_number_unsigned() && !(value.is_number_integer() && value.get<long long>() >= 0)) {
+        throw std::runtime_error("MemoryLimitConfig: '" + what + "' must be a non-negative byte count");
+    }
+    return value.get<std::size_t>();
+}
+
+}  // namespace
+
+std::size_t ProductMemoryEstimator::estimate(const PipelineDataProduct& product) {
+    std::size_t bytes = sizeof(PipelineDataProduct) + product.getName().capacity();
+    for (const auto& tag : product.getTags()) {
+        bytes += sizeof(tag) + tag.capacity();
+    }
+    if (!product.isLoaded()) {
+        // Do not force a deferred object in just to measure it
+        bytes += product.lazySizeHint();
+    } else if (TObject* object = product.getObject()) {
+        bytes += estimate(*object);
+    }
+    return bytes;
+}
+
+std::size_t ProductMemoryEstimator::estimate(const TObject& object) {
+    {
+        auto& reg = registry();
+        std::shared_lock lock(reg.mutex);
+        TClass* cls = object.IsA();
+        for (auto it = reg.estimators.rbegin(); it != reg.estimators.rend(); ++it) {
+            if (cls && cls->InheritsFrom(it->first)) return it->second(object);
+        }
+    }
+
+    if (auto* windowed = dynamic_cast<const WindowedTH1D*>(&object)) {
+        // Running sum plus per-slice content and sum of squares
+        const auto cells = static_cast<std::size_t>(windowed->GetNcells());
+        return classSize(object) + arrayBytes(object) +
+               static_cast<std::size_t>(windowed->GetSumw2N()) * sizeof(Double_t) +
+               windowed->sliceCount() * 2 * cells * sizeof(double);
+    }
+    if (auto* hist = dynamic_cast<const TH1*>(&object)) {
+        return classSize(object) + arrayBytes(object) +
+               static_cast<std::size_t>(hist->GetSumw2N()) * sizeof(Double_t);
+    }
+    if (auto* batch = dynamic_cast<const ValueBatch*>(&object)) {
+        return sizeof(ValueBatch) + batch->values().capacity() * sizeof(double);
+    }
+    if (auto* sketch = dynamic_cast<const QuantileSketch*>(&object)) {
+        return sizeof(QuantileSketch) + sketch->retained() * sizeof(double);
+    }
+    if (auto* raw = dynamic_cast<const RawEventProduct*>(&object)) {
+        return sizeof(RawEventProduct) + (raw->buffer() ? raw->buffer()->size() : 0);
+    }
+    return classSize(object) + arrayBytes(object);
+}
+
+void ProductMemoryEstimator::registerEstimator(TClass* cls, Estimator estimator) {
+    if (!cls || !estimator) {
+        throw std::invalid_argument("ProductMemoryEstimator: null class or estimator");
+    }
+    auto& reg = registry();
+    std::unique_lock lock(reg.mutex);
+    reg.estimators.emplace_back(cls, std::move(estimator));
+}
+
+MemoryLimitConfig MemoryLimitConfig::fromJson(const nlohmann::json& config) {
+    MemoryLimitConfig result;
+    if (config.is_null()) return result;
+    if (!config.is_object()) {
+        throw std::runtime_error("MemoryLimitConfig: expected an object");
+    }
+
+    if (config.contains("max_bytes")) {
+        result.maxBytes = parseBytes(config["max_bytes"], "max_bytes");
+    }
+    if (config.contains("tag_limits")) {
+        if (!config["tag_limits"].is_object()) {
+            throw std::runtime_error("MemoryLimitConfig: 'tag_limits' must be an object");
+        }
+        for (const auto& [tag, limit] : config["tag_limits"].items()) {
+            result.tagLimits[tag] = parseBytes(limit, "tag_limits." + tag);
+        }
+    }
+
+    const std::string policy = config.value("policy", "reject");
+    if (policy == "reject") {
+        result.policy = MemoryLimitPolicy::Reject;
+    } else if (policy == "evict_lru") {
+        result.policy = MemoryLimitPolicy::EvictLru;
+    } else {
+        throw std::runtime_error("MemoryLimitConfig: unknown policy '" + policy + "'");
+    }
+
+    if (config.contains("evictable_tags")) {
+        for (const auto& tag : config["evictable_tags"]) {
+            result.evictableTags.insert(tag.get<std::string>());
+        }
+    }
+    if (result.policy == MemoryLimitPolicy::EvictLru && result.evictableTags.empty()) {
+        throw std::runtime_error("MemoryLimitConfig: evict_lru requires 'evictable_tags'");
+    }
+    return result;
+}
+
+nlohmann::json MemoryUsageReport::toJson() const {
+    nlohmann::json out;
+    out["total"] = {{"bytes", total.bytes}, {"high_water", total.highWater}, {"products", total.products}};
+    out["by_tag"] = nlohmann::json::object();
+    for (const auto& [tag, usage] : byTag) {
+        out["by_tag"][tag] = {{"bytes", usage.bytes}, {"high_water", usage.highWater}, {"products", usage.products}};
+    }
+    out["by_product"] = byProduct;
+    out["rejected"] = rejected;
+    out["evicted"] = evicted;
+    return out;
+}
+
+void MemoryUsageReport::publish(PipelineDataProductManager& manager, const std::string& prefix) const {
+    std::vector<std::pair<std::string, std::unique_ptr<PipelineDataProduct>>> products;
+
+    auto add = [&](const std::string& name, std::uint64_t value) {
+        auto product = std::make_unique<PipelineDataProduct>();
+        product->setName(name);
+        product->setObject(std::make_unique<TParameter<Long64_t>>(name.c_str(), static_cast<Long64_t>(value)));
+        product->addTag("memory");
+        products.emplace_back(name, std::move(product));
+    };
+
+    add(prefix + "total_bytes", total.bytes);
+    add(prefix + "high_water_bytes", total.highWater);
+    add(prefix + "products", total.products);
+    add(prefix + "rejected", rejected);
+    add(prefix + "evicted", evicted);
+    for (const auto& [tag, usage] : byTag) {
+        add(prefix + "tag/" + tag + "/bytes", usage.bytes);
+        add(prefix + "tag/" + tag + "/high_water_bytes", usage.highWater);
+    }
+
+    manager.addOrUpdateMultiple(std::move(products));
+}
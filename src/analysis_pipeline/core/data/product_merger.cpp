@@ -0,0 +1,29 @@
+#include "analysis_pipeline/core/data/product_merger.h"
+
+#include <TClass.h>
+#include <TH1.h>
+#include <TList.h>
+
+bool ProductMerger::isMergeable(const TObject& obj) {
+    TClass* cls = obj.IsA();
+    return cls && cls->GetMerge() != nullptr;
+}
+
+bool ProductMerger::merge(TObject& target, const TObject& source) {
+    TClass* cls = target.IsA();
+    ROOT::MergeFunc_t mergeFunc = cls ? cls->GetMerge() : nullptr;
+    if (!mergeFunc) return false;
+
+    // The list does not own its elements; Merge only reads from them
+    TList sources;
+    sources.Add(const_cast<TObject*>(&source));
+    return mergeFunc(&target, &sources, nullptr) >= 0;
+}
+
+std::unique_ptr<TObject> ProductMerger::clone(const TObject& obj) {
+    std::unique_ptr<TObject> copy(obj.Clone());
+    if (auto* hist = dynamic_cast<TH1*>(copy.get())) {
+        hist->SetDirectory(nullptr);
+    }
+    return copy;
+}
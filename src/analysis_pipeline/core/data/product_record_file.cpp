@@ -0,0 +1,88 @@
+#include "analysis_pipeline/core/data/product_record_file.h"
+#include "analysis_pipeline/core/data/product_codec.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+template <typename T>
+void writePod(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+ProductRecordWriter::ProductRecordWriter(const std::string& path)
+    : out_(path, std::ios::binary | std::ios::trunc) {
+    if (!out_) {
+        throw std::runtime_error("ProductRecordWriter: cannot open '" + path + "' for writing");
+    }
+    out_.write(product_record_format::kMagic, sizeof(product_record_format::kMagic));
+    writePod<std::uint32_t>(out_, product_record_format::kVersion);
+    writePod<std::uint32_t>(out_, 0);
+}
+
+void ProductRecordWriter::writeFrame(std::uint64_t eventNumber, std::uint32_t productCount, const std::string& records) {
+    if (records.size() > UINT32_MAX) {
+        throw std::runtime_error("ProductRecordWriter: frame too large");
+    }
+    writePod<std::uint64_t>(out_, eventNumber);
+    writePod<std::uint32_t>(out_, productCount);
+    writePod<std::uint32_t>(out_, static_cast<std::uint32_t>(records.size()));
+    out_.write(records.data(), static_cast<std::streamsize>(records.size()));
+    if (!out_) {
+        throw std::runtime_error("ProductRecordWriter: write failed");
+    }
+    ++framesWritten_;
+}
+
+void ProductRecordWriter::flush() {
+    out_.flush();
+}
+
+void ProductRecordWriter::close() {
+    out_.close();
+}
+
+ProductRecordReader::ProductRecordReader(const std::string& path)
+    : file_(MappedFile::open(path)) {
+    ByteView bytes(file_->data(), file_->size());
+
+    if (bytes.size() < product_record_format::kFileHeaderSize ||
+        std::memcmp(bytes.data(), product_record_format::kMagic, sizeof(product_record_format::kMagic)) != 0) {
+        throw std::runtime_error("ProductRecordReader: '" + path + "' is not a product record file");
+    }
+    auto version = bytes.read<std::uint32_t>(8);
+    if (version != product_record_format::kVersion) {
+        throw std::runtime_error("ProductRecordReader: unsupported version " + std::to_string(version));
+    }
+
+    std::size_t offset = product_record_format::kFileHeaderSize;
+    while (offset + product_record_format::kFrameHeaderSize <= bytes.size()) {
+        Frame frame;
+        frame.eventNumber = bytes.read<std::uint64_t>(offset);
+        frame.productCount = bytes.read<std::uint32_t>(offset + 8);
+        frame.size = bytes.read<std::uint32_t>(offset + 12);
+        frame.offset = offset + product_record_format::kFrameHeaderSize;
+
+        if (frame.size > bytes.size() - frame.offset) {
+            throw std::runtime_error("ProductRecordReader: truncated frame at offset " + std::to_string(offset));
+        }
+        frames_.push_back(frame);
+        offset = frame.offset + frame.size;
+    }
+}
+
+std::vector<std::unique_ptr<PipelineDataProduct>> ProductRecordReader::readFrame(std::size_t index) const {
+    const Frame& f = frames_.at(index);
+    ByteView records(file_->data() + f.offset, f.size);
+
+    std::vector<std::unique_ptr<PipelineDataProduct>> products;
+    products.reserve(f.productCount);
+    std::size_t offset = 0;
+    for (std::uint32_t i = 0; i < f.productCount; ++i) {
+        products.push_back(ProductCodec::decode(records, offset));
+    }
+    return products;
+}
@@ -0,0 +1,50 @@
+#include "analysis_pipeline/core/data/product_selection.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+ProductSelection ProductSelection::fromJson(const nlohmann::json& config, const std::string& owner) {
+    ProductSelection selection;
+    if (config.contains("products")) {
+        if (!config["products"].is_array()) {
+            throw std::runtime_error(owner + ": 'products' must be an array");
+        }
+        for (const auto& name : config["products"]) {
+            selection.names.emplace_back(name.get<std::string>());
+        }
+    }
+    if (config.contains("tags")) {
+        if (!config["tags"].is_array()) {
+            throw std::runtime_error(owner + ": 'tags' must be an array");
+        }
+        for (const auto& tag : config["tags"]) {
+            selection.tags.insert(tag.get<std::string>());
+        }
+    }
+    return selection;
+}
+
+std::vector<std::string> ProductSelection::resolve(const PipelineDataProductManager& manager) const {
+    if (selectsAll()) {
+        return manager.getAllNames();
+    }
+
+    std::unordered_set<std::string> selected;
+    auto existing = manager.getExistingProducts(names);
+    selected.insert(existing.begin(), existing.end());
+    if (!tags.empty()) {
+        auto tagged = manager.getNamesWithAnyTags(tags);
+        selected.insert(tagged.begin(), tagged.end());
+    }
+    return std::vector<std::string>(selected.begin(), selected.end());
+}
+
+bool ProductSelection::matches(const std::string& name, const std::unordered_set<std::string>& productTags) const {
+    if (selectsAll()) return true;
+    if (std::find(names.begin(), names.end(), name) != names.end()) return true;
+    for (const auto& tag : productTags) {
+        if (tags.count(tag)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,76 @@
+#include "analysis_pipeline/core/data/product_snapshot.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+#include "analysis_pipeline/core/data/product_codec.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+template <typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+std::string ProductSnapshot::capture(PipelineDataProductManager& manager,
+                                     const std::string& sourceId,
+                                     std::uint64_t sequence,
+                                     const ProductSelection& selection) {
+    using namespace product_snapshot_format;
+
+    if (sourceId.size() > UINT16_MAX) {
+        throw std::runtime_error("ProductSnapshot: source id too long");
+    }
+
+    std::string out(kMagic, sizeof(kMagic));
+    append<std::uint32_t>(out, kVersion);
+    const std::size_t countOffset = out.size();
+    append<std::uint32_t>(out, 0);  // patched below
+    append<std::uint64_t>(out, sequence);
+    append<std::uint16_t>(out, static_cast<std::uint16_t>(sourceId.size()));
+    out.append(sourceId);
+
+    // One product at a time so a snapshot never holds more than one lock
+    std::uint32_t count = 0;
+    for (const auto& name : selection.resolve(manager)) {
+        if (!manager.hasProduct(name)) continue;  // removed since the names were listed
+        auto handle = manager.checkoutRead(name);
+        if (!handle->getObject()) continue;
+        ProductCodec::encode(*handle, out);
+        ++count;
+    }
+
+    std::memcpy(&out[countOffset], &count, sizeof(count));
+    return out;
+}
+
+ProductSnapshot ProductSnapshot::decode(ByteView bytes) {
+    using namespace product_snapshot_format;
+
+    if (bytes.size() < sizeof(kMagic) + 18 ||
+        std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("ProductSnapshot: not a product snapshot");
+    }
+
+    std::size_t offset = sizeof(kMagic);
+    auto version = bytes.read<std::uint32_t>(offset);
+    if (version != kVersion) {
+        throw std::runtime_error("ProductSnapshot: unsupported version " + std::to_string(version));
+    }
+    auto count = bytes.read<std::uint32_t>(offset + 4);
+
+    ProductSnapshot snapshot;
+    snapshot.sequence = bytes.read<std::uint64_t>(offset + 8);
+    auto sourceLength = bytes.read<std::uint16_t>(offset + 16);
+    ByteView source = bytes.subview(offset + 18, sourceLength);
+    snapshot.sourceId.assign(reinterpret_cast<const char*>(source.data()), source.size());
+    offset += 18 + sourceLength;
+
+    snapshot.products.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        snapshot.products.push_back(ProductCodec::decode(bytes, offset));
+    }
+    return snapshot;
+}
@@ -0,0 +1,132 @@
+#include "analysis_pipeline/core/data/products/atomic_accumulator.h"
+
+#include <TBuffer.h>
+#include <TCollection.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+ClassImp(AtomicAccumulator)
+
+namespace {
+
+// std::atomic<double>::fetch_add is C++20; the shard is rarely contended
+void atomicAdd(std::atomic<double>& target, double value) noexcept {
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+    }
+}
+
+template <typename Better>
+void atomicUpdate(std::atomic<double>& target, double value, Better better) noexcept {
+    double current = target.load(std::memory_order_relaxed);
+    while (better(value, current) &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace
+
+double AtomicAccumulator::Summary::mean() const noexcept {
+    return count > 0 ? sum / static_cast<double>(count) : 0.0;
+}
+
+double AtomicAccumulator::Summary::variance() const noexcept {
+    if (count == 0) return 0.0;
+    const double m = mean();
+    return std::max(0.0, sumSquares / static_cast<double>(count) - m * m);
+}
+
+double AtomicAccumulator::Summary::stdDev() const noexcept {
+    return std::sqrt(variance());
+}
+
+void AtomicAccumulator::fill(double x) noexcept {
+    Shard& shard = shards_[atomic_shard::current()];
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    atomicUpdate(shard.min, x, [](double a, double b) { return a < b; });
+    atomicUpdate(shard.max, x, [](double a, double b) { return a > b; });
+    atomicAdd(shard.sum, x);
+    atomicAdd(shard.sumSquares, x * x);
+}
+
+AtomicAccumulator::Summary AtomicAccumulator::summary() const noexcept {
+    Summary result;
+    bool first = true;
+    for (const auto& shard : shards_) {
+        const Long64_t count = shard.count.load(std::memory_order_relaxed);
+        if (count == 0) continue;
+        result.count += count;
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+        result.sumSquares += shard.sumSquares.load(std::memory_order_relaxed);
+        const double min = shard.min.load(std::memory_order_relaxed);
+        const double max = shard.max.load(std::memory_order_relaxed);
+        result.min = first ? min : std::min(result.min, min);
+        result.max = first ? max : std::max(result.max, max);
+        first = false;
+    }
+    return result;
+}
+
+void AtomicAccumulator::reset() noexcept {
+    for (auto& shard : shards_) {
+        shard.count.store(0, std::memory_order_relaxed);
+        shard.sum.store(0.0, std::memory_order_relaxed);
+        shard.sumSquares.store(0.0, std::memory_order_relaxed);
+        shard.min.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+        shard.max.store(-std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+    }
+}
+
+void AtomicAccumulator::assign(const AtomicAccumulator& other) noexcept {
+    const Summary incoming = other.summary();
+    reset();
+    absorb(incoming);
+}
+
+// Adds a whole summary to the calling thread's shard
+void AtomicAccumulator::absorb(const Summary& summary) noexcept {
+    if (summary.count == 0) return;
+    Shard& shard = shards_[atomic_shard::current()];
+    shard.count.fetch_add(summary.count, std::memory_order_relaxed);
+    atomicUpdate(shard.min, summary.min, [](double a, double b) { return a < b; });
+    atomicUpdate(shard.max, summary.max, [](double a, double b) { return a > b; });
+    atomicAdd(shard.sum, summary.sum);
+    atomicAdd(shard.sumSquares, summary.sumSquares);
+}
+
+Long64_t AtomicAccumulator::Merge(TCollection* list) {
+    if (list) {
+        TIter next(list);
+        while (TObject* obj = next()) {
+            auto* other = dynamic_cast<AtomicAccumulator*>(obj);
+            if (!other) {
+                throw std::invalid_argument(std::string("AtomicAccumulator: cannot merge a ") + obj->ClassName());
+            }
+            absorb(other->summary());
+        }
+    }
+    return summary().count;
+}
+
+// Custom streamer (LinkDef "-"): the shards are folded into the persistent
+// fields on write and restored into one shard on read
+void AtomicAccumulator::Streamer(TBuffer& R__b) {
+    std::lock_guard lock(streamMutex_);
+    if (R__b.IsReading()) {
+        R__b.ReadClassBuffer(AtomicAccumulator::Class(), this);
+        reset();
+        absorb(Summary{count_, sum_, sumSquares_, min_, max_});
+    } else {
+        const Summary s = summary();
+        count_ = s.count;
+        sum_ = s.sum;
+        sumSquares_ = s.sumSquares;
+        min_ = s.min;
+        max_ = s.max;
+        R__b.WriteClassBuffer(AtomicAccumulator::Class(), this);
+    }
+}
@@ -0,0 +1,53 @@
+#include "analysis_pipeline/core/data/products/atomic_counter.h"
+
+#include <TBuffer.h>
+#include <TCollection.h>
+
+#include <stdexcept>
+#include <string>
+
+ClassImp(AtomicCounter)
+
+Long64_t AtomicCounter::value() const noexcept {
+    Long64_t total = 0;
+    for (const auto& shard : shards_) total += shard.value.load(std::memory_order_relaxed);
+    return total;
+}
+
+void AtomicCounter::reset() noexcept {
+    for (auto& shard : shards_) shard.value.store(0, std::memory_order_relaxed);
+}
+
+void AtomicCounter::assign(const AtomicCounter& other) noexcept {
+    const Long64_t value = other.value();
+    reset();
+    shards_[0].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+Long64_t AtomicCounter::Merge(TCollection* list) {
+    if (list) {
+        TIter next(list);
+        while (TObject* obj = next()) {
+            auto* other = dynamic_cast<AtomicCounter*>(obj);
+            if (!other) {
+                throw std::invalid_argument(std::string("AtomicCounter: cannot merge a ") + obj->ClassName());
+            }
+            add(other->value());
+        }
+    }
+    return value();
+}
+
+// Custom streamer (LinkDef "-"): the shards are folded into value_ on write
+// and restored into one shard on read
+void AtomicCounter::Streamer(TBuffer& R__b) {
+    std::lock_guard lock(streamMutex_);
+    if (R__b.IsReading()) {
+        R__b.ReadClassBuffer(AtomicCounter::Class(), this);
+        reset();
+        shards_[0].value.store(value_, std::memory_order_relaxed);
+    } else {
+        value_ = value();
+        R__b.WriteClassBuffer(AtomicCounter::Class(), this);
+    }
+}
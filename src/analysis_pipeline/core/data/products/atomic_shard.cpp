@@ -0,0 +1,13 @@
+#include "analysis_pipeline/core/data/products/atomic_shard.h"
+
+#include <atomic>
+
+namespace atomic_shard {
+
+std::size_t current() noexcept {
+    static std::atomic<std::size_t> nextShard{0};
+    thread_local const std::size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return shard;
+}
+
+}  // namespace atomic_shard
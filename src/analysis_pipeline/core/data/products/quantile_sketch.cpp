@@ -0,0 +1,239 @@
+#include "analysis_pipeline/core/data/products/quantile_sketch.h"
+
+#include <TCollection.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+ClassImp(QuantileSketch)
+
+namespace {
+// Capacity of level h shrinks by this factor per level below the top
+constexpr double kCapacityDecay = 2.0 / 3.0;
+constexpr std::size_t kMinLevelCapacity = 2;
+
+std::uint64_t splitmix64(std::uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+}
+
+QuantileSketch::QuantileSketch(std::uint32_t k) : k_(k) {
+    if (k_ < kMinK) {
+        throw std::invalid_argument("QuantileSketch: k must be at least " + std::to_string(kMinK));
+    }
+}
+
+std::size_t QuantileSketch::levelCapacity(std::size_t level) const noexcept {
+    const std::size_t depth = levels_.size() - 1 - level;
+    const double capacity = std::ceil(k_ * std::pow(kCapacityDecay, static_cast<double>(depth)));
+    return std::max(kMinLevelCapacity, static_cast<std::size_t>(capacity));
+}
+
+std::size_t QuantileSketch::retained() const noexcept {
+    std::size_t total = 0;
+    for (const auto& level : levels_) total += level.size();
+    return total;
+}
+
+std::uint64_t QuantileSketch::initialCoinState() noexcept {
+    // Sketches that are later merged must not pick the same odd/even
+    // survivors in lockstep, or their rank errors add up instead of
+    // cancelling. A per-process random seed plus a per-instance counter
+    // gives every sketch its own sequence.
+    static const std::uint64_t processSeed = [] {
+        try {
+            std::random_device device;
+            return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+        } catch (...) {
+            return static_cast<std::uint64_t>(
+                reinterpret_cast<std::uintptr_t>(&processSeed));
+        }
+    }();
+    static std::atomic<std::uint64_t> instances{0};
+    const std::uint64_t state =
+        splitmix64(processSeed ^ splitmix64(instances.fetch_add(1, std::memory_order_relaxed)));
+    return state != 0 ? state : 0x9E3779B97F4A7C15ULL;  // xorshift never leaves 0
+}
+
+bool QuantileSketch::nextCoin() {
+    // xorshift64: unbiased enough for choosing odd/even survivors
+    coinState_ ^= coinState_ << 13;
+    coinState_ ^= coinState_ >> 7;
+    coinState_ ^= coinState_ << 17;
+    return coinState_ & 1;
+}
+
+void QuantileSketch::insert(double value) {
+    if (std::isnan(value)) return;
+
+    if (count_ == 0) {
+        min_ = max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+    ++count_;
+
+    if (levels_.empty()) {
+        levels_.emplace_back();
+        levels_[0].reserve(k_);
+    }
+    levels_[0].push_back(value);
+    if (levels_[0].size() >= level0Capacity_) {
+        compress();
+    }
+}
+
+void QuantileSketch::insert(const double* values, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) insert(values[i]);
+}
+
+// Halves the lowest over-full level into the one above, repeating upwards.
+// Adding a level raises every lower level's capacity, so the loop re-reads them.
+void QuantileSketch::compress() {
+    for (std::size_t level = 0; level < levels_.size(); ++level) {
+        if (levels_[level].size() >= levelCapacity(level)) {
+            if (level + 1 == levels_.size()) levels_.emplace_back();
+            compactLevel(level);
+        }
+    }
+    level0Capacity_ = levels_.empty() ? 0 : levelCapacity(0);
+}
+
+void QuantileSketch::compactLevel(std::size_t level) {
+    auto& items = levels_[level];
+    auto& above = levels_[level + 1];
+
+    // An odd item stays behind so the retained weight stays exact
+    double leftover = 0.0;
+    const bool odd = items.size() % 2 != 0;
+    if (odd) {
+        leftover = items.back();
+        items.pop_back();
+    }
+
+    std::sort(items.begin(), items.end());
+    for (std::size_t i = nextCoin() ? 1 : 0; i < items.size(); i += 2) {
+        above.push_back(items[i]);
+    }
+    items.clear();
+    if (odd) items.push_back(leftover);
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (&other == this || other.empty()) return;
+    if (other.k_ != k_) {
+        throw std::invalid_argument("QuantileSketch: cannot merge sketches with k " + std::to_string(other.k_) +
+                                    " and " + std::to_string(k_));
+    }
+
+    if (count_ == 0) {
+        min_ = other.min_;
+        max_ = other.max_;
+    } else {
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+    count_ += other.count_;
+
+    if (levels_.size() < other.levels_.size()) levels_.resize(other.levels_.size());
+    for (std::size_t h = 0; h < other.levels_.size(); ++h) {
+        levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+    }
+    compress();
+}
+
+Long64_t QuantileSketch::Merge(TCollection* list) {
+    if (!list) return static_cast<Long64_t>(count_);
+    TIter next(list);
+    while (TObject* obj = next()) {
+        auto* sketch = dynamic_cast<QuantileSketch*>(obj);
+        if (!sketch) {
+            throw std::invalid_argument(std::string("QuantileSketch: cannot merge a ") + obj->ClassName());
+        }
+        merge(*sketch);
+    }
+    return static_cast<Long64_t>(count_);
+}
+
+void QuantileSketch::Clear(Option_t*) {
+    count_ = 0;
+    min_ = max_ = 0.0;
+    levels_.clear();
+    level0Capacity_ = 0;
+}
+
+std::vector<QuantileSketch::WeightedValue> QuantileSketch::sortedView() const {
+    std::vector<WeightedValue> view;
+    view.reserve(retained());
+    for (std::size_t h = 0; h < levels_.size(); ++h) {
+        const std::uint64_t weight = std::uint64_t{1} << h;
+        for (double value : levels_[h]) view.push_back({value, weight});
+    }
+    std::sort(view.begin(), view.end(),
+              [](const WeightedValue& a, const WeightedValue& b) { return a.value < b.value; });
+    return view;
+}
+
+double QuantileSketch::quantile(double q) const {
+    return quantiles({q}).front();
+}
+
+std::vector<double> QuantileSketch::quantiles(const std::vector<double>& qs) const {
+    for (double q : qs) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::invalid_argument("QuantileSketch: quantile must be in [0, 1]");
+        }
+    }
+
+    std::vector<double> result(qs.size(), std::numeric_limits<double>::quiet_NaN());
+    if (empty()) return result;
+
+    const auto view = sortedView();
+    std::uint64_t total = 0;
+    for (const auto& item : view) total += item.weight;
+
+    for (std::size_t i = 0; i < qs.size(); ++i) {
+        if (qs[i] == 0.0) {
+            result[i] = min_;
+            continue;
+        }
+        if (qs[i] == 1.0) {
+            result[i] = max_;
+            continue;
+        }
+        const double target = qs[i] * static_cast<double>(total);
+        std::uint64_t cumulative = 0;
+        result[i] = max_;
+        for (const auto& item : view) {
+            cumulative += item.weight;
+            if (static_cast<double>(cumulative) >= target) {
+                result[i] = item.value;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+double QuantileSketch::cdf(double x) const {
+    if (empty()) return std::numeric_limits<double>::quiet_NaN();
+    std::uint64_t below = 0;
+    std::uint64_t total = 0;
+    for (std::size_t h = 0; h < levels_.size(); ++h) {
+        const std::uint64_t weight = std::uint64_t{1} << h;
+        for (double value : levels_[h]) {
+            total += weight;
+            if (value <= x) below += weight;
+        }
+    }
+    return static_cast<double>(below) / static_cast<double>(total);
+}
@@ -0,0 +1,31 @@
+#include "analysis_pipeline/core/data/products/raw_event_product.h"
+
+#include <stdexcept>
+
+ClassImp(RawEventProduct)
+
+RawEventProduct::RawEventProduct(std::shared_ptr<const RawEventBuffer> buffer, Format format)
+    : buffer_(std::move(buffer)), format_(format) {
+    if (!buffer_) {
+        throw std::invalid_argument("RawEventProduct: null buffer");
+    }
+    size_ = buffer_->size();
+    if (format_ == Format::Midas) {
+        midas_.emplace(buffer_->view());
+    }
+}
+
+ByteView RawEventProduct::bytes() const noexcept {
+    return buffer_ ? buffer_->view() : ByteView();
+}
+
+const MidasEventView& RawEventProduct::midas() const {
+    if (!midas_) {
+        throw std::runtime_error("RawEventProduct: event is not in MIDAS format");
+    }
+    return *midas_;
+}
+
+const MidasBank& RawEventProduct::getBank(const std::string& name) const {
+    return midas().getBank(name);
+}
@@ -0,0 +1,3 @@
+#include "analysis_pipeline/core/data/products/value_batch.h"
+
+ClassImp(ValueBatch)
@@ -0,0 +1,135 @@
+#include "analysis_pipeline/core/data/products/windowed_th1d.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+ClassImp(WindowedTH1D)
+
+WindowedTH1D::WindowedTH1D(const char* name, const char* title, Int_t bins, Double_t xmin, Double_t xmax,
+                           std::chrono::milliseconds length, std::uint32_t slices)
+    : TH1D(name, title, bins, xmin, xmax), lengthMs_(length.count()), sliceCount_(slices) {
+    if (slices == 0) {
+        throw std::invalid_argument("WindowedTH1D: slices must be positive");
+    }
+    if (length.count() < static_cast<Long64_t>(slices)) {
+        throw std::invalid_argument("WindowedTH1D: window must be at least 1 ms per slice");
+    }
+    // Slices mirror the bin layout, so the axis must not grow, and expiring
+    // a slice needs its sum of squared weights
+    SetCanExtend(TH1::kNoAxis);
+    Sumw2(kTRUE);
+    ensureSlices();
+}
+
+std::chrono::milliseconds WindowedTH1D::sliceLength() const noexcept {
+    return std::chrono::milliseconds(sliceCount_ ? lengthMs_ / sliceCount_ : 0);
+}
+
+void WindowedTH1D::ensureSlices() {
+    if (slices_.size() == sliceCount_ || sliceCount_ == 0) return;
+
+    const auto cells = static_cast<std::size_t>(GetNcells());
+    slices_.assign(sliceCount_, Slice{std::vector<double>(cells, 0.0), std::vector<double>(cells, 0.0)});
+    current_ = 0;
+
+    // Read back or cloned without slices: everything held so far ages out together
+    Slice& slice = slices_[current_];
+    const double* content = GetArray();
+    std::copy(content, content + cells, slice.content.begin());
+    if (GetSumw2N() > 0) {
+        const double* sumw2 = GetSumw2()->GetArray();
+        std::copy(sumw2, sumw2 + cells, slice.sumw2.begin());
+    }
+    double stats[TH1::kNstat] = {};
+    GetStats(stats);
+    std::copy(stats, stats + slice.stats.size(), slice.stats.begin());
+    slice.entries = GetEntries();
+}
+
+Int_t WindowedTH1D::Fill(Double_t x, Double_t w) {
+    ensureSlices();
+    const Int_t cell = GetXaxis()->FindBin(x);
+    const Int_t result = TH1D::Fill(x, w);
+
+    // Mirrors what TH1::Fill added to the sum
+    Slice& slice = slices_[current_];
+    slice.content[static_cast<std::size_t>(cell)] += w;
+    slice.sumw2[static_cast<std::size_t>(cell)] += w * w;
+    slice.entries += 1.0;
+    if ((cell >= 1 && cell <= GetNbinsX()) || GetStatOverflowsBehaviour()) {
+        slice.stats[0] += w;
+        slice.stats[1] += w * w;
+        slice.stats[2] += w * x;
+        slice.stats[3] += w * x * x;
+    }
+    return result;
+}
+
+void WindowedTH1D::expireNext() {
+    current_ = (current_ + 1) % sliceCount_;
+    Slice& slice = slices_[current_];
+    if (slice.entries == 0.0) return;
+
+    double* content = GetArray();
+    double* sumw2 = GetSumw2N() > 0 ? GetSumw2()->GetArray() : nullptr;
+    for (std::size_t i = 0; i < slice.content.size(); ++i) {
+        content[i] -= slice.content[i];
+        if (sumw2) sumw2[i] -= slice.sumw2[i];
+    }
+
+    double stats[TH1::kNstat] = {};
+    GetStats(stats);
+    for (std::size_t k = 0; k < slice.stats.size(); ++k) stats[k] -= slice.stats[k];
+    const double entries = std::max(0.0, GetEntries() - slice.entries);
+    PutStats(stats);
+    SetEntries(entries);
+
+    std::fill(slice.content.begin(), slice.content.end(), 0.0);
+    std::fill(slice.sumw2.begin(), slice.sumw2.end(), 0.0);
+    slice.entries = 0.0;
+    slice.stats.fill(0.0);
+}
+
+void WindowedTH1D::advanceSlices(std::uint32_t count) {
+    ensureSlices();
+    if (count >= sliceCount_) {
+        // The whole window expired; a reset also clears accumulated round-off
+        Reset();
+        return;
+    }
+    for (std::uint32_t i = 0; i < count; ++i) expireNext();
+}
+
+void WindowedTH1D::advance(Clock::time_point now) {
+    const Long64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    if (sliceStartNs_ == 0) {
+        sliceStartNs_ = nowNs;
+        return;
+    }
+    const Long64_t sliceNs = std::chrono::duration_cast<std::chrono::nanoseconds>(sliceLength()).count();
+    if (nowNs - sliceStartNs_ < sliceNs) return;
+
+    const Long64_t elapsed = (nowNs - sliceStartNs_) / sliceNs;
+    advanceSlices(static_cast<std::uint32_t>(std::min<Long64_t>(elapsed, sliceCount_)));
+    sliceStartNs_ += elapsed * sliceNs;
+}
+
+void WindowedTH1D::Reset(Option_t* option) {
+    TH1D::Reset(option);
+    for (auto& slice : slices_) {
+        std::fill(slice.content.begin(), slice.content.end(), 0.0);
+        std::fill(slice.sumw2.begin(), slice.sumw2.end(), 0.0);
+        slice.entries = 0.0;
+        slice.stats.fill(0.0);
+    }
+}
+
+void WindowedTH1D::Copy(TObject& target) const {
+    TH1D::Copy(target);
+    auto& copy = static_cast<WindowedTH1D&>(target);
+    copy.lengthMs_ = lengthMs_;
+    copy.sliceCount_ = sliceCount_;
+    copy.slices_ = slices_;
+    copy.current_ = current_;
+    copy.sliceStartNs_ = sliceStartNs_;
+}
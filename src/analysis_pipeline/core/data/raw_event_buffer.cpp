@@ -0,0 +1,37 @@
+#include "analysis_pipeline/core/data/raw_event_buffer.h"
+
+#include <fstream>
+
+RawEventBuffer::RawEventBuffer(const std::uint8_t* data, std::size_t size, std::shared_ptr<const void> owner)
+    : data_(data), size_(size), owner_(std::move(owner)) {}
+
+std::shared_ptr<const RawEventBuffer> RawEventBuffer::fromBytes(std::vector<std::uint8_t>&& bytes) {
+    auto storage = std::make_shared<const std::vector<std::uint8_t>>(std::move(bytes));
+    return std::shared_ptr<const RawEventBuffer>(
+        new RawEventBuffer(storage->data(), storage->size(), storage));
+}
+
+std::shared_ptr<const RawEventBuffer> RawEventBuffer::fromFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("RawEventBuffer: cannot open file '" + path + "'");
+    }
+
+    std::streamsize size = in.tellg();
+    in.seekg(0, std::ios::beg);
+
+    std::vector<std::uint8_t> bytes(static_cast<std::size_t>(size));
+    if (size > 0 && !in.read(reinterpret_cast<char*>(bytes.data()), size)) {
+        throw std::runtime_error("RawEventBuffer: failed to read file '" + path + "'");
+    }
+    return fromBytes(std::move(bytes));
+}
+
+std::shared_ptr<const RawEventBuffer> RawEventBuffer::wrap(const std::uint8_t* data,
+                                                           std::size_t size,
+                                                           std::shared_ptr<const void> owner) {
+    if (!data && size > 0) {
+        throw std::invalid_argument("RawEventBuffer::wrap called with null data and non-zero size");
+    }
+    return std::shared_ptr<const RawEventBuffer>(new RawEventBuffer(data, size, std::move(owner)));
+}
@@ -0,0 +1,82 @@
+#include "analysis_pipeline/core/data/root_compression.h"
+
+#include <Compression.h>
+#include <stdexcept>
+
+namespace {
+
+using Algorithm = ROOT::RCompressionSetting::EAlgorithm;
+using Level = ROOT::RCompressionSetting::ELevel;
+
+struct AlgorithmInfo {
+    const char* name;
+    Algorithm::EValues algorithm;
+    int defaultLevel;
+};
+
+constexpr AlgorithmInfo kAlgorithms[] = {
+    {"zlib", Algorithm::kZLIB, Level::kDefaultZLIB},
+    {"lzma", Algorithm::kLZMA, Level::kDefaultLZMA},
+    {"lz4", Algorithm::kLZ4, Level::kDefaultLZ4},
+    {"zstd", Algorithm::kZSTD, Level::kDefaultZSTD},
+};
+
+const AlgorithmInfo* findAlgorithm(const std::string& name) {
+    for (const auto& info : kAlgorithms) {
+        if (name == info.name) return &info;
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+int RootCompression::fromJson(const nlohmann::json& config) {
+    if (config.is_null()) {
+        return ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose;
+    }
+    if (config.is_number_integer()) {
+        int settings = config.get<int>();
+        if (settings < 0) {
+            throw std::runtime_error("RootCompression: settings must be non-negative");
+        }
+        return settings;
+    }
+
+    std::string name;
+    int level = -1;
+    if (config.is_string()) {
+        name = config.get<std::string>();
+    } else if (config.is_object()) {
+        name = config.value("algorithm", "default");
+        level = config.value("level", -1);
+    } else {
+        throw std::runtime_error("RootCompression: expected an object, string or integer");
+    }
+
+    if (level == 0) {
+        return ROOT::CompressionSettings(Algorithm::kUseGlobal, Level::kUncompressed);
+    }
+    if (level > 9) {
+        throw std::runtime_error("RootCompression: level must be between 0 and 9");
+    }
+    if (name == "default") {
+        if (level < 0) return ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose;
+        return ROOT::CompressionSettings(Algorithm::kZSTD, level);
+    }
+
+    const AlgorithmInfo* info = findAlgorithm(name);
+    if (!info) {
+        throw std::runtime_error("RootCompression: unknown algorithm '" + name + "'");
+    }
+    return ROOT::CompressionSettings(info->algorithm, level < 0 ? info->defaultLevel : level);
+}
+
+std::string RootCompression::describe(int settings) {
+    const int level = settings % 100;
+    if (level == 0) return "none";
+    const int algorithm = settings / 100;
+    for (const auto& info : kAlgorithms) {
+        if (info.algorithm == algorithm) return std::string(info.name) + ":" + std::to_string(level);
+    }
+    return "default:" + std::to_string(level);
+}
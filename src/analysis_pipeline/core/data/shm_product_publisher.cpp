@@ -0,0 +1,165 @@
+#include "analysis_pipeline/core/data/shm_product_publisher.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+#include "analysis_pipeline/core/data/product_codec.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace shm_product_format;
+
+ShmProductPublisher::ShmProductPublisher(std::string segmentName,
+                                         std::size_t slotCount,
+                                         std::size_t payloadCapacity,
+                                         bool unlinkOnClose)
+    : segmentName_(normalizeName(segmentName)), unlinkOnClose_(unlinkOnClose) {
+    if (slotCount == 0 || slotCount > UINT32_MAX) {
+        throw std::runtime_error("ShmProductPublisher: invalid slot count");
+    }
+    if (payloadCapacity == 0 || payloadCapacity > UINT32_MAX) {
+        throw std::runtime_error("ShmProductPublisher: invalid payload capacity");
+    }
+
+    // Start from a fresh segment so attached readers never see a layout change in place
+    ::shm_unlink(segmentName_.c_str());
+    int fd = ::shm_open(segmentName_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("ShmProductPublisher: shm_open('" + segmentName_ + "') failed: " +
+                                 std::strerror(errno));
+    }
+
+    size_ = segmentSize(slotCount, payloadCapacity);
+    if (::ftruncate(fd, static_cast<off_t>(size_)) < 0) {
+        std::string error = std::strerror(errno);
+        ::close(fd);
+        ::shm_unlink(segmentName_.c_str());
+        throw std::runtime_error("ShmProductPublisher: ftruncate failed: " + error);
+    }
+
+    void* addr = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        ::shm_unlink(segmentName_.c_str());
+        throw std::runtime_error(std::string("ShmProductPublisher: mmap failed: ") + std::strerror(errno));
+    }
+    base_ = static_cast<std::uint8_t*>(addr);
+
+    // ftruncate zero-fills, so every slot starts at sequence 0 (never written)
+    for (std::size_t i = 0; i < slotCount; ++i) {
+        new (base_ + kHeaderSize + i * slotStride(payloadCapacity)) SlotHeader{};
+    }
+
+    header_ = new (base_) SegmentHeader{};
+    header_->version = kVersion;
+    header_->slotCount = static_cast<std::uint32_t>(slotCount);
+    header_->slotStride = slotStride(payloadCapacity);
+    header_->payloadCapacity = payloadCapacity;
+    header_->slotsUsed.store(0, std::memory_order_relaxed);
+    header_->publishCount.store(0, std::memory_order_relaxed);
+    // Magic last: readers treat a segment without it as not ready
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header_->magic, kMagic, sizeof(kMagic));
+
+    spdlog::debug("[ShmProductPublisher] Created '{}' with {} slots of {} bytes", segmentName_, slotCount,
+                  payloadCapacity);
+}
+
+ShmProductPublisher::~ShmProductPublisher() {
+    if (base_) ::munmap(base_, size_);
+    if (unlinkOnClose_) ::shm_unlink(segmentName_.c_str());
+}
+
+std::string ShmProductPublisher::normalizeName(const std::string& name) {
+    if (!name.empty() && name.front() == '/') return name;
+    return "/" + name;
+}
+
+SlotHeader* ShmProductPublisher::slotAt(std::size_t index) {
+    return reinterpret_cast<SlotHeader*>(base_ + kHeaderSize + index * header_->slotStride);
+}
+
+SlotHeader* ShmProductPublisher::slotFor(const std::string& name) {
+    auto it = slotIndex_.find(name);
+    if (it != slotIndex_.end()) return slotAt(it->second);
+
+    std::size_t index = slotIndex_.size();
+    if (index >= header_->slotCount) return nullptr;
+    if (name.size() >= kNameSize) {
+        spdlog::warn("[ShmProductPublisher] Name '{}' longer than {} bytes is truncated", name, kNameSize - 1);
+    }
+
+    SlotHeader* slot = slotAt(index);
+    std::strncpy(slot->name, name.c_str(), kNameSize - 1);
+    slotIndex_.emplace(name, index);
+    header_->slotsUsed.store(static_cast<std::uint32_t>(index + 1), std::memory_order_release);
+    return slot;
+}
+
+bool ShmProductPublisher::publish(const std::string& name, PayloadFormat format, const std::string& payload) {
+    if (payload.size() > header_->payloadCapacity) {
+        if (stats_.oversized++ == 0) {
+            spdlog::warn("[ShmProductPublisher] '{}' needs {} bytes, slot capacity is {}", name, payload.size(),
+                         header_->payloadCapacity);
+        }
+        return false;
+    }
+
+    SlotHeader* slot = slotFor(name);
+    if (!slot) {
+        if (stats_.noFreeSlot++ == 0) {
+            spdlog::warn("[ShmProductPublisher] All {} slots in use; '{}' not exported", header_->slotCount, name);
+        }
+        return false;
+    }
+
+    const std::uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->format = static_cast<std::uint32_t>(format);
+    slot->payloadSize = static_cast<std::uint32_t>(payload.size());
+    slot->updateCount += 1;
+    slot->timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+    std::memcpy(reinterpret_cast<std::uint8_t*>(slot) + sizeof(SlotHeader), payload.data(), payload.size());
+
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+    ++stats_.published;
+    return true;
+}
+
+bool ShmProductPublisher::publish(const PipelineDataProduct& product, PayloadFormat format) {
+    std::string payload;
+    if (format == PayloadFormat::Root) {
+        ProductCodec::encode(product, payload);
+    } else {
+        payload = product.serializeToJson().dump();
+    }
+    return publish(product.getName(), format, payload);
+}
+
+std::size_t ShmProductPublisher::publishFrom(PipelineDataProductManager& manager,
+                                             const ProductSelection& selection,
+                                             PayloadFormat format) {
+    std::size_t published = 0;
+    for (const auto& name : selection.resolve(manager)) {
+        try {
+            if (!manager.hasProduct(name)) continue;
+            auto handle = manager.checkoutRead(name);
+            if (!handle->getObject()) continue;
+            if (publish(*handle, format)) ++published;
+        } catch (const std::exception& e) {
+            spdlog::error("[ShmProductPublisher] Failed to export '{}': {}", name, e.what());
+        }
+    }
+    header_->publishCount.fetch_add(1, std::memory_order_release);
+    return published;
+}
@@ -0,0 +1,132 @@
+#include "analysis_pipeline/core/data/shm_product_reader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace shm_product_format;
+
+namespace {
+
+// Bounded so a reader never spins forever on a slot the writer keeps rewriting
+constexpr int kMaxReadAttempts = 1000;
+
+}  // namespace
+
+ShmProductReader::ShmProductReader(const std::string& segmentName) {
+    std::string name = (!segmentName.empty() && segmentName.front() == '/') ? segmentName : "/" + segmentName;
+
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("ShmProductReader: cannot open '" + name + "': " + std::strerror(errno));
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) < 0 || static_cast<std::size_t>(st.st_size) < kHeaderSize) {
+        ::close(fd);
+        throw std::runtime_error("ShmProductReader: '" + name + "' is not a product segment");
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error(std::string("ShmProductReader: mmap failed: ") + std::strerror(errno));
+    }
+    base_ = static_cast<const std::uint8_t*>(addr);
+    header_ = reinterpret_cast<const SegmentHeader*>(base_);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (std::memcmp(header_->magic, kMagic, sizeof(kMagic)) != 0 || header_->version != kVersion ||
+        segmentSize(header_->slotCount, header_->payloadCapacity) > size_) {
+        ::munmap(const_cast<std::uint8_t*>(base_), size_);
+        throw std::runtime_error("ShmProductReader: '" + name + "' has an unknown or incomplete layout");
+    }
+}
+
+ShmProductReader::~ShmProductReader() {
+    if (base_) ::munmap(const_cast<std::uint8_t*>(base_), size_);
+}
+
+const SlotHeader* ShmProductReader::slotAt(std::size_t index) const {
+    return reinterpret_cast<const SlotHeader*>(base_ + kHeaderSize + index * header_->slotStride);
+}
+
+std::size_t ShmProductReader::size() const {
+    return header_->slotsUsed.load(std::memory_order_acquire);
+}
+
+std::uint64_t ShmProductReader::publishCount() const {
+    return header_->publishCount.load(std::memory_order_acquire);
+}
+
+std::vector<std::string> ShmProductReader::names() const {
+    std::vector<std::string> result;
+    const std::size_t used = size();
+    result.reserve(used);
+    for (std::size_t i = 0; i < used; ++i) {
+        result.emplace_back(slotAt(i)->name, strnlen(slotAt(i)->name, kNameSize));
+    }
+    return result;
+}
+
+std::optional<std::size_t> ShmProductReader::find(const std::string& name) const {
+    const std::size_t used = size();
+    for (std::size_t i = 0; i < used; ++i) {
+        if (name.compare(0, std::string::npos, slotAt(i)->name, strnlen(slotAt(i)->name, kNameSize)) == 0) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+bool ShmProductReader::copySlot(std::size_t index, Entry& out, std::uint64_t skipIfSequence) const {
+    if (index >= size()) return false;
+    const SlotHeader* slot = slotAt(index);
+    const auto* payload = reinterpret_cast<const char*>(slot) + sizeof(SlotHeader);
+
+    for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+        const std::uint64_t before = slot->sequence.load(std::memory_order_acquire);
+        if (before == 0 || before == skipIfSequence) return false;
+        if (before & 1) continue;  // write in progress
+
+        std::uint32_t format = slot->format;
+        std::uint32_t payloadSize = slot->payloadSize;
+        std::uint64_t updateCount = slot->updateCount;
+        std::int64_t timestampNs = slot->timestampNs;
+        if (payloadSize > header_->payloadCapacity) continue;  // torn read
+        out.payload.assign(payload, payloadSize);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) != before) continue;
+
+        out.name.assign(slot->name, strnlen(slot->name, kNameSize));
+        out.format = static_cast<PayloadFormat>(format);
+        out.updateCount = updateCount;
+        out.timestampNs = timestampNs;
+        out.sequence = before;
+        return true;
+    }
+    return false;
+}
+
+std::optional<ShmProductReader::Entry> ShmProductReader::read(std::size_t slot) const {
+    Entry entry;
+    if (!copySlot(slot, entry, 0)) return std::nullopt;
+    return entry;
+}
+
+std::optional<ShmProductReader::Entry> ShmProductReader::read(const std::string& name) const {
+    auto index = find(name);
+    if (!index) return std::nullopt;
+    return read(*index);
+}
+
+bool ShmProductReader::readIfChanged(std::size_t slot, std::uint64_t& lastSequence, Entry& out) const {
+    if (!copySlot(slot, out, lastSequence)) return false;
+    lastSequence = out.sequence;
+    return true;
+}
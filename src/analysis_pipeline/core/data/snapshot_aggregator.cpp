@@ -0,0 +1,280 @@
+#include "analysis_pipeline/core/data/snapshot_aggregator.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+#include "analysis_pipeline/core/data/product_merger.h"
+
+#include <TROOT.h>
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int kPollTimeoutMs = 200;
+
+}  // namespace
+
+SnapshotAggregator::SnapshotAggregator(std::string socketPath, PipelineDataProductManager& manager,
+                                       std::chrono::milliseconds sourceTimeout)
+    : socketPath_(std::move(socketPath)), manager_(manager), sourceTimeout_(sourceTimeout) {}
+
+SnapshotAggregator::~SnapshotAggregator() {
+    stop();
+}
+
+void SnapshotAggregator::start() {
+    if (running()) return;
+
+    sockaddr_un addr{};
+    if (socketPath_.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("SnapshotAggregator: socket path too long: " + socketPath_);
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath_.c_str(), sizeof(addr.sun_path) - 1);
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        throw std::runtime_error(std::string("SnapshotAggregator: socket() failed: ") + std::strerror(errno));
+    }
+
+    ::unlink(socketPath_.c_str());
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listenFd_, 16) < 0) {
+        std::string error = std::strerror(errno);
+        ::close(listenFd_);
+        listenFd_ = -1;
+        throw std::runtime_error("SnapshotAggregator: cannot listen on '" + socketPath_ + "': " + error);
+    }
+
+    // Decoding and merging run on the receive thread
+    ROOT::EnableThreadSafety();
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&SnapshotAggregator::run, this);
+    spdlog::debug("[SnapshotAggregator] Listening on '{}'", socketPath_);
+}
+
+void SnapshotAggregator::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+    if (thread_.joinable()) thread_.join();
+    ::close(listenFd_);
+    listenFd_ = -1;
+    ::unlink(socketPath_.c_str());
+}
+
+void SnapshotAggregator::run() {
+    std::vector<Connection> connections;
+    std::vector<pollfd> fds;
+
+    while (running_.load(std::memory_order_acquire)) {
+        fds.clear();
+        fds.push_back({listenFd_, POLLIN, 0});
+        for (const auto& connection : connections) {
+            fds.push_back({connection.fd, POLLIN, 0});
+        }
+
+        int ready = ::poll(fds.data(), fds.size(), kPollTimeoutMs);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            spdlog::error("[SnapshotAggregator] poll() failed: {}", std::strerror(errno));
+            break;
+        }
+        expireSources();
+        if (ready == 0) continue;
+
+        // Connections first: fds[i + 1] matches connections[i] only until one is accepted
+        for (std::size_t i = connections.size(); i-- > 0;) {
+            if (fds[i + 1].revents == 0) continue;
+            if (!readFrom(connections[i])) {
+                ::close(connections[i].fd);
+                connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) {
+                connections.push_back({fd, {}});
+            }
+        }
+        connectionCount_.store(connections.size(), std::memory_order_relaxed);
+    }
+
+    for (auto& connection : connections) {
+        ::close(connection.fd);
+    }
+    connectionCount_.store(0, std::memory_order_relaxed);
+}
+
+bool SnapshotAggregator::readFrom(Connection& connection) {
+    char chunk[64 * 1024];
+    ssize_t n = ::read(connection.fd, chunk, sizeof(chunk));
+    if (n < 0 && (errno == EINTR || errno == EAGAIN)) return true;
+    if (n <= 0) return false;
+    connection.buffer.append(chunk, static_cast<std::size_t>(n));
+
+    std::size_t offset = 0;
+    while (connection.buffer.size() - offset >= sizeof(std::uint32_t)) {
+        std::uint32_t length;
+        std::memcpy(&length, connection.buffer.data() + offset, sizeof(length));
+        if (length > snapshot_socket::kMaxFrameSize) {
+            spdlog::error("[SnapshotAggregator] Frame of {} bytes exceeds limit; dropping connection", length);
+            std::lock_guard lock(mutex_);
+            ++stats_.snapshotsRejected;
+            return false;
+        }
+        if (connection.buffer.size() - offset - sizeof(length) < length) break;
+
+        ByteView frame(reinterpret_cast<const std::uint8_t*>(connection.buffer.data()) + offset + sizeof(length),
+                       length);
+        offset += sizeof(length) + length;
+        try {
+            ingest(ProductSnapshot::decode(frame));
+        } catch (const std::exception& e) {
+            spdlog::warn("[SnapshotAggregator] Rejected snapshot: {}", e.what());
+            std::lock_guard lock(mutex_);
+            ++stats_.snapshotsRejected;
+        }
+    }
+    connection.buffer.erase(0, offset);
+    return true;
+}
+
+bool SnapshotAggregator::ingest(ProductSnapshot snapshot) {
+    std::lock_guard lock(mutex_);
+
+    auto [it, inserted] = sources_.try_emplace(snapshot.sourceId);
+    SourceState& source = it->second;
+    if (!inserted && snapshot.sequence <= source.sequence) {
+        if (snapshot.sequence != 1) {
+            ++stats_.snapshotsRejected;
+            return false;
+        }
+        // Sequence restarted: the source process was restarted under the same id
+        source.products.clear();
+        source.receivedAt.clear();
+    }
+    source.sequence = snapshot.sequence;
+    source.lastSeen = std::chrono::steady_clock::now();
+    ++stats_.snapshotsReceived;
+
+    for (auto& product : snapshot.products) {
+        std::string name = product->getName();
+        source.receivedAt[name] = ++arrivals_;
+        source.products[name] = std::move(product);
+        remergeLocked(name);
+    }
+    return true;
+}
+
+void SnapshotAggregator::removeSource(const std::string& sourceId) {
+    std::lock_guard lock(mutex_);
+    auto it = sources_.find(sourceId);
+    if (it == sources_.end()) return;
+    removeSourceLocked(it);
+}
+
+std::size_t SnapshotAggregator::expireSources() {
+    if (sourceTimeout_.count() <= 0) return 0;
+
+    std::lock_guard lock(mutex_);
+    const auto cutoff = std::chrono::steady_clock::now() - sourceTimeout_;
+    std::size_t expired = 0;
+    for (auto it = sources_.begin(); it != sources_.end();) {
+        auto next = std::next(it);
+        if (it->second.lastSeen < cutoff) {
+            spdlog::info("[SnapshotAggregator] Source '{}' sent nothing for {} ms; dropping its products",
+                         it->first, sourceTimeout_.count());
+            removeSourceLocked(it);
+            ++expired;
+        }
+        it = next;
+    }
+    stats_.sourcesExpired += expired;
+    return expired;
+}
+
+void SnapshotAggregator::removeSourceLocked(std::map<std::string, SourceState>::iterator it) {
+    std::vector<std::string> names;
+    for (const auto& [name, product] : it->second.products) {
+        names.push_back(name);
+    }
+    sources_.erase(it);
+
+    for (const auto& name : names) {
+        remergeLocked(name);
+    }
+}
+
+void SnapshotAggregator::remergeLocked(const std::string& name) {
+    std::unique_ptr<TObject> merged;
+    std::unordered_set<std::string> tags;
+    std::uint64_t newest = 0;
+    bool mergeable = true;
+
+    for (const auto& [sourceId, source] : sources_) {
+        auto it = source.products.find(name);
+        if (it == source.products.end() || !it->second->getObject()) continue;
+        const PipelineDataProduct& product = *it->second;
+        tags.insert(product.getTags().begin(), product.getTags().end());
+
+        const std::uint64_t receivedAt = source.receivedAt.at(name);
+        if (!merged) {
+            merged = ProductMerger::clone(*product.getObject());
+            mergeable = ProductMerger::isMergeable(*merged);
+            newest = receivedAt;
+        } else if (mergeable) {
+            if (!ProductMerger::merge(*merged, *product.getObject())) {
+                spdlog::warn("[SnapshotAggregator] Merge of '{}' from '{}' failed; skipped", name, sourceId);
+            }
+        } else if (receivedAt > newest) {
+            merged = ProductMerger::clone(*product.getObject());
+            newest = receivedAt;
+        }
+    }
+
+    if (!merged) {
+        if (manager_.hasProduct(name)) manager_.remove(name);
+        return;
+    }
+    tags.insert("aggregated");
+    ++stats_.productsMerged;
+
+    // Replace the object in place so readers holding the product keep a valid pointer
+    if (manager_.hasProduct(name)) {
+        auto handle = manager_.checkoutWrite(name);
+        handle->setSharedObject(std::shared_ptr<TObject>(std::move(merged)));
+        // Tags follow the current sources, so drop those no source carries any more
+        std::vector<std::string> stale;
+        for (const auto& tag : handle->getTags()) {
+            if (!tags.count(tag)) stale.push_back(tag);
+        }
+        for (const auto& tag : stale) handle->removeTag(tag);
+        for (const auto& tag : tags) handle->addTag(tag);
+        return;
+    }
+    auto product = std::make_unique<PipelineDataProduct>();
+    product->setObject(std::move(merged));
+    for (const auto& tag : tags) product->addTag(tag);
+    manager_.addOrUpdate(name, std::move(product));
+}
+
+std::vector<std::string> SnapshotAggregator::sources() const {
+    std::lock_guard lock(mutex_);
+    std::vector<std::string> ids;
+    for (const auto& [id, state] : sources_) ids.push_back(id);
+    return ids;
+}
+
+SnapshotAggregator::Stats SnapshotAggregator::stats() const {
+    std::lock_guard lock(mutex_);
+    Stats s = stats_;
+    s.sources = sources_.size();
+    s.connections = connectionCount_.load(std::memory_order_relaxed);
+    return s;
+}
@@ -0,0 +1,88 @@
+#include "analysis_pipeline/core/data/snapshot_client.h"
+#include "analysis_pipeline/core/data/product_snapshot.h"
+#include "analysis_pipeline/core/data/snapshot_aggregator.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+SnapshotClient::SnapshotClient(std::string socketPath, std::string sourceId)
+    : socketPath_(std::move(socketPath)), sourceId_(std::move(sourceId)) {
+    if (sourceId_.empty()) sourceId_ = defaultSourceId();
+}
+
+SnapshotClient::~SnapshotClient() {
+    disconnect();
+}
+
+std::string SnapshotClient::defaultSourceId() {
+    char host[256] = {};
+    if (::gethostname(host, sizeof(host) - 1) != 0) {
+        std::strcpy(host, "localhost");
+    }
+    return std::string(host) + ":" + std::to_string(::getpid());
+}
+
+bool SnapshotClient::connect() {
+    if (fd_ >= 0) return true;
+
+    sockaddr_un addr{};
+    if (socketPath_.size() >= sizeof(addr.sun_path)) {
+        spdlog::error("[SnapshotClient] Socket path too long: {}", socketPath_);
+        return false;
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath_.c_str(), sizeof(addr.sun_path) - 1);
+
+    fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) return false;
+    if (::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        spdlog::debug("[SnapshotClient] Cannot connect to '{}': {}", socketPath_, std::strerror(errno));
+        disconnect();
+        return false;
+    }
+    return true;
+}
+
+void SnapshotClient::disconnect() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool SnapshotClient::send(PipelineDataProductManager& manager, const ProductSelection& selection) {
+    // Only a delivered snapshot advances the sequence, so sequence() counts deliveries
+    if (!sendEncoded(ProductSnapshot::capture(manager, sourceId_, sequence_ + 1, selection))) return false;
+    ++sequence_;
+    return true;
+}
+
+bool SnapshotClient::sendEncoded(const std::string& snapshot) {
+    if (snapshot.size() > snapshot_socket::kMaxFrameSize) {
+        spdlog::error("[SnapshotClient] Snapshot of {} bytes exceeds frame limit", snapshot.size());
+        return false;
+    }
+    if (!connect()) return false;
+
+    auto length = static_cast<std::uint32_t>(snapshot.size());
+    std::string frame(reinterpret_cast<const char*>(&length), sizeof(length));
+    frame.append(snapshot);
+
+    std::size_t written = 0;
+    while (written < frame.size()) {
+        ssize_t n = ::send(fd_, frame.data() + written, frame.size() - written, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            spdlog::warn("[SnapshotClient] Send to '{}' failed: {}", socketPath_, std::strerror(errno));
+            disconnect();
+            return false;
+        }
+        written += static_cast<std::size_t>(n);
+    }
+    return true;
+}
@@ -0,0 +1,116 @@
+#include "analysis_pipeline/core/execution/numa_topology.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+std::vector<int> usableCpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        unsigned count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < count; ++cpu) cpus.push_back(static_cast<int>(cpu));
+    }
+    return cpus;
+}
+
+}  // namespace
+
+NumaTopology::NumaTopology(std::vector<Node> nodes) : nodes_(std::move(nodes)) {
+    if (nodes_.empty()) {
+        throw std::invalid_argument("NumaTopology: at least one node is required");
+    }
+}
+
+NumaTopology NumaTopology::detect() {
+    const std::vector<int> usable = usableCpus();
+    std::vector<Node> nodes;
+
+    namespace fs = std::filesystem;
+    const fs::path root("/sys/devices/system/node");
+    std::error_code ec;
+    if (fs::is_directory(root, ec)) {
+        for (const auto& entry : fs::directory_iterator(root, ec)) {
+            const std::string name = entry.path().filename().string();
+            if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+                !std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+                continue;
+            }
+
+            std::ifstream in(entry.path() / "cpulist");
+            std::string list;
+            std::getline(in, list);
+
+            Node node;
+            node.id = std::stoi(name.substr(4));
+            for (int cpu : parseCpuList(list)) {
+                if (std::binary_search(usable.begin(), usable.end(), cpu)) node.cpus.push_back(cpu);
+            }
+            if (!node.cpus.empty()) nodes.push_back(std::move(node));
+        }
+    }
+
+    if (nodes.empty()) {
+        nodes.push_back(Node{0, usable});
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const Node& a, const Node& b) { return a.id < b.id; });
+    return NumaTopology(std::move(nodes));
+}
+
+std::vector<int> NumaTopology::allCpus() const {
+    std::vector<int> cpus;
+    for (const auto& node : nodes_) {
+        cpus.insert(cpus.end(), node.cpus.begin(), node.cpus.end());
+    }
+    return cpus;
+}
+
+int NumaTopology::nodeOfCpu(int cpu) const {
+    for (const auto& node : nodes_) {
+        if (std::find(node.cpus.begin(), node.cpus.end(), cpu) != node.cpus.end()) return node.id;
+    }
+    return -1;
+}
+
+const NumaTopology::Node* NumaTopology::node(int id) const {
+    for (const auto& node : nodes_) {
+        if (node.id == id) return &node;
+    }
+    return nullptr;
+}
+
+std::vector<int> NumaTopology::parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty()) continue;
+
+        auto dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        if (last < first) {
+            throw std::invalid_argument("NumaTopology: invalid cpu range '" + range + "'");
+        }
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
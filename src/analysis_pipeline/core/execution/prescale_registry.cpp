@@ -0,0 +1,37 @@
+#include "analysis_pipeline/core/execution/prescale_registry.h"
+
+bool PrescaleGroup::adjust(std::uint32_t expected, std::uint32_t factor,
+                           std::chrono::steady_clock::time_point now,
+                           std::chrono::steady_clock::duration interval) noexcept {
+    // Claim the interval first, so controllers that measured the same
+    // overload step the factor once, not once each
+    const auto ticks = now.time_since_epoch().count();
+    auto last = lastAdjust_.load(std::memory_order_relaxed);
+    if (last != 0 && ticks - last < interval.count()) return false;
+    if (!lastAdjust_.compare_exchange_strong(last, ticks, std::memory_order_acq_rel)) return false;
+    return factor_.compare_exchange_strong(expected, factor < 1 ? 1 : factor, std::memory_order_relaxed);
+}
+
+PrescaleRegistry& PrescaleRegistry::instance() {
+    static PrescaleRegistry registry;
+    return registry;
+}
+
+PrescaleGroup& PrescaleRegistry::group(const std::string& name) {
+    std::lock_guard lock(mutex_);
+    auto& group = groups_[name];
+    if (!group) {
+        group = std::make_unique<PrescaleGroup>(name);
+    }
+    return *group;
+}
+
+std::vector<std::pair<std::string, std::uint32_t>> PrescaleRegistry::factors() const {
+    std::lock_guard lock(mutex_);
+    std::vector<std::pair<std::string, std::uint32_t>> result;
+    result.reserve(groups_.size());
+    for (const auto& [name, group] : groups_) {
+        result.emplace_back(name, group->factor());
+    }
+    return result;
+}
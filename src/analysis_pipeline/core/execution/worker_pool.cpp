@@ -0,0 +1,205 @@
+#include "analysis_pipeline/core/execution/worker_pool.h"
+#include "analysis_pipeline/core/stages/base_stage.h"
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+thread_local int tCurrentWorker = -1;
+
+bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+}  // namespace
+
+WorkerPoolConfig WorkerPoolConfig::fromJson(const nlohmann::json& config) {
+    WorkerPoolConfig result;
+    if (config.is_null()) return result;
+
+    result.threads = config.value("threads", result.threads);
+
+    const std::string placement = config.value("placement", "none");
+    if (placement == "none") {
+        result.placement = PlacementPolicy::None;
+    } else if (placement == "compact") {
+        result.placement = PlacementPolicy::Compact;
+    } else if (placement == "scatter") {
+        result.placement = PlacementPolicy::Scatter;
+    } else if (placement == "explicit") {
+        result.placement = PlacementPolicy::Explicit;
+    } else {
+        throw std::runtime_error("WorkerPoolConfig: unknown placement '" + placement +
+                                 "' (expected 'none', 'compact', 'scatter' or 'explicit')");
+    }
+
+    if (config.contains("cpus")) {
+        result.cpus = config["cpus"].get<std::vector<int>>();
+    }
+    if (config.contains("nodes")) {
+        result.nodes = config["nodes"].get<std::vector<int>>();
+    }
+    if (result.placement == PlacementPolicy::Explicit && result.cpus.empty()) {
+        throw std::runtime_error("WorkerPoolConfig: explicit placement requires 'cpus'");
+    }
+    return result;
+}
+
+std::vector<int> WorkerPool::planPlacement(const WorkerPoolConfig& config, const NumaTopology& topology) {
+    std::vector<const NumaTopology::Node*> nodes;
+    for (const auto& node : topology.nodes()) {
+        if (config.nodes.empty() ||
+            std::find(config.nodes.begin(), config.nodes.end(), node.id) != config.nodes.end()) {
+            nodes.push_back(&node);
+        }
+    }
+    if (nodes.empty()) {
+        throw std::runtime_error("WorkerPool: none of the requested NUMA nodes are available");
+    }
+
+    std::vector<int> order;
+    switch (config.placement) {
+        case PlacementPolicy::Explicit:
+            order = config.cpus;
+            break;
+        case PlacementPolicy::Compact:
+        case PlacementPolicy::None:
+            for (const auto* node : nodes) {
+                order.insert(order.end(), node->cpus.begin(), node->cpus.end());
+            }
+            break;
+        case PlacementPolicy::Scatter:
+            for (std::size_t i = 0;; ++i) {
+                bool any = false;
+                for (const auto* node : nodes) {
+                    if (i < node->cpus.size()) {
+                        order.push_back(node->cpus[i]);
+                        any = true;
+                    }
+                }
+                if (!any) break;
+            }
+            break;
+    }
+
+    if (order.empty()) {
+        throw std::runtime_error("WorkerPool: no CPUs available for placement");
+    }
+
+    const std::size_t threads = config.threads > 0 ? config.threads : order.size();
+    std::vector<int> plan(threads, -1);
+    if (config.placement != PlacementPolicy::None) {
+        // More threads than CPUs wrap around, sharing CPUs in the same order
+        for (std::size_t i = 0; i < threads; ++i) plan[i] = order[i % order.size()];
+    }
+    return plan;
+}
+
+WorkerPool::WorkerPool(const WorkerPoolConfig& config, const NumaTopology& topology) {
+    const std::vector<int> plan = planPlacement(config, topology);
+    workers_.reserve(plan.size());
+    for (int cpu : plan) {
+        auto worker = std::make_unique<Worker>();
+        worker->cpu = cpu;
+        worker->node = cpu >= 0 ? topology.nodeOfCpu(cpu) : -1;
+        workers_.push_back(std::move(worker));
+    }
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->thread = std::thread(&WorkerPool::run, this, i);
+    }
+
+    spdlog::debug("[WorkerPool] Started {} workers across {} NUMA nodes", workers_.size(), topology.nodeCount());
+}
+
+WorkerPool::~WorkerPool() {
+    for (auto& worker : workers_) {
+        {
+            std::lock_guard lock(worker->mutex);
+            worker->stopping = true;
+        }
+        worker->cv.notify_all();
+    }
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+int WorkerPool::currentWorker() noexcept {
+    return tCurrentWorker;
+}
+
+void WorkerPool::run(std::size_t index) {
+    Worker& worker = *workers_[index];
+    tCurrentWorker = static_cast<int>(index);
+
+    if (worker.cpu >= 0 && !pinCurrentThread(worker.cpu)) {
+        spdlog::warn("[WorkerPool] Could not pin worker {} to CPU {}", index, worker.cpu);
+    }
+
+    std::unique_lock lock(worker.mutex);
+    for (;;) {
+        worker.cv.wait(lock, [&] { return worker.stopping || !worker.tasks.empty(); });
+        if (worker.tasks.empty()) return;  // stopping and drained
+
+        auto task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        lock.unlock();
+        task();  // exceptions are stored in the task's future
+        lock.lock();
+    }
+}
+
+std::future<void> WorkerPool::submit(std::size_t worker, std::function<void()> task) {
+    Worker& target = *workers_.at(worker);
+    std::packaged_task<void()> packaged(std::move(task));
+    auto future = packaged.get_future();
+    {
+        std::lock_guard lock(target.mutex);
+        if (target.stopping) {
+            throw std::runtime_error("WorkerPool: submit after shutdown");
+        }
+        target.tasks.push_back(std::move(packaged));
+    }
+    target.cv.notify_one();
+    return future;
+}
+
+void WorkerPool::runOnAll(const std::function<void(std::size_t)>& task) {
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers_.size());
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        futures.push_back(submit(i, [&task, i] { task(i); }));
+    }
+    // Wait for all before rethrowing, since the tasks reference `task`
+    std::exception_ptr first;
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!first) first = std::current_exception();
+        }
+    }
+    if (first) std::rethrow_exception(first);
+}
+
+std::future<void> WorkerPool::runStages(std::size_t worker, std::vector<BaseStage*> stages) {
+    return submit(worker, [stages = std::move(stages)] {
+        EventContext event;
+        for (auto* stage : stages) stage->Execute(event);
+    });
+}
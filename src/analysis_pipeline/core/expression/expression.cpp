@@ -0,0 +1,432 @@
+#include "analysis_pipeline/core/expression/expression.h"
+#include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+
+enum class TokenType { Number, Identifier, Operator, LParen, RParen, Comma, Dot, End };
+
+struct Token {
+    TokenType type = TokenType::End;
+    std::string text;
+    double number = 0.0;
+    std::size_t position = 0;
+};
+
+std::vector<Token> tokenize(const std::string& source) {
+    std::vector<Token> tokens;
+    std::size_t i = 0;
+    while (i < source.size()) {
+        const char c = source[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+            continue;
+        }
+
+        Token token;
+        token.position = i;
+
+        if (std::isdigit(static_cast<unsigned char>(c)) ||
+            (c == '.' && i + 1 < source.size() && std::isdigit(static_cast<unsigned char>(source[i + 1])))) {
+            char* end = nullptr;
+            token.type = TokenType::Number;
+            token.number = std::strtod(source.c_str() + i, &end);
+            token.text = source.substr(i, static_cast<std::size_t>(end - (source.c_str() + i)));
+            i += token.text.size();
+        } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            std::size_t start = i;
+            while (i < source.size() &&
+                   (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_')) {
+                ++i;
+            }
+            token.type = TokenType::Identifier;
+            token.text = source.substr(start, i - start);
+        } else if (c == '(') {
+            token.type = TokenType::LParen;
+            token.text = "(";
+            ++i;
+        } else if (c == ')') {
+            token.type = TokenType::RParen;
+            token.text = ")";
+            ++i;
+        } else if (c == ',') {
+            token.type = TokenType::Comma;
+            token.text = ",";
+            ++i;
+        } else if (c == '.') {
+            token.type = TokenType::Dot;
+            token.text = ".";
+            ++i;
+        } else {
+            static const char* const kTwoChar[] = {"&&", "||", "==", "!=", "<=", ">="};
+            token.type = TokenType::Operator;
+            for (const char* op : kTwoChar) {
+                if (source.compare(i, 2, op) == 0) token.text = op;
+            }
+            if (token.text.empty()) {
+                if (std::string("+-*/%<>!").find(c) == std::string::npos) {
+                    throw ExpressionError("Expression: unexpected character '" + std::string(1, c) +
+                                          "' at position " + std::to_string(i), i);
+                }
+                token.text = std::string(1, c);
+            }
+            i += token.text.size();
+        }
+        tokens.push_back(std::move(token));
+    }
+
+    Token end;
+    end.position = source.size();
+    tokens.push_back(end);
+    return tokens;
+}
+
+}  // namespace
+
+class ExpressionParser {
+public:
+    ExpressionParser(Expression& expression, std::vector<Token> tokens)
+        : expr_(expression), tokens_(std::move(tokens)) {}
+
+    std::int32_t parse() {
+        std::int32_t root = parseOr();
+        if (peek().type != TokenType::End) fail("unexpected '" + peek().text + "'");
+        return root;
+    }
+
+private:
+    using Op = Expression::Op;
+
+    const Token& peek() const { return tokens_[pos_]; }
+    const Token& next() { return tokens_[pos_++]; }
+
+    bool acceptOperator(const char* op, const char* keyword = nullptr) {
+        const Token& token = peek();
+        if ((token.type == TokenType::Operator && token.text == op) ||
+            (keyword && token.type == TokenType::Identifier && token.text == keyword)) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(TokenType type, const char* what) {
+        if (peek().type != type) fail(std::string("expected ") + what);
+        ++pos_;
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw ExpressionError("Expression: " + message + " at position " + std::to_string(peek().position) +
+                                  " in '" + expr_.source_ + "'",
+                              peek().position);
+    }
+
+    std::int32_t parseOr() {
+        std::int32_t lhs = parseAnd();
+        while (acceptOperator("||", "or")) lhs = binary(Op::Or, lhs, parseAnd());
+        return lhs;
+    }
+
+    std::int32_t parseAnd() {
+        std::int32_t lhs = parseEquality();
+        while (acceptOperator("&&", "and")) lhs = binary(Op::And, lhs, parseEquality());
+        return lhs;
+    }
+
+    std::int32_t parseEquality() {
+        std::int32_t lhs = parseRelational();
+        for (;;) {
+            if (acceptOperator("==")) lhs = binary(Op::Eq, lhs, parseRelational());
+            else if (acceptOperator("!=")) lhs = binary(Op::Ne, lhs, parseRelational());
+            else return lhs;
+        }
+    }
+
+    std::int32_t parseRelational() {
+        std::int32_t lhs = parseAdditive();
+        for (;;) {
+            if (acceptOperator("<=")) lhs = binary(Op::Le, lhs, parseAdditive());
+            else if (acceptOperator(">=")) lhs = binary(Op::Ge, lhs, parseAdditive());
+            else if (acceptOperator("<")) lhs = binary(Op::Lt, lhs, parseAdditive());
+            else if (acceptOperator(">")) lhs = binary(Op::Gt, lhs, parseAdditive());
+            else return lhs;
+        }
+    }
+
+    std::int32_t parseAdditive() {
+        std::int32_t lhs = parseMultiplicative();
+        for (;;) {
+            if (acceptOperator("+")) lhs = binary(Op::Add, lhs, parseMultiplicative());
+            else if (acceptOperator("-")) lhs = binary(Op::Sub, lhs, parseMultiplicative());
+            else return lhs;
+        }
+    }
+
+    std::int32_t parseMultiplicative() {
+        std::int32_t lhs = parseUnary();
+        for (;;) {
+            if (acceptOperator("*")) lhs = binary(Op::Mul, lhs, parseUnary());
+            else if (acceptOperator("/")) lhs = binary(Op::Div, lhs, parseUnary());
+            else if (acceptOperator("%")) lhs = binary(Op::Mod, lhs, parseUnary());
+            else return lhs;
+        }
+    }
+
+    std::int32_t parseUnary() {
+        if (acceptOperator("!", "not")) return unary(Op::Not, parseUnary());
+        if (acceptOperator("-")) return unary(Op::Neg, parseUnary());
+        if (acceptOperator("+")) return parseUnary();
+        return parsePrimary();
+    }
+
+    std::int32_t parsePrimary() {
+        const Token& token = peek();
+        if (token.type == TokenType::Number) {
+            next();
+            return constant(token.number);
+        }
+        if (token.type == TokenType::LParen) {
+            next();
+            std::int32_t inner = parseOr();
+            expect(TokenType::RParen, "')'");
+            return inner;
+        }
+        if (token.type != TokenType::Identifier) fail("expected a value");
+
+        const std::string name = next().text;
+        if (name == "true") return constant(1.0);
+        if (name == "false") return constant(0.0);
+
+        if (peek().type == TokenType::LParen) {
+            next();
+            return parseCall(name);
+        }
+        return reference(name);
+    }
+
+    std::int32_t parseCall(const std::string& function) {
+        if (function == "exists") {
+            if (peek().type != TokenType::Identifier) fail("exists() takes a product name");
+            std::string product = next().text;
+            expect(TokenType::RParen, "')'");
+            Expression::Node node;
+            node.op = Op::Exists;
+            node.a = static_cast<std::int32_t>(expr_.existsNames_.size());
+            expr_.existsNames_.push_back(product);
+            return push(node);
+        }
+
+        std::int32_t first = parseOr();
+        if (function == "abs" || function == "sqrt") {
+            expect(TokenType::RParen, "')'");
+            return unary(function == "abs" ? Op::Abs : Op::Sqrt, first);
+        }
+        if (function == "min" || function == "max") {
+            expect(TokenType::Comma, "','");
+            std::int32_t second = parseOr();
+            expect(TokenType::RParen, "')'");
+            return binary(function == "min" ? Op::Min : Op::Max, first, second);
+        }
+        fail("unknown function '" + function + "'");
+    }
+
+    // `product` or `product.member`; identical references share one accessor
+    std::int32_t reference(const std::string& product) {
+        std::string member = "fVal";
+        if (peek().type == TokenType::Dot) {
+            next();
+            if (peek().type != TokenType::Identifier) fail("expected a member name");
+            member = next().text;
+        }
+
+        std::int32_t index = -1;
+        for (std::size_t i = 0; i < expr_.variables_.size(); ++i) {
+            if (expr_.variables_[i].productName() == product && expr_.variables_[i].memberName() == member) {
+                index = static_cast<std::int32_t>(i);
+            }
+        }
+        if (index < 0) {
+            index = static_cast<std::int32_t>(expr_.variables_.size());
+            expr_.variables_.emplace_back(product, member);
+        }
+
+        Expression::Node node;
+        node.op = Op::Var;
+        node.a = index;
+        return push(node);
+    }
+
+    std::int32_t constant(double value) {
+        Expression::Node node;
+        node.op = Op::Const;
+        node.value = value;
+        return push(node);
+    }
+
+    bool isConst(std::int32_t index) const { return expr_.nodes_[index].op == Op::Const; }
+    double constValue(std::int32_t index) const { return expr_.nodes_[index].value; }
+
+    std::int32_t unary(Op op, std::int32_t operand) {
+        if (isConst(operand)) {
+            return replaceWithConstant(operand, Expression::apply(op, constValue(operand), 0.0));
+        }
+        Expression::Node node;
+        node.op = op;
+        node.a = operand;
+        return push(node);
+    }
+
+    std::int32_t binary(Op op, std::int32_t lhs, std::int32_t rhs) {
+        if (isConst(lhs) && isConst(rhs)) {
+            double value = Expression::apply(op, constValue(lhs), constValue(rhs));
+            expr_.nodes_.pop_back();  // rhs is the last node pushed
+            return replaceWithConstant(lhs, value);
+        }
+        // A constant left side decides && / || on its own, or reduces them to the truth of the right side
+        if ((op == Op::And || op == Op::Or) && isConst(lhs)) {
+            const bool decided = (op == Op::And) ? constValue(lhs) == 0.0 : constValue(lhs) != 0.0;
+            if (decided) return constant(op == Op::Or ? 1.0 : 0.0);
+            return unary(Op::Bool, rhs);
+        }
+        Expression::Node node;
+        node.op = op;
+        node.a = lhs;
+        node.b = rhs;
+        return push(node);
+    }
+
+    // Folded operands are always the most recently pushed nodes, so they can be dropped
+    std::int32_t replaceWithConstant(std::int32_t index, double value) {
+        expr_.nodes_.resize(static_cast<std::size_t>(index));
+        return constant(value);
+    }
+
+    std::int32_t push(const Expression::Node& node) {
+        expr_.nodes_.push_back(node);
+        return static_cast<std::int32_t>(expr_.nodes_.size() - 1);
+    }
+
+    Expression& expr_;
+    std::vector<Token> tokens_;
+    std::size_t pos_ = 0;
+};
+
+Expression Expression::compile(const std::string& source) {
+    Expression expression;
+    expression.source_ = source;
+    ExpressionParser parser(expression, tokenize(source));
+    expression.root_ = parser.parse();
+    expression.compact();
+    expression.values_.assign(expression.variables_.size(), 0.0);
+    expression.stamps_.assign(expression.variables_.size(), 0);
+    return expression;
+}
+
+// Folding leaves unreachable nodes behind; copy the reachable tree in
+// post-order so operands stay ahead of their users.
+void Expression::compact() {
+    std::vector<Node> nodes;
+    nodes.reserve(nodes_.size());
+    std::function<std::int32_t(std::int32_t)> copy = [&](std::int32_t index) {
+        Node node = nodes_[static_cast<std::size_t>(index)];
+        if (node.op != Op::Const && node.op != Op::Var && node.op != Op::Exists) {
+            node.a = copy(node.a);
+            if (node.b >= 0) node.b = copy(node.b);
+        }
+        nodes.push_back(node);
+        return static_cast<std::int32_t>(nodes.size() - 1);
+    };
+    root_ = copy(root_);
+    nodes_.swap(nodes);
+}
+
+bool Expression::isConstant() const noexcept {
+    return root_ >= 0 && nodes_[static_cast<std::size_t>(root_)].op == Op::Const;
+}
+
+std::vector<std::string> Expression::productNames() const {
+    std::vector<std::string> names;
+    auto add = [&](const std::string& name) {
+        for (const auto& existing : names) {
+            if (existing == name) return;
+        }
+        names.push_back(name);
+    };
+    for (const auto& accessor : variables_) add(accessor.productName());
+    for (const auto& name : existsNames_) add(name);
+    return names;
+}
+
+double Expression::evaluate(PipelineDataProductManager& manager) {
+    ++generation_;
+    return eval(root_, manager);
+}
+
+double Expression::variable(std::int32_t index, PipelineDataProductManager& manager) {
+    const auto i = static_cast<std::size_t>(index);
+    if (stamps_[i] != generation_) {
+        if (!variables_[i].read(manager, values_[i])) {
+            throw MissingProductError(variables_[i].productName());
+        }
+        stamps_[i] = generation_;
+    }
+    return values_[i];
+}
+
+double Expression::apply(Op op, double x, double y) {
+    switch (op) {
+        case Op::Neg:  return -x;
+        case Op::Not:  return x == 0.0 ? 1.0 : 0.0;
+        case Op::Bool: return x != 0.0 ? 1.0 : 0.0;
+        case Op::Abs:  return std::fabs(x);
+        case Op::Sqrt: return std::sqrt(x);
+        case Op::Add:  return x + y;
+        case Op::Sub:  return x - y;
+        case Op::Mul:  return x * y;
+        case Op::Div:  return x / y;
+        case Op::Mod:  return std::fmod(x, y);
+        case Op::Min:  return std::fmin(x, y);
+        case Op::Max:  return std::fmax(x, y);
+        case Op::Lt:   return x < y ? 1.0 : 0.0;
+        case Op::Le:   return x <= y ? 1.0 : 0.0;
+        case Op::Gt:   return x > y ? 1.0 : 0.0;
+        case Op::Ge:   return x >= y ? 1.0 : 0.0;
+        case Op::Eq:   return x == y ? 1.0 : 0.0;
+        case Op::Ne:   return x != y ? 1.0 : 0.0;
+        case Op::And:  return (x != 0.0 && y != 0.0) ? 1.0 : 0.0;
+        case Op::Or:   return (x != 0.0 || y != 0.0) ? 1.0 : 0.0;
+        case Op::Const:
+        case Op::Var:
+        case Op::Exists:
+            break;
+    }
+    return 0.0;
+}
+
+double Expression::eval(std::int32_t index, PipelineDataProductManager& manager) {
+    const Node& node = nodes_[static_cast<std::size_t>(index)];
+    switch (node.op) {
+        case Op::Const:
+            return node.value;
+        case Op::Var:
+            return variable(node.a, manager);
+        case Op::Exists:
+            return manager.hasProduct(existsNames_[static_cast<std::size_t>(node.a)]) ? 1.0 : 0.0;
+        case Op::And:
+            return (eval(node.a, manager) != 0.0 && eval(node.b, manager) != 0.0) ? 1.0 : 0.0;
+        case Op::Or:
+            return (eval(node.a, manager) != 0.0 || eval(node.b, manager) != 0.0) ? 1.0 : 0.0;
+        case Op::Neg:
+        case Op::Not:
+        case Op::Bool:
+        case Op::Abs:
+        case Op::Sqrt:
+            return apply(node.op, eval(node.a, manager), 0.0);
+        default:
+            return apply(node.op, eval(node.a, manager), eval(node.b, manager));
+    }
+}
@@ -0,0 +1,234 @@
+#include "analysis_pipeline/core/random/sample_distribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Below this mean Knuth's multiplication method is faster than PTRS
+constexpr double kPoissonPtrsThreshold = 10.0;
+
+}  // namespace
+
+SampleDistribution SampleDistribution::fromJson(const nlohmann::json& config) {
+    std::string type = config.value("type", "uniform");
+
+    if (type == "uniform") {
+        return uniform(config.value("min", 0.0), config.value("max", 1.0));
+    }
+    if (type == "gaussian") {
+        return gaussian(config.value("mean", 0.0), config.value("sigma", 1.0));
+    }
+    if (type == "exponential") {
+        return exponential(config.value("lambda", 1.0));
+    }
+    if (type == "poisson") {
+        return poisson(config.value("mean", 1.0));
+    }
+    if (type == "histogram") {
+        if (!config.contains("weights") || !config["weights"].is_array()) {
+            throw std::runtime_error("SampleDistribution: histogram requires a 'weights' array");
+        }
+        auto weights = config["weights"].get<std::vector<double>>();
+
+        std::vector<double> edges;
+        if (config.contains("edges")) {
+            edges = config["edges"].get<std::vector<double>>();
+        } else {
+            double min = config.value("min", 0.0);
+            double max = config.value("max", 1.0);
+            edges.resize(weights.size() + 1);
+            for (std::size_t i = 0; i < edges.size(); ++i) {
+                edges[i] = min + (max - min) * static_cast<double>(i) / static_cast<double>(weights.size());
+            }
+        }
+        return histogram(std::move(edges), weights);
+    }
+
+    throw std::runtime_error("SampleDistribution: unknown type '" + type +
+                             "' (expected uniform, gaussian, exponential, poisson or histogram)");
+}
+
+SampleDistribution SampleDistribution::uniform(double min, double max) {
+    if (!(max > min)) {
+        throw std::runtime_error("SampleDistribution: uniform requires max > min");
+    }
+    SampleDistribution d;
+    d.type_ = Type::Uniform;
+    d.a_ = min;
+    d.b_ = max;
+    return d;
+}
+
+SampleDistribution SampleDistribution::gaussian(double mean, double sigma) {
+    if (!(sigma > 0.0)) {
+        throw std::runtime_error("SampleDistribution: gaussian requires sigma > 0");
+    }
+    SampleDistribution d;
+    d.type_ = Type::Gaussian;
+    d.a_ = mean;
+    d.b_ = sigma;
+    return d;
+}
+
+SampleDistribution SampleDistribution::exponential(double lambda) {
+    if (!(lambda > 0.0)) {
+        throw std::runtime_error("SampleDistribution: exponential requires lambda > 0");
+    }
+    SampleDistribution d;
+    d.type_ = Type::Exponential;
+    d.a_ = lambda;
+    return d;
+}
+
+SampleDistribution SampleDistribution::poisson(double mean) {
+    if (!(mean > 0.0)) {
+        throw std::runtime_error("SampleDistribution: poisson requires mean > 0");
+    }
+    SampleDistribution d;
+    d.type_ = Type::Poisson;
+    d.a_ = mean;
+    d.expMinusMean_ = std::exp(-mean);
+    d.logMean_ = std::log(mean);
+
+    // Constants for Hormann's transformed rejection (PTRS)
+    const double sqrtMean = std::sqrt(mean);
+    d.ptrsB_ = 0.931 + 2.53 * sqrtMean;
+    d.ptrsA_ = -0.059 + 0.02483 * d.ptrsB_;
+    d.ptrsInvAlpha_ = 1.1239 + 1.1328 / (d.ptrsB_ - 3.4);
+    d.ptrsVr_ = 0.9277 - 3.6224 / (d.ptrsB_ - 2.0);
+    return d;
+}
+
+SampleDistribution SampleDistribution::histogram(std::vector<double> edges, const std::vector<double>& weights) {
+    if (weights.empty() || edges.size() != weights.size() + 1) {
+        throw std::runtime_error("SampleDistribution: histogram needs N weights and N+1 edges");
+    }
+    if (!std::is_sorted(edges.begin(), edges.end())) {
+        throw std::runtime_error("SampleDistribution: histogram edges must be increasing");
+    }
+
+    SampleDistribution d;
+    d.type_ = Type::Histogram;
+    d.edges_ = std::move(edges);
+    d.cumulative_.resize(weights.size());
+
+    double total = 0.0;
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        if (weights[i] < 0.0) {
+            throw std::runtime_error("SampleDistribution: histogram weights must be non-negative");
+        }
+        total += weights[i];
+        d.cumulative_[i] = total;
+    }
+    if (!(total > 0.0)) {
+        throw std::runtime_error("SampleDistribution: histogram weights sum to zero");
+    }
+    for (auto& c : d.cumulative_) c /= total;
+    d.cumulative_.back() = 1.0;
+    return d;
+}
+
+std::string SampleDistribution::typeName() const {
+    switch (type_) {
+        case Type::Uniform: return "uniform";
+        case Type::Gaussian: return "gaussian";
+        case Type::Exponential: return "exponential";
+        case Type::Poisson: return "poisson";
+        case Type::Histogram: return "histogram";
+    }
+    return "unknown";
+}
+
+double SampleDistribution::sample(Xoshiro256PlusPlus& rng) {
+    switch (type_) {
+        case Type::Uniform: return a_ + (b_ - a_) * rng.uniform();
+        case Type::Gaussian: return sampleGaussian(rng);
+        case Type::Exponential: return -std::log1p(-rng.uniform()) / a_;
+        case Type::Poisson: return samplePoisson(rng);
+        case Type::Histogram: return sampleHistogram(rng);
+    }
+    return 0.0;
+}
+
+void SampleDistribution::fill(Xoshiro256PlusPlus& rng, double* out, std::size_t n) {
+    switch (type_) {
+        case Type::Uniform: {
+            const double scale = b_ - a_;
+            for (std::size_t i = 0; i < n; ++i) out[i] = a_ + scale * rng.uniform();
+            break;
+        }
+        case Type::Gaussian:
+            for (std::size_t i = 0; i < n; ++i) out[i] = sampleGaussian(rng);
+            break;
+        case Type::Exponential: {
+            const double invLambda = 1.0 / a_;
+            for (std::size_t i = 0; i < n; ++i) out[i] = -std::log1p(-rng.uniform()) * invLambda;
+            break;
+        }
+        case Type::Poisson:
+            for (std::size_t i = 0; i < n; ++i) out[i] = samplePoisson(rng);
+            break;
+        case Type::Histogram:
+            for (std::size_t i = 0; i < n; ++i) out[i] = sampleHistogram(rng);
+            break;
+    }
+}
+
+double SampleDistribution::sampleGaussian(Xoshiro256PlusPlus& rng) {
+    if (hasSpare_) {
+        hasSpare_ = false;
+        return a_ + b_ * spare_;
+    }
+
+    // Marsaglia polar method
+    double u, v, s;
+    do {
+        u = 2.0 * rng.uniform() - 1.0;
+        v = 2.0 * rng.uniform() - 1.0;
+        s = u * u + v * v;
+    } while (s >= 1.0 || s == 0.0);
+
+    const double factor = std::sqrt(-2.0 * std::log(s) / s);
+    spare_ = v * factor;
+    hasSpare_ = true;
+    return a_ + b_ * u * factor;
+}
+
+double SampleDistribution::samplePoisson(Xoshiro256PlusPlus& rng) const {
+    if (a_ < kPoissonPtrsThreshold) {
+        // Knuth: count uniforms until their product drops below exp(-mean)
+        double product = rng.uniform();
+        long k = 0;
+        while (product > expMinusMean_) {
+            product *= rng.uniform();
+            ++k;
+        }
+        return static_cast<double>(k);
+    }
+
+    // Hormann (1993), "The transformed rejection method for generating Poisson random variables"
+    for (;;) {
+        const double u = rng.uniform() - 0.5;
+        const double v = rng.uniform();
+        const double us = 0.5 - std::fabs(u);
+        const double k = std::floor((2.0 * ptrsA_ / us + ptrsB_) * u + a_ + 0.43);
+
+        if (us >= 0.07 && v <= ptrsVr_) return k;
+        if (k < 0.0 || (us < 0.013 && v > us)) continue;
+
+        if (std::log(v) + std::log(ptrsInvAlpha_) - std::log(ptrsA_ / (us * us) + ptrsB_) <=
+            -a_ + k * logMean_ - std::lgamma(k + 1.0)) {
+            return k;
+        }
+    }
+}
+
+double SampleDistribution::sampleHistogram(Xoshiro256PlusPlus& rng) const {
+    const double u = rng.uniform();
+    auto it = std::upper_bound(cumulative_.begin(), cumulative_.end(), u);
+    auto bin = static_cast<std::size_t>(std::min<std::ptrdiff_t>(it - cumulative_.begin(),
+                                                                  static_cast<std::ptrdiff_t>(cumulative_.size()) - 1));
+    return edges_[bin] + (edges_[bin + 1] - edges_[bin]) * rng.uniform();
+}
@@ -1,5 +1,10 @@
 #include "analysis_pipeline/core/stages/base_stage.h"
+#include "analysis_pipeline/core/execution/prescale_registry.h"
+#include <TParameter.h>
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
+#include <utility>
 
 BaseStage::BaseStage() = default;
 BaseStage::~BaseStage() = default;
@@ -8,5 +13,101 @@ void BaseStage::Init(const nlohmann::json& parameters,
                      PipelineDataProductManager* dataProductManager) {
     parameters_ = parameters;
     dataProductManager_ = dataProductManager;
+    alwaysRun_ = parameters_.value("always_run", false);
+
+    // Read signed so that a negative value is rejected instead of wrapping
+    const auto prescale = parameters_.value("prescale", std::int64_t{1});
+    if (prescale < 1 || prescale > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("BaseStage: prescale must be between 1 and " +
+                                 std::to_string(std::numeric_limits<std::uint32_t>::max()));
+    }
+    prescale_ = static_cast<std::uint32_t>(prescale);
+    prescaleCounter_ = 0;
+    shedGroup_ = nullptr;
+    if (parameters_.contains("shed_group")) {
+        shedGroup_ = &PrescaleRegistry::instance().group(parameters_["shed_group"].get<std::string>());
+    }
+
     OnInit();
-}
\ No newline at end of file
+
+    // Record static prescales with the results so they can be reweighted
+    if (prescale_ > 1 && dataProductManager_) {
+        const std::string name = prescaleProductName();
+        auto product = std::make_unique<PipelineDataProduct>();
+        product->setName(name);
+        product->setObject(std::make_unique<TParameter<Long64_t>>(name.c_str(), static_cast<Long64_t>(prescale_)));
+        product->addTag("prescale");
+        dataProductManager_->addOrUpdate(name, std::move(product));
+    }
+}
+
+// "prescale/stage/<prescale_name>", or for an unnamed stage its class name,
+// suffixed "#2", "#3", ... for further prescaled instances in configuration order
+std::string BaseStage::prescaleProductName() {
+    if (parameters_.contains("prescale_name")) {
+        prescaleProduct_ = "prescale/stage/" + parameters_["prescale_name"].get<std::string>();
+        return prescaleProduct_;
+    }
+    if (!prescaleProduct_.empty()) return prescaleProduct_;  // re-initialized
+
+    const std::string base = "prescale/stage/" + Name();
+    std::string name = base;
+    for (int instance = 2; dataProductManager_->hasProduct(name); ++instance) {
+        name = base + "#" + std::to_string(instance);
+    }
+    prescaleProduct_ = name;
+    return prescaleProduct_;
+}
+
+std::uint32_t BaseStage::EffectivePrescale() const {
+    std::uint32_t factor = prescale_;
+    if (shedGroup_) factor = std::max(factor, shedGroup_->factor());
+    return factor;
+}
+
+namespace {
+
+// Context of the Execute() call running on this thread, for RejectEvent()/CurrentEvent()
+thread_local EventContext* currentEvent = nullptr;
+
+EventContext& threadEvent() {
+    thread_local EventContext event;
+    return event;
+}
+
+}  // namespace
+
+bool BaseStage::Execute() {
+    return Execute(threadEvent());
+}
+
+bool BaseStage::Execute(EventContext& event) {
+    if (StartsEvent()) {
+        event.begin();
+    } else if (event.rejected && !RunsOnRejectedEvents()) {
+        return false;
+    }
+    if (prescale_ > 1 || shedGroup_) {
+        const std::uint64_t n = prescaleCounter_++;
+        const std::uint32_t factor = EffectivePrescale();
+        if (factor > 1 && n % factor != 0) return false;
+    }
+
+    struct Scope {
+        EventContext* previous;
+        ~Scope() { currentEvent = previous; }
+    } scope{std::exchange(currentEvent, &event)};
+    Process();
+    return true;
+}
+
+void BaseStage::RejectEvent() {
+    if (!currentEvent) {
+        throw std::logic_error(Name() + ": RejectEvent() called outside Execute()");
+    }
+    currentEvent->rejected = true;
+}
+
+const EventContext& BaseStage::CurrentEvent() const {
+    return currentEvent ? *currentEvent : threadEvent();
+}
@@ -1,7 +1,9 @@
 #include "analysis_pipeline/core/stages/data_management/clear_products_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
 #include "spdlog/spdlog.h"
 
 ClassImp(ClearProductsStage)
+REGISTER_STAGE(ClearProductsStage)
 
 void ClearProductsStage::OnInit() {
     productsToClear_.clear();
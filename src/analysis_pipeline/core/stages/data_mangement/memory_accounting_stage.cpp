@@ -0,0 +1,40 @@
+#include "analysis_pipeline/core/stages/data_management/memory_accounting_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "spdlog/spdlog.h"
+
+ClassImp(MemoryAccountingStage)
+REGISTER_STAGE(MemoryAccountingStage)
+
+void MemoryAccountingStage::OnInit() {
+    everyNEvents_ = parameters_.value("every_n_events", std::uint64_t{1000});
+    refresh_ = parameters_.value("refresh", true);
+    prefix_ = parameters_.value("prefix", "memory/");
+    eventsSeen_ = 0;
+
+    if (everyNEvents_ == 0) {
+        throw std::runtime_error("MemoryAccountingStage: every_n_events must be positive");
+    }
+
+    if (parameters_.contains("limits")) {
+        auto limits = MemoryLimitConfig::fromJson(parameters_["limits"]);
+        getDataProductManager()->setMemoryLimits(limits);
+        spdlog::debug("[{}] Memory limits: max {} bytes, {} tag limits, policy {}",
+                      Name(), limits.maxBytes, limits.tagLimits.size(),
+                      limits.policy == MemoryLimitPolicy::EvictLru ? "evict_lru" : "reject");
+    }
+}
+
+void MemoryAccountingStage::Process() {
+    if (eventsSeen_++ % everyNEvents_ != 0) return;
+
+    auto manager = getDataProductManager();
+    if (refresh_) {
+        manager->refreshMemoryUsage();
+    }
+    auto report = manager->getMemoryUsage();
+    report.publish(*manager, prefix_);
+
+    spdlog::debug("[{}] {} bytes in {} products (high water {}), {} rejected, {} evicted",
+                  Name(), report.total.bytes, report.total.products, report.total.highWater,
+                  report.rejected, report.evicted);
+}
@@ -0,0 +1,118 @@
+#include "analysis_pipeline/core/stages/filters/adaptive_prescale_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/execution/prescale_registry.h"
+#include <TParameter.h>
+#include <algorithm>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+ClassImp(AdaptivePrescaleStage)
+REGISTER_STAGE(AdaptivePrescaleStage)
+
+void AdaptivePrescaleStage::OnInit() {
+    groupName_ = parameters_.value("group", "monitoring");
+    targetRateHz_ = parameters_.value("target_rate_hz", 0.0);
+    maxQueueFill_ = parameters_.value("max_queue_fill", 0.0);
+    queuePrefix_ = parameters_.value("queue_prefix", "ingest_queue/");
+    interval_ = std::chrono::milliseconds(parameters_.value("interval_ms", 1000));
+    const auto maxPrescale = parameters_.value("max_prescale", std::int64_t{1024});
+    hysteresis_ = parameters_.value("hysteresis", 0.2);
+    prefix_ = parameters_.value("prefix", "prescale/");
+
+    if (targetRateHz_ < 0.0 || maxQueueFill_ < 0.0 || maxQueueFill_ > 1.0) {
+        throw std::runtime_error("AdaptivePrescaleStage: target_rate_hz must be >= 0 and max_queue_fill in [0, 1]");
+    }
+    if (targetRateHz_ == 0.0 && maxQueueFill_ == 0.0) {
+        throw std::runtime_error("AdaptivePrescaleStage: set target_rate_hz and/or max_queue_fill");
+    }
+    if (interval_.count() <= 0 || maxPrescale <= 0) {
+        throw std::runtime_error("AdaptivePrescaleStage: interval_ms and max_prescale must be positive");
+    }
+    if (maxPrescale > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("AdaptivePrescaleStage: max_prescale must be at most " +
+                                 std::to_string(std::numeric_limits<std::uint32_t>::max()));
+    }
+    maxPrescale_ = static_cast<std::uint32_t>(maxPrescale);
+    if (hysteresis_ < 0.0 || hysteresis_ >= 1.0) {
+        throw std::runtime_error("AdaptivePrescaleStage: hysteresis must be in [0, 1)");
+    }
+
+    group_ = &PrescaleRegistry::instance().group(groupName_);
+    windowStart_ = std::chrono::steady_clock::now();
+    latencySum_ = {};
+    windowEvents_ = 0;
+    publish(group_->factor());
+
+    spdlog::debug("[{}] Controlling group '{}': target {} Hz, max queue fill {}", Name(), groupName_,
+                  targetRateHz_, maxQueueFill_);
+}
+
+void AdaptivePrescaleStage::Process() {
+    const auto now = std::chrono::steady_clock::now();
+    const auto start = CurrentEvent().start;
+    if (start.time_since_epoch().count() != 0 && start <= now) {
+        latencySum_ += now - start;
+        ++windowEvents_;
+    }
+    if (now - windowStart_ >= interval_) {
+        update(now);
+    }
+}
+
+double AdaptivePrescaleStage::queueFill() const {
+    auto manager = getDataProductManager();
+    auto occupancyHandle = manager->tryCheckoutRead(queuePrefix_ + "occupancy");
+    auto capacityHandle = manager->tryCheckoutRead(queuePrefix_ + "capacity");
+    if (!occupancyHandle || !capacityHandle) return 0.0;
+
+    auto* occupancy = dynamic_cast<const TParameter<Long64_t>*>(occupancyHandle->getObject());
+    auto* capacity = dynamic_cast<const TParameter<Long64_t>*>(capacityHandle->getObject());
+    if (!occupancy || !capacity || capacity->GetVal() <= 0) return 0.0;
+    return static_cast<double>(occupancy->GetVal()) / static_cast<double>(capacity->GetVal());
+}
+
+void AdaptivePrescaleStage::update(std::chrono::steady_clock::time_point now) {
+    bool overloaded = false;
+    bool relaxed = true;
+
+    if (targetRateHz_ > 0.0 && windowEvents_ > 0) {
+        const double meanLatency = std::chrono::duration<double>(latencySum_).count() / windowEvents_;
+        const double budget = 1.0 / targetRateHz_;
+        overloaded |= meanLatency > budget;
+        relaxed &= meanLatency < budget * (1.0 - hysteresis_);
+    }
+    if (maxQueueFill_ > 0.0) {
+        const double fill = queueFill();
+        overloaded |= fill > maxQueueFill_;
+        relaxed &= fill < maxQueueFill_ * (1.0 - hysteresis_);
+    }
+
+    const std::uint32_t current = group_->factor();
+    std::uint64_t next = current;
+    if (overloaded) {
+        next = std::min<std::uint64_t>(maxPrescale_, std::uint64_t{current} * 2);
+    } else if (relaxed && current > 1) {
+        next = current / 2;
+    }
+
+    // Each worker chain runs its own controller on the shared group; only
+    // the first to claim this interval applies its step
+    if (next != current &&
+        group_->adjust(current, static_cast<std::uint32_t>(next), now, interval_)) {
+        publish(static_cast<std::uint32_t>(next));
+        spdlog::info("[{}] Group '{}' prescale {} -> {}", Name(), groupName_, current, next);
+    }
+
+    windowStart_ = now;
+    latencySum_ = {};
+    windowEvents_ = 0;
+}
+
+void AdaptivePrescaleStage::publish(std::uint32_t factor) {
+    std::string name = prefix_ + groupName_;
+    auto product = std::make_unique<PipelineDataProduct>();
+    product->setName(name);
+    product->setObject(std::make_unique<TParameter<Long64_t>>(name.c_str(), static_cast<Long64_t>(factor)));
+    product->addTag("prescale");
+    getDataProductManager()->addOrUpdate(name, std::move(product));
+}
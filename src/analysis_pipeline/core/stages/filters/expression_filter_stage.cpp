@@ -0,0 +1,59 @@
+#include "analysis_pipeline/core/stages/filters/expression_filter_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "spdlog/spdlog.h"
+
+ClassImp(ExpressionFilterStage)
+REGISTER_STAGE(ExpressionFilterStage)
+
+ExpressionFilterStage::~ExpressionFilterStage() {
+    if (expression_ && passed_ + rejected_ > 0) {
+        spdlog::info("[{}] '{}': {} passed, {} rejected", Name(), expression_->source(), passed_, rejected_);
+    }
+}
+
+void ExpressionFilterStage::OnInit() {
+    if (!parameters_.contains("expression") || !parameters_["expression"].is_string()) {
+        throw std::runtime_error("ExpressionFilterStage: 'expression' must be a string");
+    }
+
+    const std::string onMissing = parameters_.value("on_missing", "reject");
+    if (onMissing == "reject") {
+        onMissing_ = MissingPolicy::Reject;
+    } else if (onMissing == "pass") {
+        onMissing_ = MissingPolicy::Pass;
+    } else if (onMissing == "error") {
+        onMissing_ = MissingPolicy::Error;
+    } else {
+        throw std::runtime_error("ExpressionFilterStage: unknown on_missing '" + onMissing + "'");
+    }
+    invert_ = parameters_.value("invert", false);
+
+    // ExpressionError carries the position of the syntax error in its message
+    expression_ = std::make_unique<Expression>(Expression::compile(parameters_["expression"].get<std::string>()));
+    passed_ = 0;
+    rejected_ = 0;
+
+    spdlog::debug("[{}] Compiled '{}' into {} nodes{}", Name(), expression_->source(),
+                  expression_->nodeCount(), expression_->isConstant() ? " (constant)" : "");
+}
+
+void ExpressionFilterStage::Process() {
+    auto manager = getDataProductManager();
+
+    bool pass;
+    try {
+        pass = expression_->test(*manager) != invert_;
+    } catch (const MissingProductError& e) {
+        if (onMissing_ == MissingPolicy::Error) {
+            throw std::runtime_error("ExpressionFilterStage: " + std::string(e.what()));
+        }
+        pass = onMissing_ == MissingPolicy::Pass;
+    }
+
+    if (pass) {
+        ++passed_;
+    } else {
+        ++rejected_;
+        RejectEvent();
+    }
+}
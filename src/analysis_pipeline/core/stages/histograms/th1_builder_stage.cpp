@@ -1,8 +1,12 @@
 #include "analysis_pipeline/core/stages/histograms/th1_builder_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/data/histogram_publisher.h"
+#include "analysis_pipeline/core/data/products/windowed_th1d.h"
 #include <TParameter.h>
 #include <spdlog/spdlog.h>
 
 ClassImp(TH1BuilderStage)
+REGISTER_STAGE(TH1BuilderStage)
 
 void TH1BuilderStage::OnInit() {
     inputProductName_ = parameters_.value("input_product", "");
@@ -17,68 +21,138 @@ void TH1BuilderStage::OnInit() {
         throw std::runtime_error("TH1BuilderStage: input_product is required");
     }
 
+    // "window": {"length_ms": N, "slices": M} keeps only the last N ms of fills
+    windowMs_ = 0;
+    windowSlices_ = 0;
+    if (parameters_.contains("window")) {
+        const auto& window = parameters_["window"];
+        if (!window.is_object()) {
+            throw std::runtime_error("TH1BuilderStage: 'window' must be an object");
+        }
+        windowMs_ = window.value("length_ms", 0LL);
+        windowSlices_ = window.value("slices", 10u);
+        if (windowMs_ <= 0 || windowSlices_ == 0 || windowMs_ < static_cast<long long>(windowSlices_)) {
+            throw std::runtime_error("TH1BuilderStage: window needs length_ms >= slices > 0");
+        }
+        if (parameters_.contains("double_buffer") && parameters_["double_buffer"] != false) {
+            throw std::runtime_error("TH1BuilderStage: 'window' and 'double_buffer' cannot be combined");
+        }
+    }
+
+    if (doubleBuffer_) {
+        HistogramPublisher::instance().remove(doubleBuffer_);
+        doubleBuffer_.reset();
+    }
+
+    // "double_buffer": true or {"publish_interval_ms": N}
+    if (parameters_.contains("double_buffer") && parameters_["double_buffer"] != false) {
+        const auto& config = parameters_["double_buffer"];
+        int intervalMs = config.is_object() ? config.value("publish_interval_ms", 1000) : 1000;
+        if (intervalMs <= 0) {
+            throw std::runtime_error("TH1BuilderStage: double_buffer.publish_interval_ms must be positive");
+        }
+
+        auto prototype = std::make_unique<TH1D>(histogramName_.c_str(), title_.c_str(), bins_, min_, max_);
+        prototype->SetDirectory(nullptr);
+        doubleBuffer_ = std::make_shared<DoubleBufferedHistogram>(
+            std::move(prototype), histogramName_,
+            std::unordered_set<std::string>{"histogram", "built_by_th1_builder"},
+            std::chrono::milliseconds(intervalMs), getDataProductManager());
+        HistogramPublisher::instance().add(doubleBuffer_);
+
+        spdlog::debug("[{}] Double-buffered: publishing '{}' every {} ms", Name(), histogramName_, intervalMs);
+    }
+
     spdlog::debug("[{}] Configured to read from '{}', extract key '{}', and fill '{}'",
                  Name(), inputProductName_, valueKey_, histogramName_);
 }
 
-void TH1BuilderStage::Process() {
-    try {
-        spdlog::debug("[{}] Process started", Name());
+TH1BuilderStage::~TH1BuilderStage() {
+    // Unregister only: the manager may already be destroyed (see Finish)
+    if (doubleBuffer_) {
+        HistogramPublisher::instance().remove(doubleBuffer_, false);
+    }
+}
 
-        if (!getDataProductManager()->hasProduct(inputProductName_)) {
-            spdlog::error("[{}] Input product '{}' not found", Name(), inputProductName_);
-            return;
-        }
-        spdlog::debug("[{}] Input product '{}' found", Name(), inputProductName_);
+void TH1BuilderStage::Finish() {
+    if (!doubleBuffer_) return;
+    // Publishes the fills made since the last interval
+    HistogramPublisher::instance().remove(doubleBuffer_);
+    doubleBuffer_.reset();
+}
 
-        auto inputHandle = getDataProductManager()->checkoutRead(inputProductName_);
-        if (!inputHandle.get()) {
-            spdlog::error("[{}] Failed to lock input product '{}'", Name(), inputProductName_);
-            return;
-        }
-        spdlog::debug("[{}] Acquired read lock on input product '{}'", Name(), inputProductName_);
+// Reads the configured member of the input product; false if it is missing or unusable
+bool TH1BuilderStage::readValue(double& value) {
+    if (!getDataProductManager()->hasProduct(inputProductName_)) {
+        spdlog::error("[{}] Input product '{}' not found", Name(), inputProductName_);
+        return false;
+    }
+    spdlog::debug("[{}] Input product '{}' found", Name(), inputProductName_);
 
-        auto [memberPtr, memberType] = inputHandle->getMemberPointerAndType(valueKey_);
-        if (!memberPtr) {
-            spdlog::error("[{}] Member '{}' not found in product '{}'", Name(), valueKey_, inputProductName_);
-            return;
-        }
-        spdlog::debug("[{}] Found member '{}' of type '{}' in input product", Name(), valueKey_, memberType);
+    auto inputHandle = getDataProductManager()->checkoutRead(inputProductName_);
+    if (!inputHandle.get()) {
+        spdlog::error("[{}] Failed to lock input product '{}'", Name(), inputProductName_);
+        return false;
+    }
+    spdlog::debug("[{}] Acquired read lock on input product '{}'", Name(), inputProductName_);
+
+    auto [memberPtr, memberType] = inputHandle->getMemberPointerAndType(valueKey_);
+    if (!memberPtr) {
+        spdlog::error("[{}] Member '{}' not found in product '{}'", Name(), valueKey_, inputProductName_);
+        return false;
+    }
+    spdlog::debug("[{}] Found member '{}' of type '{}' in input product", Name(), valueKey_, memberType);
+
+    if (memberType == "double" || memberType == "Double_t") {
+        value = *static_cast<const double*>(memberPtr);
+    } else if (memberType == "float" || memberType == "Float_t") {
+        value = static_cast<double>(*static_cast<const float*>(memberPtr));
+    } else if (memberType == "int" || memberType == "Int_t") {
+        value = static_cast<double>(*static_cast<const int*>(memberPtr));
+    } else if (memberType == "short" || memberType == "Short_t") {
+        value = static_cast<double>(*static_cast<const short*>(memberPtr));
+    } else {
+        spdlog::error("[{}] Unsupported member type '{}'", Name(), memberType);
+        return false;
+    }
+    spdlog::debug("[{}] Converted member '{}' value to fill: {}", Name(), valueKey_, value);
+    return true;
+}
+
+void TH1BuilderStage::Process() {
+    try {
+        spdlog::debug("[{}] Process started", Name());
 
         double valueToFill = 0.0;
-        bool canFill = false;
-
-        if (memberType == "double" || memberType == "Double_t") {
-            valueToFill = *static_cast<const double*>(memberPtr);
-            canFill = true;
-        } else if (memberType == "float" || memberType == "Float_t") {
-            valueToFill = static_cast<double>(*static_cast<const float*>(memberPtr));
-            canFill = true;
-        } else if (memberType == "int" || memberType == "Int_t") {
-            valueToFill = static_cast<double>(*static_cast<const int*>(memberPtr));
-            canFill = true;
-        } else if (memberType == "short" || memberType == "Short_t") {
-            valueToFill = static_cast<double>(*static_cast<const short*>(memberPtr));
-            canFill = true;
-        } else {
-            spdlog::error("[{}] Unsupported member type '{}'", Name(), memberType);
-            return;
-        }
+        const bool haveValue = readValue(valueToFill);
 
-        if (!canFill) {
-            spdlog::debug("[{}] Could not convert member '{}' to double; skipping fill", Name(), valueKey_);
+        // The double buffer never touches the product lock
+        if (doubleBuffer_) {
+            if (!haveValue) return;
+            doubleBuffer_->fill(valueToFill);
+            spdlog::debug("[{}] Filled live buffer of '{}' with value {}", Name(), histogramName_, valueToFill);
             return;
         }
-        spdlog::debug("[{}] Converted member '{}' value to fill: {}", Name(), valueKey_, valueToFill);
+
+        // A windowed histogram still has to age out old slices on events that fill nothing
+        if (!haveValue && windowMs_ == 0) return;
 
         if (!getDataProductManager()->hasProduct(histogramName_)) {
+            if (!haveValue) return;
             spdlog::debug("[{}] Histogram '{}' does not exist; creating new", Name(), histogramName_);
-            auto newHist = std::make_unique<TH1D>(histogramName_.c_str(), title_.c_str(), bins_, min_, max_);
+            std::unique_ptr<TH1D> newHist;
+            if (windowMs_ > 0) {
+                newHist = std::make_unique<WindowedTH1D>(histogramName_.c_str(), title_.c_str(), bins_, min_, max_,
+                                                         std::chrono::milliseconds(windowMs_), windowSlices_);
+            } else {
+                newHist = std::make_unique<TH1D>(histogramName_.c_str(), title_.c_str(), bins_, min_, max_);
+            }
             auto newProduct = std::make_unique<PipelineDataProduct>();
             newProduct->setName(histogramName_);
             newProduct->setObject(std::move(newHist));
             newProduct->addTag("histogram");
             newProduct->addTag("built_by_th1_builder");
+            if (windowMs_ > 0) newProduct->addTag("windowed");
             getDataProductManager()->addOrUpdate(histogramName_, std::move(newProduct));
             spdlog::debug("[{}] Histogram '{}' created", Name(), histogramName_);
         } else {
@@ -100,6 +174,10 @@ void TH1BuilderStage::Process() {
         }
         spdlog::debug("[{}] Successfully cast object '{}' to TH1", Name(), histogramName_);
 
+        if (auto* windowed = dynamic_cast<WindowedTH1D*>(hist)) {
+            windowed->advance(WindowedTH1D::Clock::now());
+        }
+        if (!haveValue) return;
         hist->Fill(valueToFill);
         spdlog::debug("[{}] Filled histogram '{}' with value {}", Name(), histogramName_, valueToFill);
 
@@ -107,7 +185,3 @@ void TH1BuilderStage::Process() {
         spdlog::error("[{}] Exception in Process: {}", Name(), e.what());
     }
 }
-
-
-
-
@@ -0,0 +1,116 @@
+#include "analysis_pipeline/core/stages/input/event_replay_input_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include <spdlog/spdlog.h>
+#include <thread>
+
+ClassImp(EventReplayInputStage)
+REGISTER_STAGE(EventReplayInputStage)
+
+void EventReplayInputStage::OnInit() {
+    filePath_ = parameters_.value("file", "");
+    productName_ = parameters_.value("product_name", "raw_event");
+    loop_ = parameters_.value("loop", false);
+    speed_ = parameters_.value("speed", 1.0);
+
+    if (filePath_.empty()) {
+        throw std::runtime_error("EventReplayInputStage: file is required");
+    }
+
+    std::string format = parameters_.value("format", "raw");
+    if (format == "raw") {
+        format_ = RawEventProduct::Format::Raw;
+    } else if (format == "midas") {
+        format_ = RawEventProduct::Format::Midas;
+    } else {
+        throw std::runtime_error("EventReplayInputStage: unknown format '" + format + "'");
+    }
+
+    std::string rate = parameters_.value("rate", "max");
+    if (rate == "max") {
+        originalRate_ = false;
+    } else if (rate == "original") {
+        originalRate_ = true;
+    } else {
+        throw std::runtime_error("EventReplayInputStage: unknown rate '" + rate + "' (expected 'max' or 'original')");
+    }
+    if (speed_ <= 0.0) {
+        throw std::runtime_error("EventReplayInputStage: speed must be positive");
+    }
+
+    auto shardCount = parameters_.value("shard_count", std::size_t{1});
+    auto shardIndex = parameters_.value("shard_index", std::size_t{0});
+    if (shardCount == 0 || shardIndex >= shardCount) {
+        throw std::runtime_error("EventReplayInputStage: shard_index must be < shard_count");
+    }
+
+    reader_ = std::make_unique<EventRecordReader>(filePath_);
+
+    const std::size_t total = reader_->size();
+    shardBegin_ = total * shardIndex / shardCount;
+    shardEnd_ = total * (shardIndex + 1) / shardCount;
+    next_ = shardBegin_;
+    exhausted_ = shardBegin_ == shardEnd_;
+    timingStarted_ = false;
+
+    spdlog::debug("[{}] Replaying events [{}, {}) of {} from '{}' (rate={}, loop={})",
+                  Name(), shardBegin_, shardEnd_, total, filePath_, rate, loop_);
+}
+
+void EventReplayInputStage::SetInput(const InputBundle& input) {
+    if (input.has<std::size_t>("replay_seek")) {
+        std::size_t target = shardBegin_ + input.get<std::size_t>("replay_seek");
+        if (target >= shardEnd_) {
+            throw std::runtime_error("EventReplayInputStage: seek beyond end of shard");
+        }
+        next_ = target;
+        exhausted_ = false;
+        timingStarted_ = false;
+    }
+}
+
+void EventReplayInputStage::Process() {
+    if (!reader_ || exhausted_) {
+        spdlog::debug("[{}] No more events to replay", Name());
+        return;
+    }
+
+    const std::size_t index = next_;
+    if (originalRate_) {
+        waitForOriginalTime(reader_->entry(index).timestampNs);
+    }
+
+    try {
+        auto product = std::make_unique<PipelineDataProduct>();
+        product->setName(productName_);
+        product->setObject(std::make_unique<RawEventProduct>(reader_->event(index), format_));
+        product->addTag("raw_event");
+        product->addTag("built_by_event_replay_input");
+        getDataProductManager()->addOrUpdate(productName_, std::move(product));
+    } catch (const std::exception& e) {
+        spdlog::error("[{}] Failed to publish event {}: {}", Name(), index, e.what());
+    }
+
+    if (++next_ >= shardEnd_) {
+        if (loop_) {
+            next_ = shardBegin_;
+            timingStarted_ = false;
+        } else {
+            exhausted_ = true;
+        }
+    }
+}
+
+void EventReplayInputStage::waitForOriginalTime(std::uint64_t timestampNs) {
+    if (!timingStarted_) {
+        timingStarted_ = true;
+        firstTimestampNs_ = timestampNs;
+        wallStart_ = std::chrono::steady_clock::now();
+        return;
+    }
+
+    if (timestampNs <= firstTimestampNs_) return;
+
+    auto offset = std::chrono::nanoseconds(
+        static_cast<std::int64_t>(static_cast<double>(timestampNs - firstTimestampNs_) / speed_));
+    std::this_thread::sleep_until(wallStart_ + offset);
+}
@@ -0,0 +1,55 @@
+#include "analysis_pipeline/core/stages/input/raw_event_input_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include <spdlog/spdlog.h>
+
+ClassImp(RawEventInputStage)
+REGISTER_STAGE(RawEventInputStage)
+
+void RawEventInputStage::OnInit() {
+    inputKey_ = parameters_.value("input_key", "raw_event");
+    productName_ = parameters_.value("product_name", "raw_event");
+
+    std::string format = parameters_.value("format", "raw");
+    if (format == "raw") {
+        format_ = RawEventProduct::Format::Raw;
+    } else if (format == "midas") {
+        format_ = RawEventProduct::Format::Midas;
+    } else {
+        throw std::runtime_error("RawEventInputStage: unknown format '" + format + "' (expected 'raw' or 'midas')");
+    }
+
+    spdlog::debug("[{}] Reading '{}' from input bundle as {} into product '{}'",
+                  Name(), inputKey_, format, productName_);
+}
+
+void RawEventInputStage::SetInput(const InputBundle& input) {
+    if (input.has<std::shared_ptr<const RawEventBuffer>>(inputKey_)) {
+        pending_ = input.get<std::shared_ptr<const RawEventBuffer>>(inputKey_);
+    } else if (input.has<std::string>(inputKey_)) {
+        pending_ = RawEventBuffer::fromFile(input.get<std::string>(inputKey_));
+    } else {
+        throw std::runtime_error("RawEventInputStage: input key '" + inputKey_ +
+                                 "' missing or not a RawEventBuffer/file path");
+    }
+}
+
+void RawEventInputStage::Process() {
+    if (!pending_) {
+        spdlog::error("[{}] Process called without input", Name());
+        return;
+    }
+
+    try {
+        auto product = std::make_unique<PipelineDataProduct>();
+        product->setName(productName_);
+        product->setObject(std::make_unique<RawEventProduct>(std::move(pending_), format_));
+        product->addTag("raw_event");
+        product->addTag("built_by_raw_event_input");
+        getDataProductManager()->addOrUpdate(productName_, std::move(product));
+    } catch (const std::exception& e) {
+        spdlog::error("[{}] Failed to publish raw event: {}", Name(), e.what());
+    }
+
+    // The product now holds the only reference this stage had
+    pending_.reset();
+}
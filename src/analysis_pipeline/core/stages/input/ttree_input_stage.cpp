@@ -0,0 +1,548 @@
+#include "analysis_pipeline/core/stages/input/ttree_input_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/data/product_merger.h"
+#include "analysis_pipeline/core/data/products/value_batch.h"
+#include <Bytes.h>
+#include <TBranch.h>
+#include <TBranchElement.h>
+#include <TBranchObject.h>
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <TFile.h>
+#include <TLeaf.h>
+#include <TObjArray.h>
+#include <TParameter.h>
+#include <TROOT.h>
+#include <TTree.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <functional>
+
+ClassImp(TTreeInputStage)
+REGISTER_STAGE(TTreeInputStage)
+
+// Appends `count` values of a basket serialized by TBulkBranchRead (big-endian) as doubles
+using DecodeFn = void (*)(char* data, std::size_t count, std::vector<double>& out);
+
+struct TTreeInputStage::BranchReader {
+    std::string branchName;
+    std::string productName;
+    TBranch* branch = nullptr;
+    TLeaf* scalarLeaf = nullptr;                           // set for single-valued numeric leaves
+    std::function<std::unique_ptr<TObject>()> read;        // product object for the entry just read
+
+    // Batch mode: fixed-size numeric scalars are read a basket at a time
+    DecodeFn decode = nullptr;
+    std::size_t valueSize = 0;
+    std::unique_ptr<TBufferFile> bulkBuffer;
+};
+
+namespace {
+
+template <typename T>
+void decodeSerialized(char* data, std::size_t count, std::vector<double>& out) {
+    for (std::size_t i = 0; i < count; ++i) {
+        T value;
+        frombuf(data, &value);  // advances data
+        out.push_back(static_cast<double>(value));
+    }
+}
+
+struct BulkType {
+    const char* typeName;
+    DecodeFn decode;
+    std::size_t size;
+};
+
+constexpr BulkType kBulkTypes[] = {
+    {"Double_t", &decodeSerialized<Double_t>, sizeof(Double_t)},
+    {"Float_t", &decodeSerialized<Float_t>, sizeof(Float_t)},
+    {"Long64_t", &decodeSerialized<Long64_t>, sizeof(Long64_t)},
+    {"ULong64_t", &decodeSerialized<ULong64_t>, sizeof(ULong64_t)},
+    {"Int_t", &decodeSerialized<Int_t>, sizeof(Int_t)},
+    {"UInt_t", &decodeSerialized<UInt_t>, sizeof(UInt_t)},
+    {"Short_t", &decodeSerialized<Short_t>, sizeof(Short_t)},
+    {"UShort_t", &decodeSerialized<UShort_t>, sizeof(UShort_t)},
+    {"Char_t", &decodeSerialized<Char_t>, sizeof(Char_t)},
+    {"UChar_t", &decodeSerialized<UChar_t>, sizeof(UChar_t)},
+    {"Bool_t", &decodeSerialized<Bool_t>, sizeof(Bool_t)},
+};
+
+const BulkType* bulkTypeFor(const TLeaf& leaf) {
+    const std::string typeName = leaf.GetTypeName();
+    for (const auto& type : kBulkTypes) {
+        if (typeName == type.typeName) return &type;
+    }
+    return nullptr;
+}
+
+using ReadFn = std::function<std::unique_ptr<TObject>()>;
+
+ReadFn bindScalarLeaf(TLeaf* leaf, const std::string& productName) {
+    return [leaf, productName]() -> std::unique_ptr<TObject> {
+        return std::make_unique<TParameter<double>>(productName.c_str(), leaf->GetValue(0));
+    };
+}
+
+ReadFn bindArrayLeaf(TLeaf* leaf) {
+    return [leaf]() -> std::unique_ptr<TObject> {
+        const int length = leaf->GetLen();
+        auto batch = std::make_unique<ValueBatch>();
+        batch->resize(static_cast<std::size_t>(std::max(length, 0)));
+        for (int i = 0; i < length; ++i) batch->data()[i] = leaf->GetValue(i);
+        return batch;
+    };
+}
+
+// The tree reads into a vector it allocates; `holder` keeps the pointer alive as long as the reader
+template <typename T>
+ReadFn bindVector(TTree& tree, const std::string& branchName) {
+    std::shared_ptr<std::vector<T>*> holder(new std::vector<T>*(nullptr), [](std::vector<T>** pointer) {
+        delete *pointer;
+        delete pointer;
+    });
+    tree.SetBranchAddress(branchName.c_str(), holder.get());
+    return [holder]() -> std::unique_ptr<TObject> {
+        auto batch = std::make_unique<ValueBatch>();
+        if (const std::vector<T>* values = *holder) {
+            batch->values().assign(values->begin(), values->end());
+        }
+        return batch;
+    };
+}
+
+// The tree reads into an object of `cls` it allocates; the address it is given is
+// that of the full object, which need not be where its TObject base sits
+ReadFn bindObject(TTree& tree, const std::string& branchName, TClass* cls) {
+    std::shared_ptr<void*> holder(new void*(nullptr), [cls](void** pointer) {
+        if (*pointer) cls->Destructor(*pointer);
+        delete pointer;
+    });
+    tree.SetBranchAddress(branchName.c_str(), holder.get());
+    return [holder, cls]() -> std::unique_ptr<TObject> {
+        if (!*holder) return nullptr;
+        auto* object = static_cast<TObject*>(cls->DynamicCast(TObject::Class(), *holder));
+        if (!object) return nullptr;
+        return ProductMerger::clone(*object);
+    };
+}
+
+ReadFn bindVectorByClass(TTree& tree, const std::string& branchName, const std::string& className) {
+    if (className == "vector<double>") return bindVector<double>(tree, branchName);
+    if (className == "vector<float>") return bindVector<float>(tree, branchName);
+    if (className == "vector<int>") return bindVector<int>(tree, branchName);
+    if (className == "vector<unsigned int>") return bindVector<unsigned int>(tree, branchName);
+    if (className == "vector<short>") return bindVector<short>(tree, branchName);
+    if (className == "vector<Long64_t>" || className == "vector<long long>") {
+        return bindVector<Long64_t>(tree, branchName);
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TTreeInputStage::TTreeInputStage() = default;
+
+TTreeInputStage::~TTreeInputStage() {
+    stopReader();
+    if (!filePath_.empty()) {
+        spdlog::debug("[{}] Read {} entries from '{}' ({} read errors)",
+                      Name(), entriesRead_, filePath_, readErrors_);
+    }
+    // Readers own buffers the tree still points at, so close the file first
+    tree_ = nullptr;
+    file_.reset();
+    readers_.clear();
+}
+
+void TTreeInputStage::OnInit() {
+    stopReader();
+    tree_ = nullptr;
+    file_.reset();
+    readers_.clear();
+
+    filePath_ = parameters_.value("file", "");
+    treeName_ = parameters_.value("tree", "");
+    productPrefix_ = parameters_.value("product_prefix", "");
+    entryProduct_ = parameters_.value("entry_product", "ttree_entry");
+    batchSize_ = parameters_.value("batch_size", std::size_t{1});
+    prefetch_ = parameters_.value("prefetch", std::size_t{1024});
+    loop_ = parameters_.value("loop", false);
+    const double cacheMb = parameters_.value("cache_size_mb", 32.0);
+
+    if (filePath_.empty()) {
+        throw std::runtime_error("TTreeInputStage: file is required");
+    }
+    if (treeName_.empty()) {
+        throw std::runtime_error("TTreeInputStage: tree is required");
+    }
+    if (batchSize_ == 0) {
+        throw std::runtime_error("TTreeInputStage: batch_size must be positive");
+    }
+    if (cacheMb < 0.0) {
+        throw std::runtime_error("TTreeInputStage: cache_size_mb must not be negative");
+    }
+    cacheBytes_ = static_cast<Long64_t>(cacheMb * 1024.0 * 1024.0);
+
+    auto shardCount = parameters_.value("shard_count", std::size_t{1});
+    auto shardIndex = parameters_.value("shard_index", std::size_t{0});
+    if (shardCount == 0 || shardIndex >= shardCount) {
+        throw std::runtime_error("TTreeInputStage: shard_index must be < shard_count");
+    }
+
+    // Every worker's instance reads its own file on its own thread
+    ROOT::EnableThreadSafety();
+
+    file_.reset(TFile::Open(filePath_.c_str(), "READ"));
+    if (!file_ || file_->IsZombie()) {
+        file_.reset();
+        throw std::runtime_error("TTreeInputStage: cannot open '" + filePath_ + "'");
+    }
+    tree_ = dynamic_cast<TTree*>(file_->Get(treeName_.c_str()));
+    if (!tree_) {
+        throw std::runtime_error("TTreeInputStage: no tree '" + treeName_ + "' in '" + filePath_ + "'");
+    }
+
+    tree_->SetBranchStatus("*", false);
+    if (parameters_.contains("branches")) {
+        if (!parameters_["branches"].is_array()) {
+            throw std::runtime_error("TTreeInputStage: 'branches' must be an array");
+        }
+        for (const auto& name : parameters_["branches"]) {
+            addBranch(name.get<std::string>(), true);
+        }
+    } else {
+        TObjArray* branches = tree_->GetListOfBranches();
+        for (int i = 0; i < branches->GetEntriesFast(); ++i) {
+            addBranch(branches->At(i)->GetName(), false);
+        }
+    }
+    if (readers_.empty()) {
+        throw std::runtime_error("TTreeInputStage: no readable branches in tree '" + treeName_ + "'");
+    }
+
+    const Long64_t total = tree_->GetEntries();
+    const Long64_t first = std::clamp<Long64_t>(parameters_.value("first_entry", Long64_t{0}), 0, total);
+    const Long64_t maxEntries = parameters_.value("max_entries", Long64_t{-1});
+    const Long64_t last = maxEntries < 0 ? total : std::min(total, first + maxEntries);
+    computeShard(shardIndex, shardCount, first, last);
+
+    // Only this shard's baskets of the enabled branches are cached, one cluster per read
+    if (cacheBytes_ > 0) {
+        tree_->SetCacheSize(cacheBytes_);
+        for (const auto& reader : readers_) {
+            tree_->AddBranchToCache(reader->branchName.c_str(), true);
+        }
+        tree_->StopCacheLearningPhase();
+        tree_->SetCacheEntryRange(shardBegin_, shardEnd_);
+        tree_->SetClusterPrefetch(true);
+    }
+
+    entriesRead_ = 0;
+    readErrors_ = 0;
+    exhausted_ = shardBegin_ == shardEnd_;
+    startReader(shardBegin_);
+
+    spdlog::debug("[{}] Reading entries [{}, {}) of {} from '{}:{}' ({} branches, batch {}, cache {} MB)",
+                  Name(), shardBegin_, shardEnd_, total, filePath_, treeName_,
+                  readers_.size(), batchSize_, cacheMb);
+}
+
+void TTreeInputStage::addBranch(const std::string& branchName, bool required) {
+    auto unsupported = [&](const std::string& why) {
+        if (required) {
+            throw std::runtime_error("TTreeInputStage: branch '" + branchName + "' " + why);
+        }
+        spdlog::debug("[{}] Skipping branch '{}': {}", Name(), branchName, why);
+    };
+
+    TBranch* branch = tree_->GetBranch(branchName.c_str());
+    if (!branch) {
+        unsupported("does not exist");
+        return;
+    }
+
+    auto reader = std::make_unique<BranchReader>();
+    reader->branchName = branchName;
+    reader->productName = productPrefix_ + branchName;
+    reader->branch = branch;
+
+    if (branch->IsA() == TBranchElement::Class() || branch->IsA() == TBranchObject::Class()) {
+        const std::string className = branch->GetClassName();
+        if (className.rfind("vector<", 0) == 0) {
+            reader->read = bindVectorByClass(*tree_, branchName, className);
+            if (!reader->read) {
+                unsupported("has unsupported element type '" + className + "'");
+                return;
+            }
+        } else {
+            TClass* cls = TClass::GetClass(className.c_str());
+            if (!cls || !cls->InheritsFrom(TObject::Class())) {
+                unsupported("holds '" + className + "', which is not a TObject");
+                return;
+            }
+            reader->read = bindObject(*tree_, branchName, cls);
+        }
+    } else if (branch->GetNleaves() == 1) {
+        auto* leaf = static_cast<TLeaf*>(branch->GetListOfLeaves()->At(0));
+        if (leaf->InheritsFrom("TLeafC")) {
+            unsupported("is a string");
+            return;
+        }
+        // Give the leaf (and its length leaf) their own buffers; GetValue() reads them in place
+        leaf->SetAddress(nullptr);
+        if (TLeaf* count = leaf->GetLeafCount()) count->SetAddress(nullptr);
+
+        if (!leaf->GetLeafCount() && leaf->GetLenStatic() == 1) {
+            reader->scalarLeaf = leaf;
+            reader->read = bindScalarLeaf(leaf, reader->productName);
+        } else {
+            reader->read = bindArrayLeaf(leaf);
+        }
+    } else {
+        unsupported("has several leaves");
+        return;
+    }
+
+    if (batchSize_ > 1 && !reader->scalarLeaf) {
+        // Batches are columns of one value per entry
+        if (required) {
+            throw std::runtime_error("TTreeInputStage: batch_size > 1 needs numeric scalar branches, but '" +
+                                     branchName + "' is not one");
+        }
+        spdlog::debug("[{}] Skipping non-scalar branch '{}' in batch mode", Name(), branchName);
+        return;
+    }
+    if (batchSize_ > 1 && branch->GetBulkRead().SupportsBulkRead()) {
+        if (const BulkType* type = bulkTypeFor(*reader->scalarLeaf)) {
+            reader->decode = type->decode;
+            reader->valueSize = type->size;
+            reader->bulkBuffer = std::make_unique<TBufferFile>(TBuffer::kWrite, 32 * 1024);
+        }
+    }
+
+    tree_->SetBranchStatus(branchName.c_str(), true);
+    readers_.push_back(std::move(reader));
+}
+
+void TTreeInputStage::computeShard(std::size_t shardIndex, std::size_t shardCount, Long64_t first, Long64_t last) {
+    // Shards start on cluster boundaries so that no two workers decompress the same baskets
+    std::vector<Long64_t> starts;
+    if (first < last) {
+        auto clusters = tree_->GetClusterIterator(first);
+        for (Long64_t start = clusters(); start < last; start = clusters()) {
+            start = std::max(start, first);
+            if (!starts.empty() && start <= starts.back()) break;
+            starts.push_back(start);
+        }
+    }
+
+    const std::size_t count = starts.size();
+    const std::size_t begin = count * shardIndex / shardCount;
+    const std::size_t end = count * (shardIndex + 1) / shardCount;
+    shardBegin_ = begin < count ? starts[begin] : last;
+    shardEnd_ = end < count ? starts[end] : last;
+    if (count < shardCount) {
+        spdlog::warn("[{}] Only {} clusters for {} shards; some shards are empty", Name(), count, shardCount);
+    }
+}
+
+void TTreeInputStage::startReader(Long64_t from) {
+    {
+        std::lock_guard lock(queueMutex_);
+        queue_.clear();
+        stopping_ = false;
+        readerDone_ = false;
+    }
+    reader_ = std::thread(&TTreeInputStage::runReader, this, from);
+}
+
+void TTreeInputStage::stopReader() {
+    {
+        std::lock_guard lock(queueMutex_);
+        stopping_ = true;
+    }
+    queueCv_.notify_all();
+    if (reader_.joinable()) {
+        reader_.join();
+    }
+    std::lock_guard lock(queueMutex_);
+    queue_.clear();
+}
+
+void TTreeInputStage::runReader(Long64_t from) {
+    const std::size_t capacity = std::max<std::size_t>(1, (prefetch_ + batchSize_ - 1) / batchSize_);
+    Long64_t entry = from;
+
+    try {
+        for (;;) {
+            if (entry >= shardEnd_) {
+                if (!loop_ || shardBegin_ == shardEnd_) break;
+                entry = shardBegin_;
+            }
+            const Long64_t last = std::min<Long64_t>(entry + static_cast<Long64_t>(batchSize_), shardEnd_);
+            auto chunk = readChunk(entry, last);
+            entry = last;
+
+            std::unique_lock lock(queueMutex_);
+            queueCv_.wait(lock, [&] { return queue_.size() < capacity || stopping_; });
+            if (stopping_) break;
+            queue_.push_back(std::move(chunk));
+            lock.unlock();
+            queueCv_.notify_all();
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("[{}] Reader stopped at entry {}: {}", Name(), entry, e.what());
+    }
+
+    {
+        std::lock_guard lock(queueMutex_);
+        readerDone_ = true;
+    }
+    queueCv_.notify_all();
+}
+
+std::unique_ptr<TTreeInputStage::Chunk> TTreeInputStage::readChunk(Long64_t first, Long64_t last) {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->firstEntry = first;
+    chunk->objects.resize(readers_.size());
+
+    std::vector<ValueBatch*> columns;
+    if (batchSize_ > 1) {
+        columns.reserve(readers_.size());
+        for (auto& object : chunk->objects) {
+            auto column = std::make_unique<ValueBatch>();
+            column->values().reserve(static_cast<std::size_t>(last - first));
+            columns.push_back(column.get());
+            object = std::move(column);
+        }
+    }
+
+    if (columns.empty()) {
+        for (Long64_t entry = first; entry < last; ++entry) {
+            if (tree_->GetEntry(entry) <= 0) {
+                if (readErrors_++ == 0) {
+                    spdlog::error("[{}] Failed to read entry {} of '{}'", Name(), entry, treeName_);
+                }
+                continue;
+            }
+            ++entriesRead_;
+            for (std::size_t i = 0; i < readers_.size(); ++i) {
+                chunk->objects[i] = readers_[i]->read();
+            }
+        }
+        return chunk;
+    }
+
+    // Batch mode: each column is read on its own, whole baskets at a time
+    // where the branch supports bulk reads, otherwise one entry at a time
+    bool failed = false;
+    for (std::size_t i = 0; i < readers_.size(); ++i) {
+        BranchReader& reader = *readers_[i];
+        std::vector<double>& values = columns[i]->values();
+        if (reader.decode && readBulk(reader, first, last, values)) continue;
+
+        values.clear();
+        for (Long64_t entry = first; entry < last; ++entry) {
+            if (reader.branch->GetEntry(entry) <= 0) {
+                if (readErrors_++ == 0) {
+                    spdlog::error("[{}] Failed to read entry {} of branch '{}'", Name(), entry, reader.branchName);
+                }
+                failed = true;
+                values.push_back(0.0);  // keeps the columns aligned
+                continue;
+            }
+            values.push_back(reader.scalarLeaf->GetValue(0));
+        }
+    }
+    if (!failed) entriesRead_ += static_cast<std::uint64_t>(last - first);
+    return chunk;
+}
+
+bool TTreeInputStage::readBulk(BranchReader& reader, Long64_t first, Long64_t last, std::vector<double>& values) {
+    TBufferFile& buffer = *reader.bulkBuffer;
+    for (Long64_t entry = first; entry < last;) {
+        // Returns every entry of the basket holding `entry`, starting with the basket's first
+        const Int_t count = reader.branch->GetBulkRead().GetEntriesSerialized(entry, buffer);
+        const Long64_t basketFirst = count > 0 ? reader.branch->GetBasketEntry()[reader.branch->GetReadBasket()] : 0;
+        if (count <= 0 || entry < basketFirst || entry >= basketFirst + count) {
+            // Fall back to per-entry reads for this branch from now on
+            spdlog::warn("[{}] Bulk read of branch '{}' failed at entry {}; reading it entry by entry",
+                         Name(), reader.branchName, entry);
+            reader.decode = nullptr;
+            reader.bulkBuffer.reset();
+            return false;
+        }
+
+        const Long64_t end = std::min(last, basketFirst + count);
+        char* data = buffer.GetCurrent() + static_cast<std::size_t>(entry - basketFirst) * reader.valueSize;
+        reader.decode(data, static_cast<std::size_t>(end - entry), values);
+        entry = end;
+    }
+    return true;
+}
+
+std::unique_ptr<TTreeInputStage::Chunk> TTreeInputStage::nextChunk() {
+    std::unique_lock lock(queueMutex_);
+    queueCv_.wait(lock, [this] { return !queue_.empty() || readerDone_; });
+    if (queue_.empty()) return nullptr;
+
+    auto chunk = std::move(queue_.front());
+    queue_.pop_front();
+    if (queue_.empty() && readerDone_) {
+        exhausted_ = true;
+    }
+    lock.unlock();
+    queueCv_.notify_all();
+    return chunk;
+}
+
+void TTreeInputStage::SetInput(const InputBundle& input) {
+    if (input.has<std::size_t>("replay_seek")) {
+        const Long64_t target = shardBegin_ + static_cast<Long64_t>(input.get<std::size_t>("replay_seek"));
+        if (target >= shardEnd_) {
+            throw std::runtime_error("TTreeInputStage: seek beyond end of shard");
+        }
+        stopReader();
+        exhausted_ = false;
+        startReader(target);
+    }
+}
+
+void TTreeInputStage::Process() {
+    if (!tree_ || exhausted_) {
+        spdlog::debug("[{}] No more entries to read", Name());
+        return;
+    }
+
+    auto chunk = nextChunk();
+    if (!chunk) {
+        exhausted_ = true;
+        spdlog::debug("[{}] No more entries to read", Name());
+        return;
+    }
+
+    std::vector<std::pair<std::string, std::unique_ptr<PipelineDataProduct>>> products;
+    products.reserve(readers_.size() + 1);
+    auto add = [&products](const std::string& name, std::unique_ptr<TObject> object) {
+        auto product = std::make_unique<PipelineDataProduct>();
+        product->setName(name);
+        product->setObject(std::move(object));
+        product->addTag("ttree_input");
+        product->addTag("built_by_ttree_input");
+        products.emplace_back(name, std::move(product));
+    };
+
+    for (std::size_t i = 0; i < readers_.size(); ++i) {
+        if (chunk->objects[i]) add(readers_[i]->productName, std::move(chunk->objects[i]));
+    }
+    if (!entryProduct_.empty()) {
+        add(entryProduct_, std::make_unique<TParameter<Long64_t>>(entryProduct_.c_str(), chunk->firstEntry));
+    }
+
+    try {
+        getDataProductManager()->addOrUpdateMultiple(std::move(products));
+    } catch (const std::exception& e) {
+        spdlog::error("[{}] Failed to publish entry {}: {}", Name(), chunk->firstEntry, e.what());
+    }
+}
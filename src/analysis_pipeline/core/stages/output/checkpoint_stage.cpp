@@ -0,0 +1,82 @@
+#include "analysis_pipeline/core/stages/output/checkpoint_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/data/product_checkpoint.h"
+#include <spdlog/spdlog.h>
+#include <filesystem>
+
+ClassImp(CheckpointStage)
+REGISTER_STAGE(CheckpointStage)
+
+CheckpointStage::CheckpointStage() = default;
+
+CheckpointStage::~CheckpointStage() {
+    // No final checkpoint here: the manager may already be destroyed (see Finish)
+    checkpointer_.reset();
+}
+
+void CheckpointStage::Finish() {
+    if (!checkpointer_) return;
+    checkpointer_->finish();
+    auto stats = checkpointer_->stats();
+    spdlog::debug("[{}] Wrote {} checkpoints ({} full), {} products, {} failed",
+                  Name(), stats.checkpoints, stats.fullCheckpoints, stats.productsWritten, stats.failures);
+}
+
+void CheckpointStage::OnInit() {
+    checkpointer_.reset();
+
+    auto config = ProductCheckpointConfig::fromJson(parameters_);
+    intervalMs_ = parameters_.value("interval_ms", 10000);
+    bool restoreAtInit = parameters_.value("restore", true);
+    bool lazy = parameters_.value("lazy", true);
+
+    if (config.path.empty()) {
+        throw std::runtime_error("CheckpointStage: file is required");
+    }
+    if (intervalMs_ < 0) {
+        throw std::runtime_error("CheckpointStage: interval_ms must not be negative");
+    }
+    if (config.compactRatio < 1.0) {
+        throw std::runtime_error("CheckpointStage: compact_ratio must be at least 1");
+    }
+
+    if (restoreAtInit) {
+        restore(config.path, lazy);
+    }
+
+    const std::string path = config.path;
+    checkpointer_ = std::make_unique<ProductCheckpointer>(*getDataProductManager(), std::move(config));
+    nextCheckpoint_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(intervalMs_);
+
+    spdlog::debug("[{}] Checkpointing to '{}' (interval {} ms)", Name(), path, intervalMs_);
+}
+
+void CheckpointStage::restore(const std::string& path, bool lazy) {
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        spdlog::info("[{}] No checkpoint at '{}', starting empty", Name(), path);
+        return;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        ProductCheckpointReader reader(path);
+        std::size_t restored = reader.restoreInto(*getDataProductManager(), lazy);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        spdlog::info("[{}] Restored {} products from '{}' (checkpoint {}, {} ms{})",
+                     Name(), restored, path, reader.lastSequence(), elapsed.count(), lazy ? ", lazy" : "");
+    } catch (const std::exception& e) {
+        // A damaged checkpoint must not stop the pipeline; it is rewritten in full
+        spdlog::error("[{}] Cannot restore from '{}': {}", Name(), path, e.what());
+    }
+}
+
+void CheckpointStage::Process() {
+    if (!checkpointer_ || intervalMs_ == 0) return;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextCheckpoint_) return;
+    nextCheckpoint_ = now + std::chrono::milliseconds(intervalMs_);
+    checkpointer_->request();
+}
@@ -0,0 +1,59 @@
+#include "analysis_pipeline/core/stages/output/product_recorder_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/data/product_codec.h"
+#include <spdlog/spdlog.h>
+
+ClassImp(ProductRecorderStage)
+REGISTER_STAGE(ProductRecorderStage)
+
+ProductRecorderStage::~ProductRecorderStage() {
+    if (writer_) {
+        spdlog::debug("[{}] Recorded {} events to '{}'", Name(), writer_->framesWritten(), filePath_);
+        writer_->close();
+    }
+}
+
+void ProductRecorderStage::OnInit() {
+    filePath_ = parameters_.value("file", "");
+    sampleEvery_ = parameters_.value("sample_every", std::uint64_t{1});
+    maxEvents_ = parameters_.value("max_events", std::uint64_t{0});
+
+    if (filePath_.empty()) {
+        throw std::runtime_error("ProductRecorderStage: file is required");
+    }
+    if (sampleEvery_ == 0) {
+        throw std::runtime_error("ProductRecorderStage: sample_every must be positive");
+    }
+
+    selection_ = ProductSelection::fromJson(parameters_, "ProductRecorderStage");
+
+    writer_ = std::make_unique<ProductRecordWriter>(filePath_);
+    eventsSeen_ = 0;
+
+    spdlog::debug("[{}] Recording {} products and {} tags every {} events to '{}'",
+                  Name(), selection_.names.size(), selection_.tags.size(), sampleEvery_, filePath_);
+}
+
+void ProductRecorderStage::Process() {
+    const std::uint64_t eventNumber = eventsSeen_++;
+    if (!writer_ || eventNumber % sampleEvery_ != 0) return;
+    if (maxEvents_ > 0 && writer_->framesWritten() >= maxEvents_) return;
+
+    try {
+        auto names = selection_.resolve(*getDataProductManager());
+        auto handles = getDataProductManager()->checkoutReadMultiple(names);
+
+        std::string records;
+        std::uint32_t count = 0;
+        for (const auto& handle : handles) {
+            if (!handle->getObject()) continue;
+            ProductCodec::encode(*handle, records);
+            ++count;
+        }
+        writer_->writeFrame(eventNumber, count, records);
+
+        spdlog::debug("[{}] Recorded {} products for event {}", Name(), count, eventNumber);
+    } catch (const std::exception& e) {
+        spdlog::error("[{}] Failed to record event {}: {}", Name(), eventNumber, e.what());
+    }
+}
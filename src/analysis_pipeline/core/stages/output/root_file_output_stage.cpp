@@ -0,0 +1,165 @@
+#include "analysis_pipeline/core/stages/output/root_file_output_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/data/product_merger.h"
+#include "analysis_pipeline/core/data/root_compression.h"
+#include <TFile.h>
+#include <TROOT.h>
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <filesystem>
+
+ClassImp(RootFileOutputStage)
+REGISTER_STAGE(RootFileOutputStage)
+
+RootFileOutputStage::~RootFileOutputStage() {
+    // No final snapshot here: the manager may already be destroyed (see Finish)
+    writer_.stop();
+    if (!filePath_.empty()) {
+        spdlog::debug("[{}] Queued {} writes, dropped {}, {} failed",
+                      Name(), batchesQueued_, batchesDropped_, writeFailures_);
+    }
+}
+
+void RootFileOutputStage::Finish() {
+    if (writer_.running() && eventsSeen_ > 0) {
+        try {
+            // End of run: this batch must not be dropped
+            enqueue(snapshot(), true);
+        } catch (const std::exception& e) {
+            spdlog::error("[{}] Failed to snapshot products at end of run: {}", Name(), e.what());
+        }
+    }
+    writer_.stop();
+}
+
+void RootFileOutputStage::OnInit() {
+    writer_.stop();
+
+    filePath_ = parameters_.value("file", "");
+    intervalMs_ = parameters_.value("interval_ms", 0);
+    rotate_ = parameters_.value("rotate", false);
+    keepFiles_ = parameters_.value("keep_files", std::size_t{0});
+    queueSize_ = parameters_.value("queue_size", std::size_t{2});
+    compression_ = RootCompression::fromJson(parameters_.value("compression", nlohmann::json()));
+
+    if (filePath_.empty()) {
+        throw std::runtime_error("RootFileOutputStage: file is required");
+    }
+    if (intervalMs_ < 0) {
+        throw std::runtime_error("RootFileOutputStage: interval_ms must not be negative");
+    }
+    if (queueSize_ == 0) {
+        throw std::runtime_error("RootFileOutputStage: queue_size must be positive");
+    }
+
+    selection_ = ProductSelection::fromJson(parameters_, "RootFileOutputStage");
+
+    batchesQueued_ = 0;
+    batchesDropped_ = 0;
+    eventsSeen_ = 0;
+    writeFailures_ = 0;
+    writtenFiles_.clear();
+    nextWrite_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(intervalMs_);
+
+    startWriter();
+
+    spdlog::debug("[{}] Writing to '{}' (interval {} ms, rotate {}, compression {})",
+                  Name(), filePath_, intervalMs_, rotate_, RootCompression::describe(compression_));
+}
+
+void RootFileOutputStage::Process() {
+    ++eventsSeen_;
+    if (intervalMs_ == 0) return;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextWrite_) return;
+    nextWrite_ = now + std::chrono::milliseconds(intervalMs_);
+
+    try {
+        enqueue(snapshot(), false);
+    } catch (const std::exception& e) {
+        spdlog::error("[{}] Failed to snapshot products: {}", Name(), e.what());
+    }
+}
+
+std::unique_ptr<RootFileOutputStage::Batch> RootFileOutputStage::snapshot() {
+    auto batch = std::make_unique<Batch>();
+    auto manager = getDataProductManager();
+    for (const auto& name : selection_.resolve(*manager)) {
+        auto handle = manager->tryCheckoutRead(name);  // may have been removed or evicted since
+        if (!handle || !handle->getObject()) continue;
+        batch->objects.emplace_back(name, ProductMerger::clone(*handle->getObject()));
+    }
+    return batch;
+}
+
+bool RootFileOutputStage::enqueue(std::unique_ptr<Batch> batch, bool wait) {
+    // Only Process() and Finish() enqueue, so numbering here stays in order
+    batch->sequence = batchesQueued_;
+    if (writer_.push(std::move(batch), wait)) {
+        if (batchesDropped_++ == 0) {
+            spdlog::warn("[{}] Writer is behind; dropping snapshot", Name());
+        }
+        return false;
+    }
+    ++batchesQueued_;
+    return true;
+}
+
+void RootFileOutputStage::startWriter() {
+    // Files are written from the I/O thread
+    ROOT::EnableThreadSafety();
+    writer_.start(queueSize_, [this](std::unique_ptr<Batch>& batch) {
+        try {
+            writeBatch(*batch);
+        } catch (const std::exception& e) {
+            ++writeFailures_;
+            spdlog::error("[{}] Failed to write '{}': {}", Name(), pathFor(batch->sequence), e.what());
+        }
+    });
+}
+
+std::string RootFileOutputStage::pathFor(std::uint64_t sequence) const {
+    if (!rotate_) return filePath_;
+    std::filesystem::path path(filePath_);
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "_%04llu", static_cast<unsigned long long>(sequence));
+    return (path.parent_path() / (path.stem().string() + suffix + path.extension().string())).string();
+}
+
+void RootFileOutputStage::writeBatch(const Batch& batch) {
+    const std::string finalPath = pathFor(batch.sequence);
+    const std::string tmpPath = temporaryFilePath(finalPath);
+
+    {
+        TFile file(tmpPath.c_str(), "RECREATE", "", compression_);
+        if (file.IsZombie()) {
+            throw std::runtime_error("cannot create '" + tmpPath + "'");
+        }
+        for (const auto& [name, object] : batch.objects) {
+            TDirectory* dir = &file;
+            std::string key = name;
+            auto slash = name.rfind('/');
+            if (slash != std::string::npos) {
+                dir = file.mkdir(name.substr(0, slash).c_str(), "", true);
+                key = name.substr(slash + 1);
+            }
+            if (!dir || dir->WriteTObject(object.get(), key.c_str(), "Overwrite") <= 0) {
+                spdlog::warn("[{}] Could not write '{}' to '{}'", Name(), name, tmpPath);
+            }
+        }
+        file.Close();
+    }
+
+    commitTemporaryFile(finalPath);
+    spdlog::debug("[{}] Wrote {} objects to '{}'", Name(), batch.objects.size(), finalPath);
+
+    if (rotate_ && keepFiles_ > 0) {
+        writtenFiles_.push_back(finalPath);
+        while (writtenFiles_.size() > keepFiles_) {
+            std::error_code ec;
+            std::filesystem::remove(writtenFiles_.front(), ec);
+            writtenFiles_.pop_front();
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#include "analysis_pipeline/core/stages/output/shared_memory_export_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include <TROOT.h>
+#include <spdlog/spdlog.h>
+#include <chrono>
+
+ClassImp(SharedMemoryExportStage)
+REGISTER_STAGE(SharedMemoryExportStage)
+
+SharedMemoryExportStage::~SharedMemoryExportStage() {
+    stopExporter();
+}
+
+void SharedMemoryExportStage::stopExporter() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void SharedMemoryExportStage::OnInit() {
+    stopExporter();
+
+    const std::string segment = parameters_.value("segment", "/analysis_pipeline");
+    const std::string format = parameters_.value("format", "json");
+    const auto slots = parameters_.value("slots", std::size_t{256});
+    const auto slotSize = parameters_.value("slot_size", std::size_t{1} << 20);
+    const bool unlinkOnClose = parameters_.value("unlink_on_close", true);
+    intervalMs_ = parameters_.value("interval_ms", 1000);
+
+    if (format == "json") {
+        format_ = shm_product_format::PayloadFormat::Json;
+    } else if (format == "root") {
+        format_ = shm_product_format::PayloadFormat::Root;
+    } else {
+        throw std::runtime_error("SharedMemoryExportStage: unknown format '" + format + "'");
+    }
+    if (intervalMs_ <= 0) {
+        throw std::runtime_error("SharedMemoryExportStage: interval_ms must be positive");
+    }
+
+    selection_ = ProductSelection::fromJson(parameters_, "SharedMemoryExportStage");
+    if (selection_.selectsAll()) {
+        selection_.tags.insert("histogram");
+    }
+
+    publisher_ = std::make_unique<ShmProductPublisher>(segment, slots, slotSize, unlinkOnClose);
+
+    // Products are serialized on the exporter thread
+    ROOT::EnableThreadSafety();
+    stopping_ = false;
+    thread_ = std::thread(&SharedMemoryExportStage::run, this);
+
+    spdlog::debug("[{}] Exporting {} products and {} tags to '{}' every {} ms",
+                  Name(), selection_.names.size(), selection_.tags.size(), publisher_->segmentName(), intervalMs_);
+}
+
+void SharedMemoryExportStage::run() {
+    std::unique_lock lock(mutex_);
+    while (!stopping_) {
+        lock.unlock();
+        try {
+            publisher_->publishFrom(*getDataProductManager(), selection_, format_);
+        } catch (const std::exception& e) {
+            spdlog::error("[{}] Export failed: {}", Name(), e.what());
+        }
+        lock.lock();
+        cv_.wait_for(lock, std::chrono::milliseconds(intervalMs_), [this] { return stopping_; });
+    }
+}
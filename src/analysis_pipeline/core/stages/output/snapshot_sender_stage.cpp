@@ -0,0 +1,55 @@
+#include "analysis_pipeline/core/stages/output/snapshot_sender_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include <spdlog/spdlog.h>
+
+ClassImp(SnapshotSenderStage)
+REGISTER_STAGE(SnapshotSenderStage)
+
+// No final snapshot here: the manager may already be destroyed (see Finish)
+SnapshotSenderStage::~SnapshotSenderStage() = default;
+
+void SnapshotSenderStage::Finish() {
+    if (client_ && eventsSeen_ > 0) {
+        sendSnapshot();
+        spdlog::debug("[{}] Sent {} snapshots ({} failed)", Name(), client_->sequence(), failedSends_);
+    }
+}
+
+void SnapshotSenderStage::OnInit() {
+    const std::string socketPath = parameters_.value("socket", "");
+    const std::string sourceId = parameters_.value("source_id", "");
+    everyNEvents_ = parameters_.value("every_n_events", std::uint64_t{1000});
+
+    if (socketPath.empty()) {
+        throw std::runtime_error("SnapshotSenderStage: socket is required");
+    }
+    if (everyNEvents_ == 0) {
+        throw std::runtime_error("SnapshotSenderStage: every_n_events must be positive");
+    }
+
+    selection_ = ProductSelection::fromJson(parameters_, "SnapshotSenderStage");
+
+    client_ = std::make_unique<SnapshotClient>(socketPath, sourceId);
+    eventsSeen_ = 0;
+    failedSends_ = 0;
+
+    spdlog::debug("[{}] Sending snapshots as '{}' to '{}' every {} events",
+                  Name(), client_->sourceId(), socketPath, everyNEvents_);
+}
+
+void SnapshotSenderStage::Process() {
+    if (!client_) return;
+    if (++eventsSeen_ % everyNEvents_ != 0) return;
+    sendSnapshot();
+}
+
+void SnapshotSenderStage::sendSnapshot() {
+    try {
+        if (!client_->send(*getDataProductManager(), selection_)) {
+            ++failedSends_;
+        }
+    } catch (const std::exception& e) {
+        ++failedSends_;
+        spdlog::error("[{}] Failed to send snapshot: {}", Name(), e.what());
+    }
+}
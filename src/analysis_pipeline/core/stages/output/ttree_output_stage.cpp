@@ -0,0 +1,423 @@
+#include "analysis_pipeline/core/stages/output/ttree_output_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/data/product_merger.h"
+#include "analysis_pipeline/core/data/products/value_batch.h"
+#include "analysis_pipeline/core/data/root_compression.h"
+#include <TClass.h>
+#include <TFile.h>
+#include <TParameter.h>
+#include <TROOT.h>
+#include <TTree.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+ClassImp(TTreeOutputStage)
+REGISTER_STAGE(TTreeOutputStage)
+
+namespace {
+
+std::string branchNameFor(const std::string& productName) {
+    std::string branch = productName;
+    for (char& c : branch) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') c = '_';
+    }
+    return branch;
+}
+
+}  // namespace
+
+TTreeOutputStage::TTreeOutputStage() = default;
+
+TTreeOutputStage::~TTreeOutputStage() {
+    if (writer_.running() && staging_) {
+        // End of run: the partial block must not be dropped
+        handOff(std::move(staging_), true);
+    }
+    writer_.stop();
+    if (!filePath_.empty()) {
+        spdlog::debug("[{}] Wrote {} entries; dropped {} blocks ({} events), blocked {} us, {} write failures",
+                      Name(), entriesWritten_.load(), blocksDropped_, eventsDropped_, blockedMicros_,
+                      writeFailures_.load());
+    }
+}
+
+void TTreeOutputStage::OnInit() {
+    writer_.stop();
+
+    filePath_ = parameters_.value("file", "");
+    treeName_ = parameters_.value("tree", "events");
+    blockSize_ = parameters_.value("block_size", std::size_t{1024});
+    queueSize_ = parameters_.value("queue_size", std::size_t{8});
+    autoFlush_ = parameters_.value("auto_flush", Long64_t{0});
+    compression_ = RootCompression::fromJson(parameters_.value("compression", nlohmann::json()));
+    statsPrefix_ = parameters_.value("stats_prefix", "ttree_output/");
+
+    if (filePath_.empty()) {
+        throw std::runtime_error("TTreeOutputStage: file is required");
+    }
+    if (blockSize_ == 0) {
+        throw std::runtime_error("TTreeOutputStage: block_size must be positive");
+    }
+    if (queueSize_ == 0) {
+        throw std::runtime_error("TTreeOutputStage: queue_size must be positive");
+    }
+
+    std::string onFull = parameters_.value("on_full", "block");
+    if (onFull == "block") {
+        dropWhenFull_ = false;
+    } else if (onFull == "drop") {
+        dropWhenFull_ = true;
+    } else {
+        throw std::runtime_error("TTreeOutputStage: unknown on_full '" + onFull + "' (expected 'block' or 'drop')");
+    }
+
+    selection_ = ProductSelection::fromJson(parameters_, "TTreeOutputStage");
+    if (selection_.selectsAll()) {
+        throw std::runtime_error("TTreeOutputStage: 'products' or 'tags' is required");
+    }
+
+    columns_.clear();
+    staging_.reset();
+    freeBlocks_.clear();
+    blocksQueued_ = 0;
+    blocksDropped_ = 0;
+    eventsDropped_ = 0;
+    blockedMicros_ = 0;
+    entriesWritten_ = 0;
+    writeFailures_ = 0;
+
+    startWriter();
+
+    spdlog::debug("[{}] Writing tree '{}' to '{}' (block {}, queue {}, on_full {}, compression {})",
+                  Name(), treeName_, filePath_, blockSize_, queueSize_, onFull,
+                  RootCompression::describe(compression_));
+}
+
+void TTreeOutputStage::Process() {
+    if (columns_.empty() && !resolveSchema()) return;
+
+    if (!staging_) staging_ = takeBlock();
+    try {
+        stageEvent(*staging_);
+    } catch (const std::exception& e) {
+        spdlog::error("[{}] Failed to stage event: {}", Name(), e.what());
+        return;
+    }
+
+    if (staging_->rows >= blockSize_) {
+        handOff(std::move(staging_), !dropWhenFull_);
+        publishStats();
+    }
+}
+
+bool TTreeOutputStage::resolveSchema() {
+    auto manager = getDataProductManager();
+
+    auto names = selection_.resolve(*manager);
+    std::sort(names.begin(), names.end());
+
+    std::vector<ColumnSpec> columns;
+    std::unordered_set<std::string> branches;
+    for (const auto& name : names) {
+        auto handle = manager->tryCheckoutRead(name);
+        if (!handle || !handle->getObject()) continue;
+
+        ColumnSpec spec;
+        spec.product = name;
+        spec.branch = branchNameFor(name);
+        // "a/b" and "a_b" map to the same branch; later names (in sorted order) get a suffix
+        for (int suffix = 2; !branches.insert(spec.branch).second; ++suffix) {
+            spec.branch = branchNameFor(name) + "_" + std::to_string(suffix);
+        }
+        if (spec.branch != branchNameFor(name)) {
+            spdlog::warn("[{}] Branch name of '{}' is taken; writing it as '{}'", Name(), name, spec.branch);
+        }
+        spec.cls = handle->getObject()->IsA();
+        if (spec.cls == TParameter<double>::Class()) {
+            spec.source = Source::Double;
+        } else if (spec.cls == TParameter<float>::Class()) {
+            spec.source = Source::Float;
+        } else if (spec.cls == TParameter<int>::Class()) {
+            spec.source = Source::Int;
+        } else if (spec.cls == TParameter<Long64_t>::Class()) {
+            spec.source = Source::Long64;
+        } else if (spec.cls == TParameter<bool>::Class()) {
+            spec.source = Source::Bool;
+        } else if (spec.cls == ValueBatch::Class()) {
+            spec.source = Source::Batch;
+        } else {
+            spec.source = Source::Object;
+        }
+        columns.push_back(std::move(spec));
+    }
+    if (columns.empty()) return false;
+
+    // The writer thread reads columns_ only for blocks queued after this;
+    // the queue's mutex orders the two
+    columns_ = std::move(columns);
+    spdlog::debug("[{}] Tree '{}' has {} branches", Name(), treeName_, columns_.size());
+    return true;
+}
+
+void TTreeOutputStage::stageEvent(Block& block) {
+    auto manager = getDataProductManager();
+    for (std::size_t i = 0; i < columns_.size(); ++i) {
+        const ColumnSpec& spec = columns_[i];
+        Column& column = block.columns[i];
+
+        auto handle = manager->tryCheckoutRead(spec.product);
+        const TObject* object = handle ? handle->getObject() : nullptr;
+        if (object && object->IsA() != spec.cls) {
+            object = nullptr;  // the product changed class; written as missing
+        }
+
+        switch (spec.source) {
+            case Source::Double:
+                column.doubles.push_back(object ? static_cast<const TParameter<double>*>(object)->GetVal() : 0.0);
+                break;
+            case Source::Float:
+                column.doubles.push_back(object ? static_cast<const TParameter<float>*>(object)->GetVal() : 0.0);
+                break;
+            case Source::Int:
+                column.longs.push_back(object ? static_cast<const TParameter<int>*>(object)->GetVal() : 0);
+                break;
+            case Source::Long64:
+                column.longs.push_back(object ? static_cast<const TParameter<Long64_t>*>(object)->GetVal() : 0);
+                break;
+            case Source::Bool:
+                column.longs.push_back(object ? static_cast<const TParameter<bool>*>(object)->GetVal() : 0);
+                break;
+            case Source::Batch:
+                if (object) {
+                    const auto& values = static_cast<const ValueBatch*>(object)->values();
+                    column.doubles.insert(column.doubles.end(), values.begin(), values.end());
+                }
+                column.offsets.push_back(column.doubles.size());
+                break;
+            case Source::Object:
+                column.objects.push_back(object ? ProductMerger::clone(*object) : nullptr);
+                break;
+        }
+    }
+    ++block.rows;
+}
+
+std::unique_ptr<TTreeOutputStage::Block> TTreeOutputStage::takeBlock() {
+    std::unique_ptr<Block> block;
+    {
+        std::lock_guard lock(freeMutex_);
+        if (!freeBlocks_.empty()) {
+            block = std::move(freeBlocks_.back());
+            freeBlocks_.pop_back();
+        }
+    }
+
+    if (!block) {
+        block = std::make_unique<Block>();
+        block->columns.resize(columns_.size());
+        for (std::size_t i = 0; i < columns_.size(); ++i) {
+            Column& column = block->columns[i];
+            switch (columns_[i].source) {
+                case Source::Double:
+                case Source::Float:
+                    column.doubles.reserve(blockSize_);
+                    break;
+                case Source::Int:
+                case Source::Long64:
+                case Source::Bool:
+                    column.longs.reserve(blockSize_);
+                    break;
+                case Source::Batch:
+                    column.offsets.reserve(blockSize_ + 1);
+                    break;
+                case Source::Object:
+                    column.objects.reserve(blockSize_);
+                    break;
+            }
+        }
+    }
+
+    // Recycled blocks keep their capacity
+    block->rows = 0;
+    for (std::size_t i = 0; i < columns_.size(); ++i) {
+        Column& column = block->columns[i];
+        column.doubles.clear();
+        column.longs.clear();
+        column.offsets.clear();
+        column.objects.clear();
+        if (columns_[i].source == Source::Batch) column.offsets.push_back(0);
+    }
+    return block;
+}
+
+void TTreeOutputStage::handOff(std::unique_ptr<Block> block, bool wait) {
+    if (!block || block->rows == 0) return;
+    const std::size_t rows = block->rows;
+    block = writer_.push(std::move(block), wait, &blockedMicros_);
+    if (!block) {
+        ++blocksQueued_;
+        return;
+    }
+
+    if (blocksDropped_++ == 0) {
+        spdlog::warn("[{}] Writer is behind; dropping blocks", Name());
+    }
+    eventsDropped_ += rows;
+    recycle(std::move(block));
+}
+
+void TTreeOutputStage::recycle(std::unique_ptr<Block> block) {
+    std::lock_guard lock(freeMutex_);
+    freeBlocks_.push_back(std::move(block));
+}
+
+void TTreeOutputStage::publishStats() {
+    const std::size_t depth = writer_.depth();
+
+    std::vector<std::pair<std::string, std::unique_ptr<PipelineDataProduct>>> products;
+    auto add = [&](const char* counter, std::uint64_t value) {
+        std::string name = statsPrefix_ + counter;
+        auto product = std::make_unique<PipelineDataProduct>();
+        product->setName(name);
+        product->setObject(std::make_unique<TParameter<Long64_t>>(name.c_str(), static_cast<Long64_t>(value)));
+        product->addTag("ttree_output");
+        products.emplace_back(name, std::move(product));
+    };
+
+    add("blocks_queued", blocksQueued_);
+    add("blocks_dropped", blocksDropped_);
+    add("events_dropped", eventsDropped_);
+    add("blocked_us", blockedMicros_);
+    add("queue_depth", depth);
+    add("entries_written", entriesWritten_.load(std::memory_order_relaxed));
+    add("write_failures", writeFailures_.load(std::memory_order_relaxed));
+
+    try {
+        getDataProductManager()->addOrUpdateMultiple(std::move(products));
+    } catch (const std::exception& e) {
+        spdlog::error("[{}] Failed to publish statistics: {}", Name(), e.what());
+    }
+}
+
+void TTreeOutputStage::startWriter() {
+    // The tree is filled and written from the I/O thread
+    ROOT::EnableThreadSafety();
+    writer_.start(queueSize_,
+                  [this](std::unique_ptr<Block>& block) { writeQueued(block); },
+                  [this] {
+                      try {
+                          closeFile();
+                      } catch (const std::exception& e) {
+                          ++writeFailures_;
+                          spdlog::error("[{}] Failed to close '{}': {}", Name(), filePath_, e.what());
+                      }
+                  });
+}
+
+void TTreeOutputStage::writeQueued(std::unique_ptr<Block>& block) {
+    try {
+        if (!file_) openFile();
+        writeBlock(*block);
+    } catch (const std::exception& e) {
+        if (writeFailures_++ == 0) {
+            spdlog::error("[{}] Failed to write to '{}': {}", Name(), filePath_, e.what());
+        }
+    }
+    // Clones are freed here rather than on the worker that reuses the block
+    for (auto& column : block->columns) column.objects.clear();
+    recycle(std::move(block));
+}
+
+void TTreeOutputStage::openFile() {
+    const std::string tmpPath = temporaryFilePath(filePath_);
+    file_ = std::make_unique<TFile>(tmpPath.c_str(), "RECREATE", "", compression_);
+    if (file_->IsZombie()) {
+        file_.reset();
+        throw std::runtime_error("cannot create '" + tmpPath + "'");
+    }
+
+    tree_ = new TTree(treeName_.c_str(), treeName_.c_str());
+    tree_->SetDirectory(file_.get());
+    if (autoFlush_ != 0) {
+        tree_->SetAutoFlush(autoFlush_);
+    }
+
+    // Branches keep pointers into buffers_, so it is sized once here
+    buffers_.clear();
+    buffers_.resize(columns_.size());
+    for (std::size_t i = 0; i < columns_.size(); ++i) {
+        const ColumnSpec& spec = columns_[i];
+        BranchBuffer& buffer = buffers_[i];
+        switch (spec.source) {
+            case Source::Double:
+            case Source::Float:
+                tree_->Branch(spec.branch.c_str(), &buffer.value, (spec.branch + "/D").c_str());
+                break;
+            case Source::Int:
+            case Source::Long64:
+            case Source::Bool:
+                tree_->Branch(spec.branch.c_str(), &buffer.integer, (spec.branch + "/L").c_str());
+                break;
+            case Source::Batch:
+                tree_->Branch(spec.branch.c_str(), &buffer.values);
+                break;
+            case Source::Object: {
+                void* object = spec.cls->New();
+                buffer.defaultObject.reset(static_cast<TObject*>(spec.cls->DynamicCast(TObject::Class(), object)));
+                buffer.object = object;
+                tree_->Branch(spec.branch.c_str(), spec.cls->GetName(), &buffer.object);
+                break;
+            }
+        }
+    }
+}
+
+void TTreeOutputStage::writeBlock(const Block& block) {
+    for (std::size_t row = 0; row < block.rows; ++row) {
+        for (std::size_t i = 0; i < columns_.size(); ++i) {
+            const ColumnSpec& spec = columns_[i];
+            const Column& column = block.columns[i];
+            BranchBuffer& buffer = buffers_[i];
+            switch (spec.source) {
+                case Source::Double:
+                case Source::Float:
+                    buffer.value = column.doubles[row];
+                    break;
+                case Source::Int:
+                case Source::Long64:
+                case Source::Bool:
+                    buffer.integer = column.longs[row];
+                    break;
+                case Source::Batch:
+                    buffer.values.assign(column.doubles.begin() + static_cast<std::ptrdiff_t>(column.offsets[row]),
+                                         column.doubles.begin() + static_cast<std::ptrdiff_t>(column.offsets[row + 1]));
+                    break;
+                case Source::Object: {
+                    TObject* object = column.objects[row] ? column.objects[row].get() : buffer.defaultObject.get();
+                    // The branch wants the address of the full object, not of its TObject base
+                    buffer.object = spec.cls->DynamicCast(TObject::Class(), object, false);
+                    break;
+                }
+            }
+        }
+        if (tree_->Fill() < 0) {
+            throw std::runtime_error("TTree::Fill failed");
+        }
+        entriesWritten_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void TTreeOutputStage::closeFile() {
+    if (!file_) return;
+
+    tree_->Write("", TObject::kOverwrite);
+    file_->Close();
+    tree_ = nullptr;
+    file_.reset();
+    buffers_.clear();
+
+    commitTemporaryFile(filePath_);
+    spdlog::debug("[{}] Wrote {} entries to '{}'", Name(), entriesWritten_.load(), filePath_);
+}
@@ -0,0 +1,85 @@
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/stages/base_stage.h"
+
+#include <TClass.h>
+#include <algorithm>
+#include <mutex>
+#include <spdlog/spdlog.h>
+
+StageRegistry& StageRegistry::instance() {
+    static StageRegistry registry;
+    return registry;
+}
+
+bool StageRegistry::registerStage(const std::string& name, Factory factory) {
+    if (!factory) {
+        spdlog::warn("[StageRegistry] Ignoring null factory for '{}'", name);
+        return false;
+    }
+    std::unique_lock lock(mutex_);
+    auto [it, inserted] = factories_.emplace(name, factory);
+    if (!inserted) {
+        spdlog::warn("[StageRegistry] Stage '{}' is already registered; keeping the first registration", name);
+    }
+    return inserted;
+}
+
+std::unique_ptr<BaseStage> StageRegistry::create(const std::string& name) const {
+    bool fallback = false;
+    {
+        std::shared_lock lock(mutex_);
+        auto it = factories_.find(name);
+        if (it != factories_.end()) {
+            return std::unique_ptr<BaseStage>(it->second());
+        }
+        fallback = dictionaryFallback_;
+    }
+
+    if (!fallback) {
+        spdlog::error("[StageRegistry] Stage '{}' is not registered", name);
+        return nullptr;
+    }
+    return std::unique_ptr<BaseStage>(createFromDictionary(name));
+}
+
+BaseStage* StageRegistry::createFromDictionary(const std::string& name) const {
+    spdlog::debug("[StageRegistry] '{}' not registered; falling back to TClass lookup", name);
+
+    TClass* cls = TClass::GetClass(name.c_str());
+    if (!cls) {
+        spdlog::error("[StageRegistry] Unknown stage class '{}'", name);
+        return nullptr;
+    }
+    if (!cls->InheritsFrom(BaseStage::Class())) {
+        spdlog::error("[StageRegistry] Class '{}' does not inherit from BaseStage", name);
+        return nullptr;
+    }
+
+    void* obj = cls->New();
+    if (!obj) {
+        spdlog::error("[StageRegistry] TClass::New() failed for '{}'", name);
+        return nullptr;
+    }
+    return static_cast<BaseStage*>(cls->DynamicCast(BaseStage::Class(), obj));
+}
+
+bool StageRegistry::contains(const std::string& name) const {
+    std::shared_lock lock(mutex_);
+    return factories_.find(name) != factories_.end();
+}
+
+std::vector<std::string> StageRegistry::registeredNames() const {
+    std::shared_lock lock(mutex_);
+    std::vector<std::string> names;
+    names.reserve(factories_.size());
+    for (const auto& [name, _] : factories_) {
+        names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+void StageRegistry::setDictionaryFallback(bool enabled) {
+    std::unique_lock lock(mutex_);
+    dictionaryFallback_ = enabled;
+}
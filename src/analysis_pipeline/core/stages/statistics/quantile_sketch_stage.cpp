@@ -0,0 +1,121 @@
+#include "analysis_pipeline/core/stages/statistics/quantile_sketch_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/data/products/quantile_sketch.h"
+#include "analysis_pipeline/core/data/products/value_batch.h"
+#include <TParameter.h>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+ClassImp(QuantileSketchStage)
+REGISTER_STAGE(QuantileSketchStage)
+
+void QuantileSketchStage::OnInit() {
+    inputProductName_ = parameters_.value("input_product", "");
+    productName_ = parameters_.value("product_name", "quantile_sketch");
+    k_ = parameters_.value("k", static_cast<std::uint32_t>(QuantileSketch::kDefaultK));
+    everyNEvents_ = parameters_.value("every_n_events", std::uint64_t{1000});
+    eventsSeen_ = 0;
+
+    if (inputProductName_.empty()) {
+        throw std::runtime_error("QuantileSketchStage: input_product is required");
+    }
+    if (k_ < QuantileSketch::kMinK) {
+        throw std::runtime_error("QuantileSketchStage: k must be at least " + std::to_string(QuantileSketch::kMinK));
+    }
+    if (everyNEvents_ == 0) {
+        throw std::runtime_error("QuantileSketchStage: every_n_events must be positive");
+    }
+    accessor_ = MemberAccessor(inputProductName_, parameters_.value("value_key", "value"));
+
+    publishQuantiles_.clear();
+    quantileNames_.clear();
+    if (parameters_.contains("publish_quantiles")) {
+        const auto& list = parameters_["publish_quantiles"];
+        if (!list.is_array()) {
+            throw std::runtime_error("QuantileSketchStage: 'publish_quantiles' must be an array");
+        }
+        for (const auto& entry : list) {
+            double q = entry.get<double>();
+            if (!(q >= 0.0 && q <= 1.0)) {
+                throw std::runtime_error("QuantileSketchStage: quantiles must be in [0, 1]");
+            }
+            // 0.5 -> p50, 0.999 -> p99.9
+            std::string percent = fmt::format("{:g}", q * 100.0);
+            publishQuantiles_.push_back(q);
+            quantileNames_.push_back(productName_ + "/p" + percent);
+        }
+    }
+
+    spdlog::debug("[{}] Sketching '{}.{}' into '{}' with k = {}", Name(), inputProductName_,
+                  accessor_.memberName(), productName_, k_);
+}
+
+bool QuantileSketchStage::readInput() {
+    scratch_.clear();
+    auto handle = getDataProductManager()->tryCheckoutRead(inputProductName_);
+    if (!handle || !handle->getObject()) {
+        return false;
+    }
+    if (auto* batch = dynamic_cast<const ValueBatch*>(handle->getObject())) {
+        scratch_.assign(batch->values().begin(), batch->values().end());
+    } else {
+        scratch_.push_back(accessor_.read(*handle));
+    }
+    return true;
+}
+
+void QuantileSketchStage::Process() {
+    try {
+        if (!readInput()) {
+            spdlog::debug("[{}] Input product '{}' not found", Name(), inputProductName_);
+            return;
+        }
+
+        auto manager = getDataProductManager();
+        if (!manager->hasProduct(productName_)) {
+            auto product = std::make_unique<PipelineDataProduct>();
+            product->setName(productName_);
+            product->setObject(std::make_unique<QuantileSketch>(k_));
+            product->addTag("quantile_sketch");
+            product->addTag("built_by_quantile_sketch_stage");
+            manager->addOrUpdate(productName_, std::move(product));
+            spdlog::debug("[{}] Created sketch '{}'", Name(), productName_);
+        }
+
+        {
+            auto handle = manager->checkoutWrite(productName_);
+            auto* sketch = dynamic_cast<QuantileSketch*>(handle->getObject());
+            if (!sketch) {
+                spdlog::error("[{}] Object named '{}' exists but is not a QuantileSketch", Name(), productName_);
+                return;
+            }
+            sketch->insert(scratch_.data(), scratch_.size());
+        }
+
+        if (!publishQuantiles_.empty() && eventsSeen_++ % everyNEvents_ == 0) {
+            publishQuantiles();
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("[{}] Exception in Process: {}", Name(), e.what());
+    }
+}
+
+void QuantileSketchStage::publishQuantiles() {
+    auto manager = getDataProductManager();
+    std::vector<double> values;
+    {
+        auto handle = manager->checkoutRead(productName_);
+        values = static_cast<const QuantileSketch*>(handle->getObject())->quantiles(publishQuantiles_);
+    }
+
+    std::vector<std::pair<std::string, std::unique_ptr<PipelineDataProduct>>> products;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const auto& name = quantileNames_[i];
+        auto product = std::make_unique<PipelineDataProduct>();
+        product->setName(name);
+        product->setObject(std::make_unique<TParameter<double>>(name.c_str(), values[i]));
+        product->addTag("quantile");
+        products.emplace_back(name, std::move(product));
+    }
+    manager->addOrUpdateMultiple(std::move(products));
+}
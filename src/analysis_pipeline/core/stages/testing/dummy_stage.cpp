@@ -1,4 +1,5 @@
 #include "analysis_pipeline/core/stages/testing/dummy_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
 #include <spdlog/spdlog.h>
 #include <chrono>
 #include <thread>
@@ -6,6 +7,7 @@
 #include <ctime>    // for std::localtime
 
 ClassImp(DummyStage)
+REGISTER_STAGE(DummyStage)
 
 DummyStage::DummyStage() = default;
 DummyStage::~DummyStage() = default;
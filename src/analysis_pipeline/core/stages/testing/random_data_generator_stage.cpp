@@ -1,9 +1,11 @@
 #include "analysis_pipeline/core/stages/testing/random_data_generator_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
 
 #include <TParameter.h>
 #include <spdlog/spdlog.h>
 
 ClassImp(RandomDataGeneratorStage)
+REGISTER_STAGE(RandomDataGeneratorStage)
 
 RandomDataGeneratorStage::RandomDataGeneratorStage()
     : rng_(std::random_device{}()), dist_(0.0, 1.0) {}
@@ -0,0 +1,65 @@
+#include "analysis_pipeline/core/stages/testing/synthetic_load_generator_stage.h"
+#include "analysis_pipeline/core/stages/stage_registry.h"
+#include "analysis_pipeline/core/data/products/value_batch.h"
+
+#include <spdlog/spdlog.h>
+
+ClassImp(SyntheticLoadGeneratorStage)
+REGISTER_STAGE(SyntheticLoadGeneratorStage)
+
+void SyntheticLoadGeneratorStage::OnInit() {
+    productName_ = parameters_.value("product_name", "synthetic_values");
+    batchSize_ = parameters_.value("batch_size", std::size_t{1000});
+    seed_ = parameters_.value("seed", std::uint64_t{0});
+    stream_ = parameters_.value("stream", std::uint64_t{0});
+    inPlace_ = parameters_.value("in_place", true);
+
+    if (batchSize_ == 0) {
+        throw std::runtime_error("SyntheticLoadGeneratorStage: batch_size must be positive");
+    }
+
+    distribution_ = std::make_unique<SampleDistribution>(
+        SampleDistribution::fromJson(parameters_.value("distribution", nlohmann::json::object())));
+    rng_.seed(seed_, stream_);
+
+    spdlog::debug("[{}] Initialized with name='{}', batch_size={}, distribution={}, seed={}, stream={}",
+                  Name(), productName_, batchSize_, distribution_->typeName(), seed_, stream_);
+}
+
+void SyntheticLoadGeneratorStage::Process() {
+    if (inPlace_ && refillInPlace()) return;
+    publishNew();
+}
+
+bool SyntheticLoadGeneratorStage::refillInPlace() {
+    auto manager = getDataProductManager();
+    if (!manager->hasProduct(productName_)) return false;
+
+    try {
+        auto handle = manager->checkoutWrite(productName_);
+        auto* batch = dynamic_cast<ValueBatch*>(handle->getObject());
+        if (!batch) return false;
+
+        batch->resize(batchSize_);
+        distribution_->fill(rng_, batch->data(), batchSize_);
+        return true;
+    } catch (const std::exception& e) {
+        // Product disappeared between the check and the checkout; fall back to a new one
+        spdlog::debug("[{}] In-place refill of '{}' failed: {}", Name(), productName_, e.what());
+        return false;
+    }
+}
+
+void SyntheticLoadGeneratorStage::publishNew() {
+    auto batch = std::make_unique<ValueBatch>();
+    batch->resize(batchSize_);
+    distribution_->fill(rng_, batch->data(), batchSize_);
+
+    auto product = std::make_unique<PipelineDataProduct>();
+    product->setName(productName_);
+    product->setObject(std::move(batch));
+    product->addTag("random");
+    product->addTag("built_by_synthetic_load_generator");
+
+    getDataProductManager()->addOrUpdate(productName_, std::move(product));
+}